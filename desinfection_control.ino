@@ -32,6 +32,7 @@
 #include "display.h"
 #include "programs.h"
 #include "menu.h"
+#include "timer_wheel.h"
 
 // Display-Konfiguration
 #define SCREEN_WIDTH 128
@@ -57,14 +58,12 @@ unsigned long programDuration = 1209600000; // 14 Tage in Millisekunden
 unsigned long startTime = 0;
 bool programActive = false;
 int customDays = 7; // Standardwert für benutzerdefiniertes Programm
-unsigned long lastDisplayUpdate = 0;
 unsigned long autoStartTimer = 0;
 bool autoStartActive = true;
 
 // Variablen für Scrolling Text
 int scrollPosition = 0;
 const int scrollSpeed = 200;
-unsigned long lastScrollTime = 0;
 int maxScrollPosition_StartScreenTitle = 0;
 int maxScrollPosition_StartScreenMessage = 0;
 int maxScrollPosition_MainMenu = 0;
@@ -76,13 +75,17 @@ unsigned long shortPressDetectedAt = 0;
 const unsigned long shortPressDuration = 200;
 const unsigned long longPressDuration = 2000;
 const unsigned long waitingDuration = 5000;
-unsigned long lastButtonCheck = 0;
 const unsigned long buttonCheckInterval = 100; // Prüfe Buttons alle 100ms
 
 // Sensor-Zeitsteuerung
-unsigned long lastSensorCheck = 0;
 const unsigned long sensorCheckInterval = 1000; // Prüfe Sensor alle 1000ms
 
+// Auto-Start nach 30 Sekunden auf dem Startbildschirm
+const unsigned long autoStartDelay = 30000;
+
+// Periodische Aufträge (Taster, Sensor, Display, Scrolling, Auto-Start)
+TimerWheel timers("main");
+
 void setup() {
   Serial.begin(115200);
   Serial.println("\nDesinfektionseinheit startet...");
@@ -125,8 +128,24 @@ void setup() {
   // Standard-LED-Status setzen
   setLED("normal");
   
+  // Periodische Aufträge registrieren
+  timers.every("buttons", buttonCheckInterval, [](void *arg) {
+    handleButtonPress();
+    checkPlusMinusButtons();
+  });
+  timers.every("sensor", sensorCheckInterval, [](void *arg) {
+    checkTankLevel();
+  });
+  timers.every("display", 1000, [](void *arg) {
+    updateDisplay();
+  });
+  timers.every("scroll", scrollSpeed, [](void *arg) {
+    handleTextScrolling();
+  });
+  
   // Initialisiere Auto-Start-Timer
   autoStartTimer = millis();
+  timers.after("auto_start", autoStartDelay, checkAutoStart);
   
   delay(1000); // Kurze Verzögerung für bessere Lesbarkeit
   
@@ -135,46 +154,40 @@ void setup() {
 }
 
 void loop() {
-  unsigned long currentMillis = millis();
+  // Fällige Aufträge ausführen
+  uint32_t idleMs = timers.poll();
   
-  // Prüfe Buttons in regelmäßigen Abständen
-  if (currentMillis - lastButtonCheck >= buttonCheckInterval) {
-    lastButtonCheck = currentMillis;
-    handleButtonPress();
-    checkPlusMinusButtons();
-  }
-  
-  // Prüfe Sensor in regelmäßigen Abständen
-  if (currentMillis - lastSensorCheck >= sensorCheckInterval) {
-    lastSensorCheck = currentMillis;
-    checkTankLevel();
-  }
-  
-  // Aktualisiere Display wenn nötig (abhängig vom Zustand)
-  if (programActive || currentMillis - lastDisplayUpdate >= 1000) {
-    lastDisplayUpdate = currentMillis;
+  // Während eines Programms Display in jedem Durchlauf aktualisieren
+  if (programActive) {
     updateDisplay();
   }
   
-  // Scroll Text bei Bedarf
-  handleTextScrolling(currentMillis);
-  
-  // Prüfe Auto-Start Bedingung
-  if (autoStartActive && currentMenuState == START_SCREEN && (currentMillis - autoStartTimer > 30000)) {
-    autoStartActive = false; // Deaktiviere nach einmaligem Ausführen
-    switchToProgram("Programm 2"); // 14-Tage-Programm
-    startProgram();
-    currentMenuState = PROGRAM_RUNNING;
-  }
-  
   // Prüfe, ob laufendes Programm beendet werden muss
   if (programActive) {
-    unsigned long elapsedTime = currentMillis - startTime;
+    unsigned long elapsedTime = millis() - startTime;
     if (programDuration > 0 && elapsedTime >= programDuration) {
       stopProgram();
       currentMenuState = PROGRAM_COMPLETED;
     }
+  } else if (idleMs > 0 && idleMs != TIMER_WHEEL_NO_DEADLINE) {
+    delay(idleMs); // Bis zum nächsten Auftrag schlafen
+  }
+}
+
+// Auto-Start des 14-Tage-Programms (einmaliger Auftrag)
+void checkAutoStart(void *arg) {
+  if (!autoStartActive) {
+    return;
+  }
+  if (currentMenuState != START_SCREEN) {
+    // Erst beim nächsten Tasterzyklus auf dem Startbildschirm starten
+    timers.after("auto_start", buttonCheckInterval, checkAutoStart);
+    return;
   }
+  autoStartActive = false; // Deaktiviere nach einmaligem Ausführen
+  switchToProgram("Programm 2"); // 14-Tage-Programm
+  startProgram();
+  currentMenuState = PROGRAM_RUNNING;
 }
 
 // Prüft Füllstand des Tanks über den Sensor
@@ -359,40 +372,36 @@ void setLED(String status) {
   }
 }
 
-// Behandelt die Scrollfunktion für Texte auf dem Display
-void handleTextScrolling(unsigned long currentMillis) {
-  if (currentMillis - lastScrollTime >= scrollSpeed) {
-    lastScrollTime = currentMillis;
-    
-    // Scrolle je nach aktuellem Menüzustand
-    switch (currentMenuState) {
-      case START_SCREEN:
-        // Scrolle Titel
-        scrollPosition--;
-        if (scrollPosition < -maxScrollPosition_StartScreenTitle) {
-          scrollPosition = SCREEN_WIDTH;
-        }
-        break;
-        
-      case MAIN_MENU:
-        // Scrolle Menütitel
-        scrollPosition--;
-        if (scrollPosition < -maxScrollPosition_MainMenu) {
-          scrollPosition = SCREEN_WIDTH;
-        }
-        break;
-        
-      case SETUP_NEW_DAYS_INIT:
-        // Scrolle Erklärungstext
-        scrollPosition--;
-        if (scrollPosition < -maxScrollPosition_NewSetupInit) {
-          scrollPosition = SCREEN_WIDTH;
-        }
-        break;
-    }
-    
-    updateDisplay();
+// Behandelt die Scrollfunktion für Texte auf dem Display (alle scrollSpeed ms)
+void handleTextScrolling() {
+  // Scrolle je nach aktuellem Menüzustand
+  switch (currentMenuState) {
+    case START_SCREEN:
+      // Scrolle Titel
+      scrollPosition--;
+      if (scrollPosition < -maxScrollPosition_StartScreenTitle) {
+        scrollPosition = SCREEN_WIDTH;
+      }
+      break;
+      
+    case MAIN_MENU:
+      // Scrolle Menütitel
+      scrollPosition--;
+      if (scrollPosition < -maxScrollPosition_MainMenu) {
+        scrollPosition = SCREEN_WIDTH;
+      }
+      break;
+      
+    case SETUP_NEW_DAYS_INIT:
+      // Scrolle Erklärungstext
+      scrollPosition--;
+      if (scrollPosition < -maxScrollPosition_NewSetupInit) {
+        scrollPosition = SCREEN_WIDTH;
+      }
+      break;
   }
+  
+  updateDisplay();
 }
 
 // Tasterlogik für Programmwechsel
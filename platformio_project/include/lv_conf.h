@@ -15,8 +15,12 @@
 /*Color depth: 1 (1 byte per pixel), 8 (RGB332), 16 (RGB565), 32 (ARGB8888)*/
 #define LV_COLOR_DEPTH 16
 
-/*Swap the 2 bytes of RGB565 color. Useful if the display has an 8-bit interface*/
+/*Swap the 2 bytes of RGB565 color. Useful if the display has an 8-bit interface
+ *1: LVGL rendert direkt in SPI-Byte-Reihenfolge, der Flush überträgt ohne Byte-Tausch
+ *(per Build-Flag in platformio.ini gesetzt)*/
+#ifndef LV_COLOR_16_SWAP
 #define LV_COLOR_16_SWAP 0
+#endif
 
 /*Enable features to draw on transparent background.
  *It's required if opa, and transform_* style properties are used.
@@ -66,10 +70,11 @@
    HAL SETTINGS
  *====================*/
 
-/*Default display refresh period. LVG will redraw changed areas with this period time*/
+/*Default display refresh period. LVG will redraw changed areas with this period time
+ *Active rate only: RefreshScheduler (src/refresh_scheduler.h) lowers it while the UI is idle*/
 #define LV_DISP_DEF_REFR_PERIOD 30      /*[ms]*/
 
-/*Input device read period in milliseconds*/
+/*Input device read period in milliseconds (active rate, see RefreshScheduler)*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
 /*Use a custom tick source that tells the elapsed time in milliseconds.
@@ -113,8 +118,13 @@
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  *However the opened images might consume additional RAM.
- *0: to disable caching*/
-#define LV_IMG_CACHE_DEF_SIZE 0
+ *0: to disable caching
+ *Die Bilder aus tools/image_assets.py werden vom Decoder in ui_images.h einmal ausgepackt;
+ *der Cache hält sie geöffnet (ausgepackt im PSRAM), damit nicht jeder Refresh neu auspackt.
+ *LVGL bevorzugt beim Verdrängen Einträge, die schnell zu öffnen sind (Snapshots, Dekorationen).*/
+#ifndef LV_IMG_CACHE_DEF_SIZE
+#define LV_IMG_CACHE_DEF_SIZE 8
+#endif
 
 /*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
@@ -274,18 +284,23 @@
  *===================*/
 
 /*Montserrat fonts with ASCII range and some symbols using bpp = 4
- *https://fonts.google.com/specimen/Montserrat*/
+ *https://fonts.google.com/specimen/Montserrat
+ *Mit UI_FONT_SUBSET=1 (gesetzt von tools/font_subset.py) ersetzen die erzeugten
+ *Teilschriften ui_font_* die genutzten Größen, siehe src/ui_fonts.h*/
+#ifndef UI_FONT_SUBSET
+#define UI_FONT_SUBSET 0
+#endif
 #define LV_FONT_MONTSERRAT_8     0
 #define LV_FONT_MONTSERRAT_10    0
-#define LV_FONT_MONTSERRAT_12    1
-#define LV_FONT_MONTSERRAT_14    1
-#define LV_FONT_MONTSERRAT_16    1
-#define LV_FONT_MONTSERRAT_18    1
-#define LV_FONT_MONTSERRAT_20    1
-#define LV_FONT_MONTSERRAT_22    1
-#define LV_FONT_MONTSERRAT_24    1
+#define LV_FONT_MONTSERRAT_12    0
+#define LV_FONT_MONTSERRAT_14    !UI_FONT_SUBSET
+#define LV_FONT_MONTSERRAT_16    !UI_FONT_SUBSET
+#define LV_FONT_MONTSERRAT_18    !UI_FONT_SUBSET
+#define LV_FONT_MONTSERRAT_20    !UI_FONT_SUBSET
+#define LV_FONT_MONTSERRAT_22    !UI_FONT_SUBSET
+#define LV_FONT_MONTSERRAT_24    0
 #define LV_FONT_MONTSERRAT_26    0
-#define LV_FONT_MONTSERRAT_28    1
+#define LV_FONT_MONTSERRAT_28    !UI_FONT_SUBSET
 #define LV_FONT_MONTSERRAT_30    0
 #define LV_FONT_MONTSERRAT_32    0
 #define LV_FONT_MONTSERRAT_34    0
@@ -295,7 +310,7 @@
 #define LV_FONT_MONTSERRAT_42    0
 #define LV_FONT_MONTSERRAT_44    0
 #define LV_FONT_MONTSERRAT_46    0
-#define LV_FONT_MONTSERRAT_48    1
+#define LV_FONT_MONTSERRAT_48    !UI_FONT_SUBSET
 
 /*Demonstrate special features*/
 #define LV_FONT_MONTSERRAT_12_SUBPX      0
@@ -310,18 +325,31 @@
 /*Optionally declare custom fonts here.
  *You can use these fonts as default font too and they will be available globally.
  *E.g. #define LV_FONT_CUSTOM_DECLARE   LV_FONT_DECLARE(my_font_1) LV_FONT_DECLARE(my_font_2)*/
+#if UI_FONT_SUBSET
+#define LV_FONT_CUSTOM_DECLARE LV_FONT_DECLARE(ui_font_14)
+#else
 #define LV_FONT_CUSTOM_DECLARE
+#endif
 
 /*Always set a default font*/
+#if UI_FONT_SUBSET
+#define LV_FONT_DEFAULT &ui_font_14
+#else
 #define LV_FONT_DEFAULT &lv_font_montserrat_14
+#endif
 
 /*Enable handling large font and/or fonts with a lot of characters.
  *The limit depends on the font size, font face and bpp.
  *Compiler error will be triggered if a font needs it.*/
 #define LV_FONT_FMT_TXT_LARGE 0
 
-/*Enables/disables support for compressed fonts.*/
+/*Enables/disables support for compressed fonts.
+ *Wird von tools/font_subset.py gesetzt, wenn die Teilschriften komprimiert erzeugt werden*/
+#ifdef UI_FONT_COMPRESSED
+#define LV_USE_FONT_COMPRESSED UI_FONT_COMPRESSED
+#else
 #define LV_USE_FONT_COMPRESSED 0
+#endif
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -591,8 +619,8 @@
  * Others
  *----------*/
 
-/*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+/*1: Enable API to take snapshot for object (used by the screen snapshot cache, UI_SNAPSHOT_CACHE)*/
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
@@ -0,0 +1,258 @@
+#ifndef APP_TASKS_H
+#define APP_TASKS_H
+
+#include <Arduino.h>
+
+#include "command_queue.h"
+#include "task_monitor.h"
+
+/*
+ * Aufteilung der Firmware auf FreeRTOS-Tasks:
+ * - Steuerung: Programmzustand, Motor, LEDs, Tanküberwachung (höchste Priorität)
+ * - Oberfläche: LVGL, Display und Touch, gleicher Kern wie die Steuerung
+ * - Netzwerk: WiFi, MQTT, REST, Telemetrie auf dem anderen Kern (wie der WiFi-Stack)
+ * Kern, Priorität und Stack lassen sich per Build-Flag überschreiben.
+ */
+#ifndef APP_CONTROL_CORE
+#define APP_CONTROL_CORE 1
+#endif
+#ifndef APP_CONTROL_PRIORITY
+#define APP_CONTROL_PRIORITY 5
+#endif
+#ifndef APP_CONTROL_STACK
+#define APP_CONTROL_STACK 4096
+#endif
+
+#ifndef APP_UI_CORE
+#define APP_UI_CORE 1
+#endif
+#ifndef APP_UI_PRIORITY
+#define APP_UI_PRIORITY 3
+#endif
+#ifndef APP_UI_STACK
+#define APP_UI_STACK 8192
+#endif
+
+#ifndef APP_NET_CORE
+#define APP_NET_CORE 0
+#endif
+#ifndef APP_NET_PRIORITY
+#define APP_NET_PRIORITY 2
+#endif
+#ifndef APP_NET_STACK
+#define APP_NET_STACK 8192
+#endif
+
+// Länge der Warteschlangen von Oberfläche und Netzwerk (Befehle: COMMAND_QUEUE_LENGTH)
+#ifndef APP_QUEUE_LENGTH
+#define APP_QUEUE_LENGTH 8
+#endif
+
+// Ereignisse an die Oberfläche
+enum UiEventType {
+  UI_EVENT_STATUS_TEXT,  // text: neuer Statustext
+  UI_EVENT_SHOW_SCREEN,  // value: ScreenId
+  UI_EVENT_ACTIVITY,     // Display aus dem Leerlauf holen
+  UI_EVENT_SET_OVERLAY,  // value: Messwert-Overlay ein (1) oder aus (0)
+};
+
+struct UiEvent {
+  UiEventType type;
+  int32_t value;
+  const char* text;  // Muss dauerhaft gültig sein (Literal)
+};
+
+// Aufträge an das Netzwerk
+enum NetEventType {
+  NET_EVENT_STATUS,           // status: MQTT-Statusmeldung
+  NET_EVENT_PROGRAM_STARTED,  // program, duration
+  NET_EVENT_RESET_WIFI,
+};
+
+struct NetEvent {
+  NetEventType type;
+  const char* status;  // Muss dauerhaft gültig sein (Literal)
+  int32_t program;
+  uint32_t duration;
+};
+
+// Reihenfolge der Tasks im TaskMonitor
+enum AppTaskId {
+  APP_TASK_CONTROL,
+  APP_TASK_UI,
+  APP_TASK_NET,
+  APP_TASK_COUNT
+};
+
+/**
+ * Tasks und Warteschlangen der Firmware.
+ * Kein Task ruft Funktionen eines anderen direkt auf: Befehle an die Steuerung
+ * laufen durch die lock-freie commandQueue, Ereignisse an Oberfläche und
+ * Netzwerk als Kopie durch je eine FreeRTOS-Queue. Nur die
+ * Steuerung schreibt den Programmzustand und die GPIOs, nur die Oberfläche
+ * ruft LVGL auf und nur das Netzwerk spricht mit MQTT und WiFi.
+ */
+class AppTasks {
+private:
+  QueueHandle_t queues[APP_TASK_COUNT];
+  TaskHandle_t tasks[APP_TASK_COUNT];
+  int monitorSlots[APP_TASK_COUNT];
+  uint32_t dropped[APP_TASK_COUNT];
+
+  bool post(AppTaskId id, const void* msg) {
+    if (queues[id] == NULL || xQueueSend(queues[id], msg, 0) != pdTRUE) {
+      dropped[id]++;
+      return false;
+    }
+    return true;
+  }
+
+  bool startTask(AppTaskId id, TaskFunction_t fn, const char* name, uint32_t stack, UBaseType_t priority, BaseType_t core) {
+    // Platz vor dem Anlegen belegen: Der Task kann auf dem anderen Kern sofort loslaufen,
+    // und sein erstes busyBegin() muss denselben Platz sehen wie busyEnd()
+    monitorSlots[id] = taskMonitor.add(name, NULL);
+    if (xTaskCreatePinnedToCore(fn, name, stack, NULL, priority, &tasks[id], core) != pdPASS) {
+      monitorSlots[id] = -1;
+      return false;
+    }
+    taskMonitor.setHandle(monitorSlots[id], tasks[id]);
+    return true;
+  }
+
+public:
+  AppTasks() {
+    for (int i = 0; i < APP_TASK_COUNT; i++) {
+      queues[i] = NULL;
+      tasks[i] = NULL;
+      monitorSlots[i] = -1;
+      dropped[i] = 0;
+    }
+  }
+
+  /**
+   * Legt die Warteschlangen an. Vor dem ersten post*() aufrufen; Nachrichten
+   * bleiben liegen, bis die Tasks mit start() laufen.
+   *
+   * @return false, wenn der Speicher nicht reicht
+   */
+  bool createQueues() {
+    queues[APP_TASK_UI] = xQueueCreate(APP_QUEUE_LENGTH, sizeof(UiEvent));
+    queues[APP_TASK_NET] = xQueueCreate(APP_QUEUE_LENGTH, sizeof(NetEvent));
+    return queues[APP_TASK_UI] != NULL && queues[APP_TASK_NET] != NULL;
+  }
+
+  /**
+   * Startet die drei Tasks.
+   *
+   * @return false, wenn ein Task nicht angelegt werden konnte
+   */
+  bool start(TaskFunction_t controlFn, TaskFunction_t uiFn, TaskFunction_t netFn) {
+    // Die Oberfläche zuerst, damit Steuerung und Netzwerk sie wecken können
+    if (!startTask(APP_TASK_UI, uiFn, "ui", APP_UI_STACK, APP_UI_PRIORITY, APP_UI_CORE) ||
+        !startTask(APP_TASK_CONTROL, controlFn, "control", APP_CONTROL_STACK, APP_CONTROL_PRIORITY, APP_CONTROL_CORE)) {
+      return false;
+    }
+    commandQueue.setOwner(tasks[APP_TASK_CONTROL]);
+    return startTask(APP_TASK_NET, netFn, "net", APP_NET_STACK, APP_NET_PRIORITY, APP_NET_CORE);
+  }
+
+  /**
+   * Sendet ein Ereignis an die Oberfläche und weckt sie aus dem Schlaf.
+   */
+  bool postUi(UiEventType type, int32_t value = 0, const char* text = NULL) {
+    UiEvent event = {type, value, text};
+    if (!post(APP_TASK_UI, &event)) {
+      return false;
+    }
+    if (tasks[APP_TASK_UI] != NULL) {
+      xTaskNotifyGive(tasks[APP_TASK_UI]);
+    }
+    return true;
+  }
+
+  /**
+   * Sendet einen Auftrag an das Netzwerk.
+   */
+  bool postNet(NetEventType type, const char* status = NULL, int32_t program = 0, uint32_t duration = 0) {
+    NetEvent event = {type, status, program, duration};
+    return post(APP_TASK_NET, &event);
+  }
+
+  /**
+   * Wartet auf den nächsten Befehl an die Steuerung (nur im Steuerungs-Task).
+   * submit() weckt die Steuerung per Task-Benachrichtigung.
+   *
+   * @param timeoutMs Maximale Wartezeit
+   * @return false bei Timeout
+   */
+  bool receiveControl(ControlCommand* cmd, uint32_t timeoutMs) {
+    if (commandQueue.take(cmd)) {
+      return true;
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs));
+    return commandQueue.take(cmd);
+  }
+
+  /**
+   * Holt das nächste Ereignis für die Oberfläche (ohne Warten, geweckt wird per Task-Benachrichtigung).
+   */
+  bool receiveUi(UiEvent* event) {
+    return xQueueReceive(queues[APP_TASK_UI], event, 0) == pdTRUE;
+  }
+
+  /**
+   * Wartet auf den nächsten Auftrag an das Netzwerk.
+   */
+  bool receiveNet(NetEvent* event, uint32_t timeoutMs) {
+    return xQueueReceive(queues[APP_TASK_NET], event, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+  }
+
+  /**
+   * Rechenzeit eines Durchlaufs messen (siehe TaskMonitor).
+   */
+  void busyBegin(AppTaskId id) {
+    taskMonitor.begin(monitorSlots[id]);
+  }
+
+  void busyEnd(AppTaskId id) {
+    taskMonitor.end(monitorSlots[id]);
+  }
+
+  /**
+   * Gibt den FreeRTOS-Task zurück (NULL vor start()).
+   */
+  TaskHandle_t getTask(AppTaskId id) {
+    return tasks[id];
+  }
+
+  /**
+   * Gibt den Platz des Tasks im TaskMonitor zurück.
+   */
+  int getMonitorSlot(AppTaskId id) {
+    return monitorSlots[id];
+  }
+
+  /**
+   * Gibt die Anzahl der wartenden Nachrichten zurück.
+   */
+  uint32_t getQueued(AppTaskId id) {
+    if (id == APP_TASK_CONTROL) {
+      return commandQueue.getQueued();
+    }
+    return queues[id] != NULL ? uxQueueMessagesWaiting(queues[id]) : 0;
+  }
+
+  /**
+   * Gibt die Anzahl der wegen voller Warteschlange verworfenen Nachrichten zurück.
+   */
+  uint32_t getDropped(AppTaskId id) {
+    if (id == APP_TASK_CONTROL) {
+      return commandQueue.getStats().full;
+    }
+    return dropped[id];
+  }
+};
+
+static AppTasks appTasks;
+
+#endif // APP_TASKS_H
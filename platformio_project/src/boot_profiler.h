@@ -0,0 +1,202 @@
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <Arduino.h>
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+
+// Gespeicherte Starts (der laufende eingeschlossen)
+#ifndef BOOT_PROFILE_HISTORY
+#define BOOT_PROFILE_HISTORY 4
+#endif
+
+// Phasen je Start
+#ifndef BOOT_PROFILE_PHASES
+#define BOOT_PROFILE_PHASES 24
+#endif
+
+// Länge der Phasennamen inkl. Nullbyte; mit dem Aufbau ändert sich BOOT_PROFILE_MAGIC
+#define BOOT_PHASE_NAME_LEN 16
+#define BOOT_PROFILE_MAGIC 0xB0075EEE
+
+// Eine Phase: Name, Ende und Dauer in µs seit dem Start der Anwendung
+struct BootPhase {
+  char name[BOOT_PHASE_NAME_LEN];
+  uint32_t atUs;
+  uint32_t durationUs;  // 0 bei Meilensteinen (z.B. erster Frame)
+};
+
+struct BootProfile {
+  uint32_t boot;         // Fortlaufende Nummer des Starts
+  uint8_t resetReason;   // esp_reset_reason_t
+  uint8_t fastBoot;
+  uint8_t phaseCount;
+  uint8_t reserved;
+  BootPhase phases[BOOT_PROFILE_PHASES];
+};
+
+// Liegt im RTC-Speicher und übersteht Software-Resets, Watchdog und Tiefschlaf (nicht das Ausschalten)
+struct BootProfileStore {
+  uint32_t magic;
+  uint32_t bootCount;
+  uint8_t head;   // Platz des laufenden Starts
+  uint8_t count;  // Belegte Plätze
+  uint8_t reserved[2];
+  BootProfile profiles[BOOT_PROFILE_HISTORY];
+};
+
+static RTC_NOINIT_ATTR BootProfileStore bootProfileStore;
+
+/**
+ * Misst die Phasen des Starts mit esp_timer (µs seit dem Start der Anwendung)
+ * und behält die letzten BOOT_PROFILE_HISTORY Starts im RTC-Speicher.
+ * Der laufende Start wird direkt dort eingetragen; bleibt ein Start hängen oder
+ * stürzt ab, zeigt der nächste Start, wie weit er gekommen ist.
+ *
+ * mark() misst die Phasen von setup() der Reihe nach, record() und milestone()
+ * dürfen auch die Tasks aufrufen.
+ */
+class BootProfiler {
+private:
+  BootProfile* current;
+  uint32_t lastMarkUs;
+  portMUX_TYPE lock;
+
+  void add(const char* name, uint32_t atUs, uint32_t durationUs) {
+    if (current == NULL) {
+      return;
+    }
+    portENTER_CRITICAL(&lock);
+    if (current->phaseCount < BOOT_PROFILE_PHASES) {
+      BootPhase &phase = current->phases[current->phaseCount];
+      strncpy(phase.name, name, BOOT_PHASE_NAME_LEN - 1);
+      phase.name[BOOT_PHASE_NAME_LEN - 1] = '\0';
+      phase.atUs = atUs;
+      phase.durationUs = durationUs;
+      current->phaseCount++;
+    }
+    portEXIT_CRITICAL(&lock);
+  }
+
+public:
+  BootProfiler() : current(NULL), lastMarkUs(0) {
+    portMUX_INITIALIZE(&lock);
+  }
+
+  /**
+   * Beginnt das Profil dieses Starts (als Erstes in setup()).
+   *
+   * @param fastBoot true, wenn der Schnellstart aktiv ist
+   */
+  void begin(bool fastBoot) {
+    BootProfileStore &store = bootProfileStore;
+    // Nach dem Einschalten ist der RTC-Speicher zufällig belegt
+    if (store.magic != BOOT_PROFILE_MAGIC || store.head >= BOOT_PROFILE_HISTORY || store.count > BOOT_PROFILE_HISTORY) {
+      memset(&store, 0, sizeof(store));
+      store.magic = BOOT_PROFILE_MAGIC;
+      store.head = BOOT_PROFILE_HISTORY - 1;
+    }
+    store.bootCount++;
+    store.head = (store.head + 1) % BOOT_PROFILE_HISTORY;
+    if (store.count < BOOT_PROFILE_HISTORY) {
+      store.count++;
+    }
+
+    current = &store.profiles[store.head];
+    memset(current, 0, sizeof(BootProfile));
+    current->boot = store.bootCount;
+    current->resetReason = esp_reset_reason();
+    current->fastBoot = fastBoot;
+    lastMarkUs = 0;  // Die erste Phase reicht bis zum Start der Anwendung zurück
+  }
+
+  /**
+   * Gibt die Zeit seit dem Start der Anwendung in µs zurück.
+   */
+  static uint32_t now() {
+    return (uint32_t)esp_timer_get_time();
+  }
+
+  /**
+   * Schließt eine Phase von setup() ab, sie beginnt mit dem Ende der vorherigen.
+   */
+  void mark(const char* name) {
+    uint32_t t = now();
+    add(name, t, t - lastMarkUs);
+    lastMarkUs = t;
+  }
+
+  /**
+   * Trägt eine Phase ein, die bei startUs (Rückgabe von now()) begonnen hat (aus jedem Task).
+   */
+  void record(const char* name, uint32_t startUs) {
+    uint32_t t = now();
+    add(name, t, t - startUs);
+  }
+
+  /**
+   * Trägt einen Zeitpunkt ohne Dauer ein (aus jedem Task).
+   */
+  void milestone(const char* name) {
+    add(name, now(), 0);
+  }
+
+  /**
+   * Gibt ein gespeichertes Profil zurück, 0 = laufender Start.
+   *
+   * @return NULL, wenn es so viele Starts noch nicht gibt
+   */
+  const BootProfile* get(uint8_t age) {
+    BootProfileStore &store = bootProfileStore;
+    if (current == NULL || age >= store.count) {
+      return NULL;
+    }
+    return &store.profiles[(store.head + BOOT_PROFILE_HISTORY - age) % BOOT_PROFILE_HISTORY];
+  }
+
+  /**
+   * Sucht eine Phase im Profil.
+   *
+   * @return NULL, wenn die Phase (noch) nicht eingetragen ist
+   */
+  static const BootPhase* find(const BootProfile &profile, const char* name) {
+    for (uint8_t i = 0; i < profile.phaseCount && i < BOOT_PROFILE_PHASES; i++) {
+      if (strncmp(profile.phases[i].name, name, BOOT_PHASE_NAME_LEN) == 0) {
+        return &profile.phases[i];
+      }
+    }
+    return NULL;
+  }
+
+  /**
+   * Gibt ein Profil als Tabelle aus (Serial).
+   */
+  static void print(Print &out, const BootProfile &profile) {
+    out.printf("Start %u (%s%s):\n", (unsigned)profile.boot, resetReasonName(profile.resetReason),
+               profile.fastBoot ? ", Schnellstart" : "");
+    for (uint8_t i = 0; i < profile.phaseCount && i < BOOT_PROFILE_PHASES; i++) {
+      const BootPhase &phase = profile.phases[i];
+      out.printf("  %-15s %8u us  bei %8u us\n", phase.name, (unsigned)phase.durationUs, (unsigned)phase.atUs);
+    }
+  }
+
+  static const char* resetReasonName(uint8_t reason) {
+    switch (reason) {
+      case ESP_RST_POWERON:   return "poweron";
+      case ESP_RST_EXT:       return "ext";
+      case ESP_RST_SW:        return "sw";
+      case ESP_RST_PANIC:     return "panic";
+      case ESP_RST_INT_WDT:   return "int_wdt";
+      case ESP_RST_TASK_WDT:  return "task_wdt";
+      case ESP_RST_WDT:       return "wdt";
+      case ESP_RST_DEEPSLEEP: return "deepsleep";
+      case ESP_RST_BROWNOUT:  return "brownout";
+    }
+    return "unknown";
+  }
+};
+
+static BootProfiler bootProfiler;
+
+#endif // BOOT_PROFILER_H
@@ -0,0 +1,247 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "mpsc_queue.h"
+
+// Plätze der Befehlswarteschlange (Zweierpotenz)
+#ifndef COMMAND_QUEUE_LENGTH
+#define COMMAND_QUEUE_LENGTH 16
+#endif
+
+// Anzahl der zuletzt vergebenen Ergebnisse, die noch abgefragt werden können (Zweierpotenz)
+#ifndef COMMAND_RESULT_SLOTS
+#define COMMAND_RESULT_SLOTS 16
+#endif
+
+// Befehle an die Steuerung
+enum ControlCommandType {
+  CONTROL_START_PROGRAM,    // value: Programmindex 1-4
+  CONTROL_STOP_PROGRAM,
+  CONTROL_SET_CUSTOM_DAYS,  // value: Tage 1-99
+  CONTROL_PROGRAM_DEADLINE, // value: Generation der Frist (ProgramSupervisor)
+  CONTROL_SET_REMOTE_CONTROL, // value: 1 = Fernsteuerung aktiviert
+};
+
+// Herkunft eines Befehls (für Statistik und Log)
+enum CommandSource {
+  COMMAND_SOURCE_TOUCH,
+  COMMAND_SOURCE_MQTT,
+  COMMAND_SOURCE_REST,
+  COMMAND_SOURCE_TIMER,
+  COMMAND_SOURCE_COUNT
+};
+
+// Ergebnis eines Befehls
+enum CommandResult {
+  COMMAND_PENDING,     // Noch nicht ausgeführt
+  COMMAND_OK,
+  COMMAND_INVALID,     // Ungültiger Wert, Zustand unverändert
+  COMMAND_QUEUE_FULL,  // Nicht angenommen
+  COMMAND_TIMEOUT,     // Nicht rechtzeitig ausgeführt (läuft eventuell noch)
+  COMMAND_EXPIRED,     // Ergebnis bereits von neueren Befehlen überschrieben
+};
+
+struct ControlCommand {
+  ControlCommandType type;
+  int32_t value;
+  CommandSource source;
+  uint32_t ticket;       // Kennung für das Ergebnis
+  TaskHandle_t waiter;   // Wird nach der Ausführung benachrichtigt (oder NULL)
+  uint32_t submittedUs;
+};
+
+/**
+ * Zähler der Befehlswarteschlange.
+ * latencyUs / maxLatencyUs: Zeit von submit() bis complete() (letzter Befehl / Maximum)
+ * Die Zähler der Einsender laufen ohne Sperre mit und sind bei gleichzeitigem Einreichen Näherungswerte.
+ */
+struct CommandQueueStats {
+  uint32_t submitted[COMMAND_SOURCE_COUNT];
+  uint32_t completed;
+  uint32_t rejected;  // Ergebnis COMMAND_INVALID
+  uint32_t full;
+  uint32_t timeouts;
+  uint32_t latencyUs;
+  uint32_t maxLatencyUs;
+};
+
+/**
+ * Befehle von Touch, MQTT, REST und Timern an die Steuerung.
+ * Beliebige Tasks legen Befehle mit submit() in eine lock-freie MPSC-Warteschlange,
+ * nur der Eigentümer (der Steuerungs-Task) entnimmt sie mit take() und meldet das
+ * Ergebnis mit complete(). Ergebnisse liegen in einem Ring aus atomaren Worten
+ * (Ticket in den oberen 24 Bit, Ergebnis im unteren Byte), der Einsender fragt sie
+ * mit wait() oder result() ab. Der Einsender wird per Task-Benachrichtigung geweckt,
+ * ein Timeout hinterlässt daher keine verwaisten Zeiger.
+ */
+class CommandQueue {
+  static_assert((COMMAND_RESULT_SLOTS & (COMMAND_RESULT_SLOTS - 1)) == 0, "COMMAND_RESULT_SLOTS muss eine Zweierpotenz sein");
+
+private:
+  MpscQueue<ControlCommand, COMMAND_QUEUE_LENGTH> queue;
+  std::atomic<uint32_t> results[COMMAND_RESULT_SLOTS];
+  std::atomic<uint32_t> nextTicket;
+  TaskHandle_t owner;
+  CommandQueueStats stats;
+
+  static uint32_t pack(uint32_t ticket, CommandResult result) {
+    return (ticket << 8) | (uint8_t)result;
+  }
+
+public:
+  CommandQueue() : nextTicket(1), owner(NULL) {
+    for (uint32_t i = 0; i < COMMAND_RESULT_SLOTS; i++) {
+      results[i].store(0, std::memory_order_relaxed);
+    }
+    memset(&stats, 0, sizeof(stats));
+  }
+
+  /**
+   * Legt den Task fest, der die Befehle ausführt und bei neuen Befehlen geweckt wird.
+   * Vorher eingereichte Befehle bleiben liegen.
+   */
+  void setOwner(TaskHandle_t task) {
+    owner = task;
+    if (owner != NULL && queue.size() > 0) {
+      xTaskNotifyGive(owner);
+    }
+  }
+
+  /**
+   * Reicht einen Befehl ein (aus jedem Task, nicht aus ISRs).
+   *
+   * @param type Befehl
+   * @param value Parameter des Befehls
+   * @param source Herkunft
+   * @param notify true: den aufrufenden Task nach der Ausführung benachrichtigen (für wait())
+   * @return Ticket für wait()/result(), 0 wenn die Warteschlange voll ist
+   */
+  uint32_t submit(ControlCommandType type, int32_t value, CommandSource source, bool notify = false) {
+    uint32_t ticket;
+    do {
+      ticket = nextTicket.fetch_add(1, std::memory_order_relaxed) & 0xFFFFFF;
+    } while (ticket == 0);
+
+    ControlCommand cmd = {type, value, source, ticket, notify ? xTaskGetCurrentTaskHandle() : NULL, micros()};
+    results[ticket & (COMMAND_RESULT_SLOTS - 1)].store(pack(ticket, COMMAND_PENDING), std::memory_order_release);
+    if (!queue.push(cmd)) {
+      results[ticket & (COMMAND_RESULT_SLOTS - 1)].store(pack(ticket, COMMAND_QUEUE_FULL), std::memory_order_release);
+      stats.full++;
+      return 0;
+    }
+    stats.submitted[source]++;
+    if (owner != NULL) {
+      xTaskNotifyGive(owner);
+    }
+    return ticket;
+  }
+
+  /**
+   * Entnimmt den nächsten Befehl (nur vom Eigentümer).
+   *
+   * @return false, wenn keiner bereitliegt
+   */
+  bool take(ControlCommand* cmd) {
+    return queue.pop(*cmd);
+  }
+
+  /**
+   * Meldet das Ergebnis eines entnommenen Befehls und weckt den Einsender.
+   */
+  void complete(const ControlCommand &cmd, CommandResult result) {
+    results[cmd.ticket & (COMMAND_RESULT_SLOTS - 1)].store(pack(cmd.ticket, result), std::memory_order_release);
+
+    uint32_t latency = micros() - cmd.submittedUs;
+    stats.completed++;
+    stats.latencyUs = latency;
+    if (latency > stats.maxLatencyUs) {
+      stats.maxLatencyUs = latency;
+    }
+    if (result == COMMAND_INVALID) {
+      stats.rejected++;
+    }
+    if (cmd.waiter != NULL) {
+      xTaskNotifyGive(cmd.waiter);
+    }
+  }
+
+  /**
+   * Fragt das Ergebnis eines Befehls ab, ohne zu warten.
+   */
+  CommandResult result(uint32_t ticket) {
+    if (ticket == 0) {
+      return COMMAND_QUEUE_FULL;
+    }
+    uint32_t packed = results[ticket & (COMMAND_RESULT_SLOTS - 1)].load(std::memory_order_acquire);
+    if ((packed >> 8) != ticket) {
+      return COMMAND_EXPIRED;
+    }
+    return (CommandResult)(packed & 0xFF);
+  }
+
+  /**
+   * Wartet auf das Ergebnis eines mit notify = true eingereichten Befehls.
+   * Verbraucht die Task-Benachrichtigungen des aufrufenden Tasks.
+   *
+   * @param ticket Rückgabe von submit()
+   * @param timeoutMs Maximale Wartezeit
+   * @return Ergebnis oder COMMAND_TIMEOUT
+   */
+  CommandResult wait(uint32_t ticket, uint32_t timeoutMs) {
+    uint32_t start = millis();
+    for (;;) {
+      CommandResult r = result(ticket);
+      if (r != COMMAND_PENDING) {
+        return r;
+      }
+      uint32_t waited = millis() - start;
+      if (waited >= timeoutMs) {
+        stats.timeouts++;
+        return COMMAND_TIMEOUT;
+      }
+      // Benachrichtigungen älterer, verspäteter Befehle führen nur zu einer weiteren Runde
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs - waited));
+    }
+  }
+
+  /**
+   * Reicht einen Befehl ein und wartet auf sein Ergebnis.
+   */
+  CommandResult submitAndWait(ControlCommandType type, int32_t value, CommandSource source, uint32_t timeoutMs) {
+    uint32_t ticket = submit(type, value, source, true);
+    return ticket != 0 ? wait(ticket, timeoutMs) : COMMAND_QUEUE_FULL;
+  }
+
+  /**
+   * Gibt die Anzahl der wartenden Befehle zurück.
+   */
+  uint32_t getQueued() {
+    return queue.size();
+  }
+
+  const CommandQueueStats &getStats() {
+    return stats;
+  }
+
+  /**
+   * Kurzer Text zu einem Ergebnis (für REST- und MQTT-Antworten).
+   */
+  static const char* resultName(CommandResult result) {
+    switch (result) {
+      case COMMAND_PENDING:    return "pending";
+      case COMMAND_OK:         return "ok";
+      case COMMAND_INVALID:    return "invalid";
+      case COMMAND_QUEUE_FULL: return "queue_full";
+      case COMMAND_TIMEOUT:    return "timeout";
+      case COMMAND_EXPIRED:    return "expired";
+    }
+    return "unknown";
+  }
+};
+
+static CommandQueue commandQueue;
+
+#endif // COMMAND_QUEUE_H
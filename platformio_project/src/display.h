@@ -2,17 +2,14 @@
 #define DISPLAY_H
 
 #include <lvgl.h>
-#include <TFT_eSPI.h>
 
-// Fortschrittsbalken-Typen
-enum ProgressBarType {
-  BAR_HORIZONTAL,
-  BAR_VERTICAL,
-  BAR_CIRCULAR
-};
+#include "ui_decor.h"
+#include "ui_progress.h"
+#include "ui_styles.h"
 
 /**
- * Hilfsfunktion zum Erstellen eines ansprechenden Fortschrittsbalkens mit LVGL
+ * Hilfsfunktion zum Erstellen eines ansprechenden Fortschrittsbalkens mit LVGL.
+ * Liefert ein Widget aus ui_progress.h, Werte daher mit uiProgressSetValue() setzen.
  * 
  * @param parent Elternobjekt im LVGL-Objektbaum
  * @param x X-Position des Balkens
@@ -20,36 +17,20 @@ enum ProgressBarType {
  * @param width Breite des Balkens
  * @param height Höhe des Balkens
  * @param initial_value Anfangswert (0-100)
+ * @param type Darstellung (Balken, Ring oder Bogen)
  * @return Pointer auf den erstellten Fortschrittsbalken
  */
-lv_obj_t* createStyledProgressBar(lv_obj_t* parent, int16_t x, int16_t y, int16_t width, int16_t height, int16_t initial_value) {
-    // Fortschrittsbalken erstellen
-    lv_obj_t* bar = lv_bar_create(parent);
+lv_obj_t* createStyledProgressBar(lv_obj_t* parent, int16_t x, int16_t y, int16_t width, int16_t height, int16_t initial_value,
+                                  ProgressBarType type = BAR_HORIZONTAL) {
+    // Fortschrittsbalken erstellen (Styles setzt uiProgressCreate)
+    lv_obj_t* bar = uiProgressCreate(parent, type);
+    if (bar == NULL) {
+        return NULL;
+    }
     lv_obj_set_size(bar, width, height);
     lv_obj_align(bar, LV_ALIGN_TOP_LEFT, x, y);
-    lv_bar_set_range(bar, 0, 100);
-    lv_bar_set_value(bar, initial_value, LV_ANIM_OFF);
-    
-    // Style für den Hintergrund
-    static lv_style_t style_bg;
-    lv_style_init(&style_bg);
-    lv_style_set_border_width(&style_bg, 2);
-    lv_style_set_border_color(&style_bg, lv_color_hex(0x555555));
-    lv_style_set_pad_all(&style_bg, 3);
-    lv_style_set_radius(&style_bg, 6);
-    lv_style_set_bg_color(&style_bg, lv_color_hex(0x333333));
-    
-    // Style für den Indikator (Fortschritt)
-    static lv_style_t style_indic;
-    lv_style_init(&style_indic);
-    lv_style_set_bg_color(&style_indic, lv_color_hex(0x00DDDD)); // Türkis
-    lv_style_set_bg_grad_color(&style_indic, lv_color_hex(0x00AAAA));
-    lv_style_set_bg_grad_dir(&style_indic, LV_GRAD_DIR_HOR);
-    lv_style_set_radius(&style_indic, 3);
-    
-    // Styles anwenden
-    lv_obj_add_style(bar, &style_bg, LV_PART_MAIN);
-    lv_obj_add_style(bar, &style_indic, LV_PART_INDICATOR);
+    uiProgressSetRange(bar, 0, 100);
+    uiProgressSetValue(bar, initial_value, LV_ANIM_OFF);
     
     return bar;
 }
@@ -73,27 +54,8 @@ lv_obj_t* createStyledButton(lv_obj_t* parent, int16_t x, int16_t y, int16_t wid
     lv_obj_set_size(btn, width, height);
     lv_obj_align(btn, LV_ALIGN_TOP_LEFT, x, y);
     
-    // Style für den Button
-    static lv_style_t style_btn;
-    lv_style_init(&style_btn);
-    lv_style_set_radius(&style_btn, 10);
-    lv_style_set_bg_color(&style_btn, lv_color_hex(0x005577));
-    lv_style_set_bg_grad_color(&style_btn, lv_color_hex(0x007799));
-    lv_style_set_bg_grad_dir(&style_btn, LV_GRAD_DIR_VER);
-    lv_style_set_shadow_width(&style_btn, 5);
-    lv_style_set_shadow_color(&style_btn, lv_color_hex(0x000000));
-    lv_style_set_shadow_opa(&style_btn, LV_OPA_30);
-    
-    // Style für den gedrückten Zustand
-    static lv_style_t style_btn_pressed;
-    lv_style_init(&style_btn_pressed);
-    lv_style_set_bg_color(&style_btn_pressed, lv_color_hex(0x004466));
-    lv_style_set_bg_grad_color(&style_btn_pressed, lv_color_hex(0x006688));
-    lv_style_set_shadow_width(&style_btn_pressed, 2);
-    
-    // Styles anwenden
-    lv_obj_add_style(btn, &style_btn, LV_PART_MAIN);
-    lv_obj_add_style(btn, &style_btn_pressed, LV_PART_MAIN | LV_STATE_PRESSED);
+    // Styles anwenden, Verlauf und Schatten ggf. als vorgerendertes Bild
+    uiDecorate(btn, UI_DECOR_BUTTON);
     
     // Container für Icon + Text mit flexibler Anordnung
     lv_obj_t* cont = lv_obj_create(btn);
@@ -107,13 +69,13 @@ lv_obj_t* createStyledButton(lv_obj_t* parent, int16_t x, int16_t y, int16_t wid
     if (icon_symbol != NULL) {
         lv_obj_t* icon = lv_label_create(cont);
         lv_label_set_text(icon, icon_symbol);
-        lv_obj_set_style_text_color(icon, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(icon, &uiStyles.text, 0);
     }
     
     // Text hinzufügen
     lv_obj_t* label = lv_label_create(cont);
     lv_label_set_text(label, text);
-    lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(label, &uiStyles.text, 0);
     
     return btn;
 }
@@ -140,13 +102,12 @@ lv_obj_t* createTimeDisplay(lv_obj_t* parent, int16_t x, int16_t y, int16_t widt
         lv_obj_t* symbol = lv_label_create(cont);
         lv_label_set_text(symbol, LV_SYMBOL_CALENDAR);
         lv_obj_align(symbol, LV_ALIGN_LEFT_MID, 0, 0);
-        lv_obj_set_style_text_color(symbol, lv_color_hex(0xCCCCCC), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(symbol, &uiStyles.textMuted, 0);
     }
     
     // Zeitlabel erstellen
     lv_obj_t* label = lv_label_create(cont);
-    lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_18, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(label, &uiStyles.textClock, 0);
     
     if (use_calendar) {
         lv_obj_align(label, LV_ALIGN_LEFT_MID, 30, 0);
@@ -175,16 +136,14 @@ lv_obj_t* createScreenTitle(lv_obj_t* parent, const char* title, const char* sub
     // Haupttitel
     lv_obj_t* title_label = lv_label_create(cont);
     lv_label_set_text(title_label, title);
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_28, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_text_color(title_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(title_label, &uiStyles.title, 0);
     lv_obj_align(title_label, LV_ALIGN_TOP_MID, 0, 0);
     
     // Untertitel, falls vorhanden
     if (subtitle != NULL) {
         lv_obj_t* subtitle_label = lv_label_create(cont);
         lv_label_set_text(subtitle_label, subtitle);
-        lv_obj_set_style_text_font(subtitle_label, &lv_font_montserrat_16, LV_PART_MAIN | LV_STATE_DEFAULT);
-        lv_obj_set_style_text_color(subtitle_label, lv_color_hex(0xCCCCCC), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(subtitle_label, &uiStyles.subtitle, 0);
         lv_obj_align(subtitle_label, LV_ALIGN_TOP_MID, 0, 40);
     }
     
@@ -192,8 +151,7 @@ lv_obj_t* createScreenTitle(lv_obj_t* parent, const char* title, const char* sub
     lv_obj_t* line = lv_line_create(cont);
     static lv_point_t line_points[] = {{0, 0}, {750, 0}};
     lv_line_set_points(line, line_points, 2);
-    lv_obj_set_style_line_width(line, 2, LV_PART_MAIN | LV_STATE_DEFAULT);
-    lv_obj_set_style_line_color(line, lv_color_hex(0x00DDDD), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(line, &uiStyles.divider, 0);
     
     if (subtitle != NULL) {
         lv_obj_align(line, LV_ALIGN_TOP_MID, 0, 70);
@@ -224,14 +182,14 @@ lv_obj_t* createStatusIndicator(lv_obj_t* parent, int16_t x, int16_t y, const ch
     // Beschriftung
     lv_obj_t* label_obj = lv_label_create(cont);
     lv_label_set_text(label_obj, label);
-    lv_obj_set_style_text_color(label_obj, lv_color_hex(0xCCCCCC), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(label_obj, &uiStyles.textMuted, 0);
     lv_obj_align(label_obj, LV_ALIGN_TOP_LEFT, 0, 0);
     
     // Status-Icon erstellen
     lv_obj_t* icon = lv_obj_create(cont);
     lv_obj_set_size(icon, 20, 20);
     lv_obj_align(icon, LV_ALIGN_LEFT_MID, 0, 10);
-    lv_obj_set_style_radius(icon, LV_RADIUS_CIRCLE, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_add_style(icon, &uiStyles.statusDot, 0);
     
     // Status-Text
     lv_obj_t* status_text = lv_label_create(cont);
@@ -239,17 +197,17 @@ lv_obj_t* createStatusIndicator(lv_obj_t* parent, int16_t x, int16_t y, const ch
     
     // Status setzen
     if (init_state == 0) { // Fehler
-        lv_obj_set_style_bg_color(icon, lv_color_hex(0xFF4444), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(icon, &uiStyles.statusError, 0);
         lv_label_set_text(status_text, "Fehler");
-        lv_obj_set_style_text_color(status_text, lv_color_hex(0xFF4444), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(status_text, &uiStyles.statusError, 0);
     } else if (init_state == 1) { // OK
-        lv_obj_set_style_bg_color(icon, lv_color_hex(0x44FF44), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(icon, &uiStyles.statusOk, 0);
         lv_label_set_text(status_text, "OK");
-        lv_obj_set_style_text_color(status_text, lv_color_hex(0x44FF44), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(status_text, &uiStyles.statusOk, 0);
     } else { // Warnung
-        lv_obj_set_style_bg_color(icon, lv_color_hex(0xFFFF44), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(icon, &uiStyles.statusWarning, 0);
         lv_label_set_text(status_text, "Warnung");
-        lv_obj_set_style_text_color(status_text, lv_color_hex(0xFFFF44), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(status_text, &uiStyles.statusWarning, 0);
     }
     
     return cont;
@@ -0,0 +1,338 @@
+#ifndef DISPLAY_METRICS_H
+#define DISPLAY_METRICS_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+#include "ui_bindings.h"
+#include "ui_styles.h"
+
+// Anzahl der gespeicherten Refreshs (Ringpuffer, Basis der Histogramme)
+#ifndef DISPLAY_METRICS_SAMPLES
+#define DISPLAY_METRICS_SAMPLES 64
+#endif
+
+// Anzahl der Histogramm-Klassen, die Klassengrenzen verdoppeln sich
+#define DISPLAY_METRICS_BUCKETS 8
+
+// Obere Grenze der ersten Histogramm-Klasse
+#define DISPLAY_METRICS_TIME_BASE_US 500   // Render- und Flush-Zeit
+#define DISPLAY_METRICS_AREA_BASE_PX 1024  // Invalidierte Fläche
+
+/**
+ * Messwerte der Display-Pipeline.
+ * Je LVGL-Refresh werden Renderzeit, Flush-Zeit, invalidierte Fläche,
+ * übertragene Bytes und der belegte LVGL-Heap in einem Ringpuffer abgelegt.
+ * Daraus werden bei Bedarf Histogramme über die letzten Refreshs gebildet.
+ *
+ * Die Renderzeit ist die Dauer des Refreshs ohne die Zeit, in der LVGL im
+ * Flush-Callback oder im wait_cb auf den Bus gewartet hat. Die Flush-Zeit
+ * ist die Übertragungsdauer aller Flushs des Refreshs (bei DMA bis zur
+ * Fertigmeldung). Die Bytes zählen im Format des Busses (siehe begin()).
+ *
+ * Geschrieben wird nur im UI-Task. Andere Tasks lesen die Messwerte über
+ * read() als Kopie, die unter einer Sperre entsteht.
+ */
+class DisplayMetrics {
+public:
+  struct Sample {
+    uint32_t renderUs;
+    uint32_t flushUs;
+    uint32_t areaPx;
+    uint32_t bytes;
+    uint32_t heapUsed;
+  };
+
+  struct Histogram {
+    uint32_t base;                              // Obere Grenze der ersten Klasse
+    uint16_t counts[DISPLAY_METRICS_BUCKETS];   // Letzte Klasse: alles darüber
+  };
+
+  // Gespeicherte Refreshs und Gesamtwerte seit dem Start
+  struct Stats {
+    Sample samples[DISPLAY_METRICS_SAMPLES];
+    uint16_t head;
+    uint16_t count;
+    uint32_t refreshes;
+    uint64_t totalPixels;
+    uint64_t totalFlushUs;
+
+    /**
+     * Erstellt ein Histogramm über die gespeicherten Refreshs.
+     *
+     * @param field Zeiger auf das auszuwertende Feld eines Samples (z.B. &Sample::renderUs)
+     * @param base Obere Grenze der ersten Klasse
+     */
+    Histogram histogram(uint32_t Sample::*field, uint32_t base) const {
+      Histogram h;
+      h.base = base;
+      memset(h.counts, 0, sizeof(h.counts));
+      for (uint16_t i = 0; i < count; i++) {
+        h.counts[bucketOf(samples[i].*field, base)]++;
+      }
+      return h;
+    }
+
+    /**
+     * Mittelwert und Maximum eines Feldes über die gespeicherten Refreshs.
+     */
+    void summary(uint32_t Sample::*field, uint32_t &avg, uint32_t &max) const {
+      uint64_t sum = 0;
+      max = 0;
+      for (uint16_t i = 0; i < count; i++) {
+        uint32_t value = samples[i].*field;
+        sum += value;
+        if (value > max) {
+          max = value;
+        }
+      }
+      avg = count > 0 ? sum / count : 0;
+    }
+
+    /**
+     * Gibt den zuletzt gespeicherten Refresh zurück (leer, wenn noch keiner gemessen wurde).
+     */
+    Sample last() const {
+      if (count == 0) {
+        return Sample();
+      }
+      return samples[(head + DISPLAY_METRICS_SAMPLES - 1) % DISPLAY_METRICS_SAMPLES];
+    }
+
+    /**
+     * Mittlerer Durchsatz des Flush-Pfads seit dem Start (Pixel pro Sekunde).
+     */
+    uint32_t getPixelsPerSecond() const {
+      return totalFlushUs > 0 ? (uint32_t)(totalPixels * 1000000ULL / totalFlushUs) : 0;
+    }
+  };
+
+private:
+  lv_disp_t* disp;
+  uint8_t busBytesPerPixel;
+
+  Stats stats;
+  portMUX_TYPE lock;
+
+  // Laufender Refresh
+  Sample current;
+  uint32_t blockedUs;
+  uint32_t flushStartUs;
+  bool flushPending;
+  bool commitPending;
+
+  // Overlay
+  lv_obj_t* overlay;
+  bool overlayVisible;
+
+  static DisplayMetrics* instance;
+
+  /**
+   * Ersetzt den Refresh-Timer von LVGL und misst den Refresh.
+   */
+  static void refrTimerCb(lv_timer_t* timer) {
+    DisplayMetrics* self = instance;
+    if (self->commitPending) {
+      // Letzter DMA-Transfer des vorherigen Refreshs noch offen
+      self->commit();
+    }
+
+    self->current.areaPx = self->invalidatedArea();
+    self->blockedUs = 0;
+
+    uint32_t t0 = micros();
+    _lv_disp_refr_timer(timer);
+    uint32_t total = micros() - t0;
+
+    // Nichts gezeichnet
+    if (self->current.bytes == 0 && !self->flushPending) {
+      self->current = Sample();
+      return;
+    }
+
+    self->current.renderUs = total > self->blockedUs ? total - self->blockedUs : 0;
+    if (self->flushPending) {
+      self->commitPending = true;
+    } else {
+      self->commit();
+    }
+  }
+
+  /**
+   * Summiert die invalidierten Bereiche des Displays.
+   */
+  uint32_t invalidatedArea() {
+    uint32_t area = 0;
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+      if (!disp->inv_area_joined[i]) {
+        area += lv_area_get_size(&disp->inv_areas[i]);
+      }
+    }
+    return area;
+  }
+
+  /**
+   * Schließt den laufenden Refresh ab und legt ihn im Ringpuffer ab.
+   */
+  void commit() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    current.heapUsed = mon.total_size - mon.free_size;
+
+    portENTER_CRITICAL(&lock);
+    stats.samples[stats.head] = current;
+    stats.head = (stats.head + 1) % DISPLAY_METRICS_SAMPLES;
+    if (stats.count < DISPLAY_METRICS_SAMPLES) {
+      stats.count++;
+    }
+
+    stats.refreshes++;
+    stats.totalPixels += current.bytes / busBytesPerPixel;
+    stats.totalFlushUs += current.flushUs;
+    portEXIT_CRITICAL(&lock);
+
+    current = Sample();
+    commitPending = false;
+  }
+
+  static uint8_t bucketOf(uint32_t value, uint32_t base) {
+    uint8_t bucket = 0;
+    while (bucket < DISPLAY_METRICS_BUCKETS - 1 && value >= base) {
+      base <<= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+public:
+  DisplayMetrics()
+    : disp(NULL), busBytesPerPixel(sizeof(lv_color_t)), stats(), current(), blockedUs(0),
+      flushStartUs(0), flushPending(false), commitPending(false), overlay(NULL),
+      overlayVisible(false) {
+    portMUX_INITIALIZE(&lock);
+  }
+
+  /**
+   * Verbindet die Messung mit dem Display.
+   * Ersetzt den Callback des Refresh-Timers, Periode und Steuerung bleiben bei LVGL.
+   *
+   * @param display LVGL-Display
+   * @param bytesPerPixel Bytes je Pixel auf dem Bus zum Display (z.B. 3 beim ILI9488 mit RGB666)
+   */
+  void begin(lv_disp_t* display, uint8_t bytesPerPixel) {
+    disp = display;
+    busBytesPerPixel = bytesPerPixel;
+    instance = this;
+    lv_timer_set_cb(disp->refr_timer, refrTimerCb);
+  }
+
+  /**
+   * Zu Beginn eines Flushs aufrufen (im Flush-Callback).
+   */
+  void flushStart() {
+    flushStartUs = micros();
+    flushPending = true;
+  }
+
+  /**
+   * Nach Abschluss der Übertragung aufrufen.
+   *
+   * @param pixels Anzahl der übertragenen Pixel
+   */
+  void flushEnd(uint32_t pixels) {
+    current.flushUs += micros() - flushStartUs;
+    current.bytes += pixels * busBytesPerPixel;
+    flushPending = false;
+    if (commitPending) {
+      commit();
+    }
+  }
+
+  /**
+   * Meldet Zeit, in der der Refresh auf den Bus gewartet hat (Flush-Callback, wait_cb).
+   */
+  void addBlocked(uint32_t us) {
+    blockedUs += us;
+  }
+
+  /**
+   * Kopiert die gespeicherten Refreshs und Gesamtwerte (aus jedem Task).
+   */
+  void read(Stats &out) {
+    portENTER_CRITICAL(&lock);
+    out = stats;
+    portEXIT_CRITICAL(&lock);
+  }
+
+  /**
+   * Gibt die Anzahl aller gemessenen Refreshs zurück.
+   */
+  uint32_t getRefreshCount() {
+    return stats.refreshes;
+  }
+
+  /**
+   * Gibt die Bytes je Pixel auf dem Bus zum Display zurück.
+   */
+  uint8_t getBusBytesPerPixel() {
+    return busBytesPerPixel;
+  }
+
+  /**
+   * Mittlerer Durchsatz des Flush-Pfads seit dem Start (Pixel pro Sekunde, aus jedem Task).
+   */
+  uint32_t getPixelsPerSecond() {
+    portENTER_CRITICAL(&lock);
+    uint64_t pixels = stats.totalPixels;
+    uint64_t flushUs = stats.totalFlushUs;
+    portEXIT_CRITICAL(&lock);
+    return flushUs > 0 ? (uint32_t)(pixels * 1000000ULL / flushUs) : 0;
+  }
+
+  /**
+   * Blendet die Messwerte auf dem Display ein oder aus.
+   */
+  void setOverlayVisible(bool visible) {
+    overlayVisible = visible;
+    if (visible && overlay == NULL) {
+      overlay = lv_label_create(lv_layer_top());
+      lv_obj_add_style(overlay, &uiStyles.overlay, 0);
+      lv_obj_align(overlay, LV_ALIGN_BOTTOM_RIGHT, -5, -5);
+    } else if (!visible && overlay != NULL) {
+      lv_obj_del(overlay);
+      overlay = NULL;
+    }
+    updateOverlay();
+  }
+
+  /**
+   * Gibt zurück, ob das Overlay eingeblendet ist.
+   */
+  bool isOverlayVisible() {
+    return overlayVisible;
+  }
+
+  /**
+   * Aktualisiert das Overlay (periodisch aus der Hauptschleife aufrufen).
+   */
+  void updateOverlay() {
+    if (overlay == NULL) {
+      return;
+    }
+
+    // Läuft im UI-Task, der als einziger schreibt: keine Kopie nötig
+    uint32_t renderAvg, renderMax, flushAvg, flushMax;
+    stats.summary(&Sample::renderUs, renderAvg, renderMax);
+    stats.summary(&Sample::flushUs, flushAvg, flushMax);
+    Sample s = stats.last();
+
+    uiBindLabelFmt(overlay, "Render %lu/%lu us  Flush %lu/%lu us\n%lu kPx/s  Heap %lu B",
+                   (unsigned long)renderAvg, (unsigned long)renderMax,
+                   (unsigned long)flushAvg, (unsigned long)flushMax,
+                   (unsigned long)(stats.getPixelsPerSecond() / 1000), (unsigned long)s.heapUsed);
+  }
+};
+
+DisplayMetrics* DisplayMetrics::instance = NULL;
+
+#endif // DISPLAY_METRICS_H
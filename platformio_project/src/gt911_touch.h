@@ -0,0 +1,83 @@
+#ifndef GT911_TOUCH_H
+#define GT911_TOUCH_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// I2C-Adresse des GT911 (0x14, wenn INT beim Reset high liegt)
+#ifndef GT911_ADDR
+#define GT911_ADDR 0x5D
+#endif
+
+// Register
+#define GT911_REG_STATUS 0x814E  // Bit 7: Daten bereit, Bits 0-3: Anzahl Berührungen
+#define GT911_REG_POINT1 0x8150  // X (LSB, MSB), Y (LSB, MSB) des ersten Punkts
+
+/**
+ * Minimaler Treiber für den kapazitiven Touch-Controller GT911 (I2C).
+ * Liest nur den ersten Berührungspunkt, das genügt der Bedienoberfläche.
+ * Der Controller liefert Koordinaten bereits in Display-Auflösung.
+ */
+class Gt911Touch {
+private:
+  bool touched;
+  uint16_t lastX;
+  uint16_t lastY;
+
+  bool readRegister(uint16_t reg, uint8_t* data, uint8_t len) {
+    Wire.beginTransmission(GT911_ADDR);
+    Wire.write(reg >> 8);
+    Wire.write(reg & 0xFF);
+    if (Wire.endTransmission(false) != 0) {
+      return false;
+    }
+    if (Wire.requestFrom((uint8_t)GT911_ADDR, len) != len) {
+      return false;
+    }
+    for (uint8_t i = 0; i < len; i++) {
+      data[i] = Wire.read();
+    }
+    return true;
+  }
+
+  void writeRegister(uint16_t reg, uint8_t value) {
+    Wire.beginTransmission(GT911_ADDR);
+    Wire.write(reg >> 8);
+    Wire.write(reg & 0xFF);
+    Wire.write(value);
+    Wire.endTransmission();
+  }
+
+public:
+  Gt911Touch() : touched(false), lastX(0), lastY(0) {
+  }
+
+  /**
+   * Liest den aktuellen Zustand. Hat der Controller keine neuen Daten,
+   * bleibt der letzte Zustand erhalten.
+   *
+   * @return true bei Berührung
+   */
+  bool read(uint16_t* x, uint16_t* y) {
+    uint8_t status = 0;
+    if (readRegister(GT911_REG_STATUS, &status, 1) && (status & 0x80)) {
+      touched = false;
+      if ((status & 0x0F) > 0) {
+        uint8_t point[4];
+        if (readRegister(GT911_REG_POINT1, point, sizeof(point))) {
+          lastX = point[0] | (point[1] << 8);
+          lastY = point[2] | (point[3] << 8);
+          touched = true;
+        }
+      }
+      // Datenpuffer freigeben, sonst liefert der Controller keine neuen Werte
+      writeRegister(GT911_REG_STATUS, 0);
+    }
+
+    *x = lastX;
+    *y = lastY;
+    return touched;
+  }
+};
+
+#endif // GT911_TOUCH_H
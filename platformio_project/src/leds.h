@@ -3,6 +3,11 @@
 
 #include <Arduino.h>
 
+#include "timer_wheel.h"
+
+// Schrittweite des Puls-Modus in ms
+#define LED_PULSE_STEP_MS 10
+
 /**
  * LED-Manager zur Steuerung der Status-LEDs.
  * Ermöglicht einfaches Setzen von Farben, Blinken und Pulsen.
@@ -30,6 +35,52 @@ private:
   uint8_t pulseValue;
   int pulseDirection;
   unsigned long lastPulseTime;
+  
+  // Timer-Rad für Blinken und Pulsen (optional, sonst update() aufrufen)
+  TimerWheel *timers;
+  int effectJob;
+  
+  static void blinkJob(void *arg) {
+    ((LedManager*)arg)->blinkStep();
+  }
+  
+  static void pulseJob(void *arg) {
+    ((LedManager*)arg)->pulseStep();
+  }
+  
+  /**
+   * Ersetzt den laufenden Blink- oder Puls-Auftrag im Timer-Rad.
+   */
+  void scheduleEffect(const char *name, unsigned long interval, TimerJobFn fn) {
+    if (timers == NULL) {
+      return;
+    }
+    timers->cancel(effectJob);
+    effectJob = fn != NULL ? timers->every(name, interval, fn, this) : -1;
+  }
+  
+  void blinkStep() {
+    blinkState = !blinkState;
+    updateLeds();
+  }
+  
+  void pulseStep() {
+    // Pulsrichtung ändern, wenn Grenzen erreicht
+    if (pulseValue >= 255) {
+      pulseDirection = -1;
+    } else if (pulseValue <= 0) {
+      pulseDirection = 1;
+    }
+    
+    // Pulswert aktualisieren
+    pulseValue += pulseDirection * 5;
+    
+    // Auf gültigen Bereich begrenzen
+    if (pulseValue > 255) pulseValue = 255;
+    if (pulseValue < 0) pulseValue = 0;
+    
+    updateLeds();
+  }
 
 public:
   /**
@@ -43,7 +94,8 @@ public:
     : redPin(rPin), greenPin(gPin), bluePin(bPin),
       currentRed(0), currentGreen(0), currentBlue(0),
       blinkEnabled(false), blinkState(false), lastBlinkTime(0), blinkInterval(500),
-      pulseEnabled(false), pulseValue(0), pulseDirection(1), lastPulseTime(0) {
+      pulseEnabled(false), pulseValue(0), pulseDirection(1), lastPulseTime(0),
+      timers(NULL), effectJob(-1) {
   }
   
   /**
@@ -60,6 +112,16 @@ public:
     digitalWrite(bluePin, LOW);
   }
   
+  /**
+   * Lässt Blinken und Pulsen vom Timer-Rad des aufrufenden Tasks takten,
+   * update() ist danach nicht mehr nötig.
+   * 
+   * @param wheel Timer-Rad (muss im selben Task abgefragt werden)
+   */
+  void attachTimers(TimerWheel &wheel) {
+    timers = &wheel;
+  }
+  
   /**
    * Setzt die LED-Farbe.
    * 
@@ -75,6 +137,7 @@ public:
     // Blink und Pulse deaktivieren
     blinkEnabled = false;
     pulseEnabled = false;
+    scheduleEffect(NULL, 0, NULL);
     
     updateLeds();
   }
@@ -126,6 +189,7 @@ public:
     blinkInterval = interval;
     lastBlinkTime = millis();
     blinkState = true;
+    scheduleEffect("led_blink", interval, blinkJob);
     
     updateLeds();
   }
@@ -140,46 +204,35 @@ public:
     pulseValue = 0;
     pulseDirection = 1;
     lastPulseTime = millis();
+    scheduleEffect("led_pulse", LED_PULSE_STEP_MS, pulseJob);
     
     updateLeds();
   }
   
   /**
    * Aktualisiert die LEDs basierend auf dem aktuellen Modus.
-   * Muss regelmäßig aufgerufen werden, wenn Blink oder Puls aktiv ist.
+   * Muss ohne Timer-Rad regelmäßig aufgerufen werden, wenn Blink oder Puls aktiv ist.
    */
   void update() {
+    if (timers != NULL) {
+      return;
+    }
+    
     if (blinkEnabled) {
       unsigned long currentTime = millis();
       
       if (currentTime - lastBlinkTime >= blinkInterval) {
         lastBlinkTime = currentTime;
-        blinkState = !blinkState;
-        updateLeds();
+        blinkStep();
       }
     }
     
     if (pulseEnabled) {
       unsigned long currentTime = millis();
       
-      if (currentTime - lastPulseTime >= 10) { // Alle 10ms aktualisieren
+      if (currentTime - lastPulseTime >= LED_PULSE_STEP_MS) {
         lastPulseTime = currentTime;
-        
-        // Pulsrichtung ändern, wenn Grenzen erreicht
-        if (pulseValue >= 255) {
-          pulseDirection = -1;
-        } else if (pulseValue <= 0) {
-          pulseDirection = 1;
-        }
-        
-        // Pulswert aktualisieren
-        pulseValue += pulseDirection * 5;
-        
-        // Auf gültigen Bereich begrenzen
-        if (pulseValue > 255) pulseValue = 255;
-        if (pulseValue < 0) pulseValue = 0;
-        
-        updateLeds();
+        pulseStep();
       }
     }
   }
@@ -1,6 +1,5 @@
 #include <Arduino.h>
 #include <lvgl.h>
-#include <TFT_eSPI.h>
 #include <ESP32Time.h>
 
 // Kommunikationsbibliotheken
@@ -9,23 +8,126 @@
 #include <ArduinoJson.h>
 #include <WebServer.h>
 #include <ESPmDNS.h>
+#include <esp_timer.h>
 
 // Eigene Module
 #include "wifi_manager.h"
 #include "mqtt_communication.h"
 #include "rest_api.h"
 #include "display.h"
+#include "system_state.h"
+#include "ui_screens.h"
+#include "refresh_scheduler.h"
+#include "display_metrics.h"
+#include "rgb565_swap.h"
+#include "touch_input.h"
+#include "spi_bus_arbiter.h"
+#include "app_tasks.h"
+#include "timer_wheel.h"
+#include "program_supervisor.h"
+#include "progress_journal.h"
+#include "boot_profiler.h"
+#include "leds.h"
+
+// Display-Backend: 0 = SPI-Display über TFT_eSPI, 1 = RGB-Parallel-Panel über ESP-IDF
+#ifndef DISPLAY_RGB_PANEL
+#define DISPLAY_RGB_PANEL 0
+#endif
+
+#if DISPLAY_RGB_PANEL
+#include "rgb_panel.h"
+#include "gt911_touch.h"
+#else
+#include <TFT_eSPI.h>
+#endif
 
 // LVGL Puffergrößen
 #define SCREEN_WIDTH  800
 #define SCREEN_HEIGHT 480
 
-// GPIO Pins für externe Komponenten
+// Höhe der beiden LVGL-Zeichenpuffer in Zeilen (per Build-Flag wählbar)
+#ifndef LVGL_BUFFER_LINES
+#define LVGL_BUFFER_LINES 10
+#endif
+#define LVGL_BUFFER_SIZE (SCREEN_WIDTH * LVGL_BUFFER_LINES)
+
+// 1: Asynchroner DMA-Flush, LVGL rendert während der Übertragung weiter
+// 0: Synchroner Flush mit pushColors
+// Das RGB-Panel liest die Framebuffer selbst per DMA, dort entfällt der SPI-Flush.
+// Der ILI9488 erwartet am SPI 18 Bit je Pixel (RGB666): jeder Block wird vor dem
+// DMA-Transfer in einen eigenen Puffer umgewandelt (siehe flushStartChunk()).
+#if !defined(LVGL_FLUSH_DMA) || DISPLAY_RGB_PANEL
+#undef LVGL_FLUSH_DMA
+#define LVGL_FLUSH_DMA 0
+#endif
+
+// Bytes je Pixel auf dem Bus zum Display (Display-Messwerte)
+#if !DISPLAY_RGB_PANEL && defined(ILI9488_DRIVER)
+#define DISPLAY_BUS_BYTES_PER_PIXEL 3
+#else
+#define DISPLAY_BUS_BYTES_PER_PIXEL sizeof(lv_color_t)
+#endif
+
+// 1: Touch per Interrupt an der PENIRQ-Leitung (TOUCH_IRQ), Abfrage nur bei Berührung
+// 0: Touch-Controller in jedem LVGL-Lesezyklus abfragen
+#if defined(TOUCH_IRQ) && !DISPLAY_RGB_PANEL
+#define TOUCH_IRQ_MODE 1
+#else
+#define TOUCH_IRQ_MODE 0
+#endif
+
+// Höhe eines Display-Blocks in Zeilen, wenn eine Touch-Abfrage auf den SPI-Bus wartet
+// (nur im Interrupt-Modus); sonst geht jeder Flush in einem Stück auf den Bus
+#ifndef SPI_FLUSH_CHUNK_LINES
+#define SPI_FLUSH_CHUNK_LINES 5
+#endif
+
+// GPIO Pins für externe Komponenten (per Build-Flag umlegbar, siehe env:esp32-s3-rgb)
+#ifndef RED_PIN
 #define RED_PIN    45
+#endif
+#ifndef GREEN_PIN
 #define GREEN_PIN  46
+#endif
+#ifndef BLUE_PIN
 #define BLUE_PIN   47
+#endif
+#ifndef MOTOR_PIN
 #define MOTOR_PIN  48
+#endif
+#ifndef SENSOR_PIN
 #define SENSOR_PIN 49
+#endif
+
+#if DISPLAY_RGB_PANEL
+// LED- und Motor-Ausgänge auf Panel-Leitungen würden das Bild stören bzw. den Motor schalten
+static_assert(!rgbPanelUsesPin(RED_PIN) && !rgbPanelUsesPin(GREEN_PIN) && !rgbPanelUsesPin(BLUE_PIN) &&
+              !rgbPanelUsesPin(MOTOR_PIN) && !rgbPanelUsesPin(SENSOR_PIN),
+              "LED-, Motor- oder Sensor-Pin liegt auf einer Leitung des RGB-Panels: Pins umlegen");
+#endif
+
+// Intervall der Tanküberwachung in ms
+#define CONTROL_TANK_CHECK_MS 1000
+
+// Maximale Wartezeit von MQTT und REST auf das Ergebnis eines Befehls in ms
+#define COMMAND_WAIT_MS 200
+
+// Maximale Wartezeit des Netzwerk-Tasks auf Aufträge, danach werden MQTT und REST abgefragt
+#define NET_POLL_MS 10
+
+// Intervall der Telemetrie in ms
+#define TELEMETRY_INTERVAL_MS 60000
+
+// Schnellstart: Netzwerk und nicht benötigte UI-Arbeit erst nach dem ersten Frame beginnen
+#ifndef FAST_BOOT
+#define FAST_BOOT 0
+#endif
+
+// Längste Wartezeit des Netzwerks auf den ersten Frame im Schnellstart in ms
+#define BOOT_NET_DEFER_MAX_MS 3000
+
+// Verzögerung des Startberichts (Serial, MQTT) nach dem Start des Netzwerk-Tasks in ms
+#define BOOT_REPORT_DELAY_MS 10000
 
 // Programmdefinitionen (in Sekunden für einfacheres Testen)
 // In der Produktionsversion auf Tage umstellen
@@ -33,40 +135,6 @@
 #define PROGRAM_2_DURATION (14 * 24 * 60 * 60) // 14 Tage
 #define PROGRAM_3_DURATION (21 * 24 * 60 * 60) // 21 Tage
 
-// LVGL-Sprites und Widgets
-static lv_obj_t *mainScreen;
-static lv_obj_t *programScreen;
-static lv_obj_t *settingsScreen;
-static lv_obj_t *runningScreen;
-static lv_obj_t *completedScreen;
-static lv_obj_t *errorScreen;
-
-// Anzeigen für den aktuellen Programm-Status
-static lv_obj_t *programLabel;
-static lv_obj_t *timeLabel;
-static lv_obj_t *progressBar;
-static lv_obj_t *statusLabel;
-
-// Globale Variablen für Programmsteuerung
-enum ProgramState {
-  IDLE,
-  RUNNING,
-  COMPLETED,
-  ERROR
-};
-
-struct SystemState {
-  ProgramState state;
-  int activeProgram;      // 1, 2, 3, oder 4 (individuell)
-  uint32_t programDuration;  // Programmdauer in Sekunden
-  uint32_t startTime;     // Zeitpunkt des Programmstarts
-  uint32_t customDays;    // Für individuelles Programm
-  bool tankLevelOk;       // Tankfüllstand OK?
-  bool motorActive;       // Motor läuft?
-  bool remoteControlEnabled; // Fernsteuerung aktiviert?
-  String deviceId;        // Eindeutige Geräte-ID
-};
-
 SystemState systemState;
 ESP32Time rtc;
 
@@ -76,32 +144,71 @@ MQTTCommunication mqttClient;
 RESTAPI restApi;
 
 // Display-Treiber und LVGL-Puffer
+#if DISPLAY_RGB_PANEL
+// Framebuffer liegen im PSRAM und werden vom Panel-Treiber angelegt
+RgbPanel rgbPanel;
+Gt911Touch gt911;
+#else
 TFT_eSPI tft = TFT_eSPI();
 static lv_disp_draw_buf_t drawBuffer;
-static lv_color_t buf1[SCREEN_WIDTH * 10];
-static lv_color_t buf2[SCREEN_WIDTH * 10];
+static lv_color_t buf1[LVGL_BUFFER_SIZE];
+static lv_color_t buf2[LVGL_BUFFER_SIZE];
+#endif
 static lv_disp_drv_t dispDriver;
 static lv_indev_drv_t indevDriver;
 
-// Timer für LVGL und Programmabfragen
-hw_timer_t *lvglTimer = NULL;
-hw_timer_t *programTimer = NULL;
+// Adaptive Refresh-Rate für LVGL
+RefreshScheduler refreshScheduler;
+
+// Messwerte der Display-Pipeline (REST: /api/display/metrics)
+DisplayMetrics displayMetrics;
+
+#if !DISPLAY_RGB_PANEL
+// Gemeinsamer SPI-Bus von Display und Touch-Controller
+SpiBusArbiter spiArbiter;
+#endif
+
+#if TOUCH_IRQ_MODE
+// Interrupt-gesteuerte Touch-Eingabe
+TouchInput touchInput;
+#endif
+
+// Periodische Aufträge, je Task ein Timer-Rad (REST: /api/timers)
+TimerWheel controlTimers("control");
+TimerWheel uiTimers("ui");
+TimerWheel netTimers("net");
+
+// Status-LED; Blinken und Pulsen taktet das Timer-Rad des Steuerungs-Tasks
+LedManager statusLed(RED_PIN, GREEN_PIN, BLUE_PIN);
+
+// Abstand der LVGL-Ticks in ms (nur ohne LV_TICK_CUSTOM)
+#define LVGL_TICK_MS 5
+
+#if !LV_TICK_CUSTOM
+// Timer für LVGL-Ticks (das Programmende überwacht programSupervisor)
+static esp_timer_handle_t lvglTickTimer = NULL;
+#endif
 
 // Funktionsprototypen
-void createMainScreen();
-void createProgramScreen();
-void createSettingsScreen();
-void createRunningScreen();
-void createCompletedScreen();
-void createErrorScreen();
-void updateRunningScreen();
-void startProgram(int programIndex);
-void stopProgram();
-String formatTime(uint32_t seconds);
-uint32_t getRemainingTime();
-int getProgressPercent();
+void setupRestApi();
 void setLedStatus(ProgramState state);
 void checkTankLevel();
+CommandResult controlStartProgram(int programIndex);
+CommandResult controlStopProgram();
+CommandResult controlProgramDeadline(uint32_t generation);
+uint32_t getRemainingTime();
+uint32_t getElapsedTime();
+bool resumeFromJournal();
+void controlTask(void *param);
+void uiTask(void *param);
+void netTask(void *param);
+void sendTelemetry();
+void bootProfileToJson(const BootProfile &profile, JsonObject obj);
+void reportStyles();
+void sendBootReport(void *arg);
+
+// Vom Oberflächen-Task nach dem ersten Frame gesetzt (Schnellstart: Freigabe für das Netzwerk)
+static volatile bool firstFrameDone = false;
 
 // MQTT-Callback-Funktion für Fernsteuerungsbefehle
 void onMqttCommand(const String &command, const JsonObject &payload) {
@@ -111,34 +218,46 @@ void onMqttCommand(const String &command, const JsonObject &payload) {
   if (command == "start_program") {
     if (payload.containsKey("program")) {
       int programIndex = payload["program"].as<int>();
-      startProgram(programIndex);
+      CommandResult result = commandQueue.submitAndWait(CONTROL_START_PROGRAM, programIndex, COMMAND_SOURCE_MQTT, COMMAND_WAIT_MS);
       
-      // Bestätigung senden
-      DynamicJsonDocument response(128);
-      response["success"] = true;
+      // Ergebnis der Steuerung zurückmelden
+      StaticJsonDocument<128> response;
+      response["success"] = result == COMMAND_OK;
+      response["result"] = CommandQueue::resultName(result);
+      response["command"] = command.c_str();
       response["program"] = programIndex;
-      mqttClient.publishStatus("program_started");
+      mqttClient.publishDetailedStatus("command_result", response.as<JsonObject>());
     }
   }
   else if (command == "stop_program") {
-    stopProgram();
+    CommandResult result = commandQueue.submitAndWait(CONTROL_STOP_PROGRAM, 0, COMMAND_SOURCE_MQTT, COMMAND_WAIT_MS);
     
-    // Bestätigung senden
-    DynamicJsonDocument response(128);
-    response["success"] = true;
-    mqttClient.publishStatus("program_stopped");
+    // Ergebnis der Steuerung zurückmelden
+    StaticJsonDocument<128> response;
+    response["success"] = result == COMMAND_OK;
+    response["result"] = CommandQueue::resultName(result);
+    response["command"] = command.c_str();
+    mqttClient.publishDetailedStatus("command_result", response.as<JsonObject>());
   }
   else if (command == "get_status") {
     // Detaillierten Status senden
-    DynamicJsonDocument statusDoc(256);
-    statusDoc["state"] = (int)systemState.state;
-    statusDoc["program"] = systemState.activeProgram;
-    statusDoc["remaining_time"] = getRemainingTime();
-    statusDoc["progress"] = getProgressPercent();
-    statusDoc["tank_level_ok"] = systemState.tankLevelOk;
+    SystemStateSnapshot snap = getSystemSnapshot();
+    StaticJsonDocument<256> statusDoc;
+    statusDoc["state"] = (int)snap.state;
+    statusDoc["program"] = snap.activeProgram;
+    statusDoc["remaining_time"] = snap.remainingTime();
+    statusDoc["progress"] = snap.progressPercent();
+    statusDoc["tank_level_ok"] = (bool)snap.tankLevelOk;
+    statusDoc["version"] = snap.version;
     
     mqttClient.publishDetailedStatus("status_update", statusDoc.as<JsonObject>());
   }
+  else if (command == "get_boot_profile") {
+    // Phasen des laufenden Starts senden
+    StaticJsonDocument<1024> profileDoc;
+    bootProfileToJson(*bootProfiler.get(0), profileDoc.to<JsonObject>());
+    mqttClient.publishDetailedStatus("boot_profile", profileDoc.as<JsonObject>());
+  }
 }
 
 // Initialisiert die WiFi-Verbindung
@@ -146,7 +265,7 @@ void initWiFi() {
   Serial.println("Initialisiere WiFi-Verbindung...");
   
   // Geräte-ID aus MAC-Adresse erstellen
-  systemState.deviceId = "desinfektion_" + String((uint32_t)(ESP.getEfuseMac() >> 32), HEX);
+  systemState.deviceId = "desinfektion_" + String((uint32_t)(ESP.getEfuseMac() >> 32), HEX); // UI-Text
   Serial.print("Geräte-ID: ");
   Serial.println(systemState.deviceId);
   
@@ -156,16 +275,45 @@ void initWiFi() {
       Serial.println("WiFi verbunden!");
       
       // MQTT starten, wenn WiFi verbunden ist
+      uint32_t start = BootProfiler::now();
       mqttClient.begin();
       
-      // REST API starten
-      setupRestApi();
+      // REST API einmal starten, der Server überdauert Wiederverbindungen
+      static bool restStarted = false;
+      if (!restStarted) {
+        // Beim ersten Verbinden im Startprofil eintragen (Phasen der Verbindung: /api/wifi)
+        bootProfiler.milestone("wifi_up");
+        bootProfiler.record("mqtt_begin", start);
+        start = BootProfiler::now();
+        setupRestApi();
+        bootProfiler.record("rest", start);
+        restStarted = true;
+      }
     } else {
       Serial.println("WiFi-Verbindung verloren!");
     }
   });
   
-  wifiManager.begin();
+  // Verbunden wird erst im Netzwerk-Task (wifiManager.begin()), setup() wartet nie auf das Netz
+}
+
+// Setzt die WLAN-Konfiguration zurück (aus dem Einstellungsbildschirm, erledigt der Netzwerk-Task)
+void resetWiFiConfig() {
+  appTasks.postNet(NET_EVENT_RESET_WIFI);
+}
+
+// HTTP-Status zum Ergebnis eines Befehls
+int commandHttpStatus(CommandResult result) {
+  switch (result) {
+    case COMMAND_OK:
+      return 200;
+    case COMMAND_INVALID:
+      return 400;
+    case COMMAND_QUEUE_FULL:
+      return 503;
+    default:
+      return 504; // Steuerung hat nicht rechtzeitig geantwortet
+  }
 }
 
 // Initialisiert die REST API
@@ -176,13 +324,15 @@ void setupRestApi() {
   
   // Status-Endpunkt
   restApi.registerEndpoint("/api/status", "GET", [](WebServer &server, JsonDocument &doc) {
+    SystemStateSnapshot snap = getSystemSnapshot();
     DynamicJsonDocument response(256);
-    response["state"] = (int)systemState.state;
-    response["program"] = systemState.activeProgram;
-    response["remaining_time"] = getRemainingTime();
-    response["progress"] = getProgressPercent();
-    response["tank_level_ok"] = systemState.tankLevelOk;
+    response["state"] = (int)snap.state;
+    response["program"] = snap.activeProgram;
+    response["remaining_time"] = snap.remainingTime();
+    response["progress"] = snap.progressPercent();
+    response["tank_level_ok"] = (bool)snap.tankLevelOk;
     response["device_id"] = systemState.deviceId;
+    response["version"] = snap.version;
     
     String responseStr;
     serializeJson(response, responseStr);
@@ -195,15 +345,16 @@ void setupRestApi() {
       int programIndex = doc["program"].as<int>();
       
       if (programIndex >= 1 && programIndex <= 4) {
-        startProgram(programIndex);
+        CommandResult result = commandQueue.submitAndWait(CONTROL_START_PROGRAM, programIndex, COMMAND_SOURCE_REST, COMMAND_WAIT_MS);
         
         DynamicJsonDocument response(128);
-        response["success"] = true;
+        response["success"] = result == COMMAND_OK;
+        response["result"] = CommandQueue::resultName(result);
         response["program"] = programIndex;
         
         String responseStr;
         serializeJson(response, responseStr);
-        server.send(200, "application/json", responseStr);
+        server.send(commandHttpStatus(result), "application/json", responseStr);
       } else {
         server.send(400, "application/json", "{\"error\":\"Ungültiger Programmindex\"}");
       }
@@ -214,14 +365,15 @@ void setupRestApi() {
   
   // Programm-Stop-Endpunkt
   restApi.registerEndpoint("/api/program/stop", "POST", [](WebServer &server, JsonDocument &doc) {
-    stopProgram();
+    CommandResult result = commandQueue.submitAndWait(CONTROL_STOP_PROGRAM, 0, COMMAND_SOURCE_REST, COMMAND_WAIT_MS);
     
     DynamicJsonDocument response(128);
-    response["success"] = true;
+    response["success"] = result == COMMAND_OK;
+    response["result"] = CommandQueue::resultName(result);
     
     String responseStr;
     serializeJson(response, responseStr);
-    server.send(200, "application/json", responseStr);
+    server.send(commandHttpStatus(result), "application/json", responseStr);
   });
   
   // Individuelle-Programmdauer-Endpunkt
@@ -230,15 +382,16 @@ void setupRestApi() {
       int days = doc["days"].as<int>();
       
       if (days >= 1 && days <= 99) {
-        systemState.customDays = days;
+        CommandResult result = commandQueue.submitAndWait(CONTROL_SET_CUSTOM_DAYS, days, COMMAND_SOURCE_REST, COMMAND_WAIT_MS);
         
         DynamicJsonDocument response(128);
-        response["success"] = true;
+        response["success"] = result == COMMAND_OK;
+        response["result"] = CommandQueue::resultName(result);
         response["days"] = days;
         
         String responseStr;
         serializeJson(response, responseStr);
-        server.send(200, "application/json", responseStr);
+        server.send(commandHttpStatus(result), "application/json", responseStr);
       } else {
         server.send(400, "application/json", "{\"error\":\"Ungültige Anzahl an Tagen\"}");
       }
@@ -247,73 +400,566 @@ void setupRestApi() {
     }
   });
   
+  // Tasks: CPU-Last, Stack und Warteschlangen
+  restApi.registerEndpoint("/api/tasks", "GET", [](WebServer &server, JsonDocument &doc) {
+    DynamicJsonDocument response(1024);
+    const int cores[APP_TASK_COUNT] = {APP_CONTROL_CORE, APP_UI_CORE, APP_NET_CORE};
+    JsonArray tasks = response.createNestedArray("tasks");
+    for (int id = 0; id < APP_TASK_COUNT; id++) {
+      int slot = appTasks.getMonitorSlot((AppTaskId)id);
+      if (slot < 0) {
+        continue;
+      }
+      const TaskMonitor::Stats &stats = taskMonitor.get(slot);
+      JsonObject entry = tasks.createNestedObject();
+      entry["name"] = stats.name;
+      entry["core"] = cores[id];
+      entry["priority"] = stats.handle != NULL ? uxTaskPriorityGet(stats.handle) : 0;
+      entry["load_pct"] = stats.loadPermille / 10.0;
+      entry["busy_ms"] = (uint32_t)(stats.busyUs / 1000);
+      entry["loops"] = stats.loops;
+      entry["max_loop_us"] = stats.maxBusyUs;
+      entry["stack_free"] = stats.stackFree;
+      entry["queued"] = appTasks.getQueued((AppTaskId)id);
+      entry["dropped"] = appTasks.getDropped((AppTaskId)id);
+    }
+
+    // Befehlswarteschlange der Steuerung
+    const CommandQueueStats &commands = commandQueue.getStats();
+    JsonObject cmd = response.createNestedObject("commands");
+    cmd["touch"] = commands.submitted[COMMAND_SOURCE_TOUCH];
+    cmd["mqtt"] = commands.submitted[COMMAND_SOURCE_MQTT];
+    cmd["rest"] = commands.submitted[COMMAND_SOURCE_REST];
+    cmd["timer"] = commands.submitted[COMMAND_SOURCE_TIMER];
+    cmd["completed"] = commands.completed;
+    cmd["rejected"] = commands.rejected;
+    cmd["full"] = commands.full;
+    cmd["timeouts"] = commands.timeouts;
+    cmd["latency_us"] = commands.latencyUs;
+    cmd["max_latency_us"] = commands.maxLatencyUs;
+
+    // Veröffentlichter Programmzustand (Seqlock)
+    JsonObject state = response.createNestedObject("state");
+    state["version"] = systemStateSeqlock.version();
+    state["read_retries"] = systemStateSeqlock.getRetries();
+
+    String responseStr;
+    serializeJson(response, responseStr);
+    server.send(200, "application/json", responseStr);
+  });
+
+  // Startprofile: laufender Start und die vorherigen aus dem RTC-Speicher
+  restApi.registerEndpoint("/api/boot", "GET", [](WebServer &server, JsonDocument &doc) {
+    DynamicJsonDocument response(4096);
+    JsonArray profiles = response.createNestedArray("profiles");
+    for (uint8_t age = 0; age < BOOT_PROFILE_HISTORY; age++) {
+      const BootProfile *profile = bootProfiler.get(age);
+      if (profile == NULL) {
+        break;
+      }
+      bootProfileToJson(*profile, profiles.createNestedObject());
+    }
+
+    String responseStr;
+    serializeJson(response, responseStr);
+    server.send(200, "application/json", responseStr);
+  });
+
+  // WLAN: Zustand und Dauer der Phasen des letzten Verbindungsaufbaus
+  restApi.registerEndpoint("/api/wifi", "GET", [](WebServer &server, JsonDocument &doc) {
+    DynamicJsonDocument response(384);
+    const WiFiConnectTimings &timings = wifiManager.getTimings();
+    response["state"] = WiFiManager::stateName(wifiManager.getState());
+    response["ap_active"] = wifiManager.isInConfigMode();
+    response["ip"] = wifiManager.getIP().toString();
+    response["rssi"] = WiFi.RSSI();
+    response["association_ms"] = timings.associationMs;
+    response["dhcp_ms"] = timings.dhcpMs;
+    response["mdns_ms"] = timings.mdnsMs;
+    response["total_ms"] = timings.totalMs;
+    response["attempts"] = timings.attempts;
+    response["failures"] = timings.failures;
+    response["last_reason"] = timings.lastReason;
+
+    String responseStr;
+    serializeJson(response, responseStr);
+    server.send(200, "application/json", responseStr);
+  });
+
+  // MQTT: gesendete Nachrichten, Größe und Dauer aus dem Sendepuffer
+  restApi.registerEndpoint("/api/mqtt", "GET", [](WebServer &server, JsonDocument &doc) {
+    DynamicJsonDocument response(384);
+    const MqttPublishStats &stats = mqttClient.getPublishStats();
+    response["connected"] = mqttClient.isConnected();
+    response["published"] = stats.published;
+    response["failed"] = stats.failed;
+    response["oversize"] = stats.oversize;
+    response["bytes"] = stats.bytes;
+    response["max_bytes"] = stats.maxBytes;
+    response["buffer_bytes"] = MQTT_PUBLISH_BUFFER_SIZE;
+    response["avg_us"] = stats.published > 0 ? stats.totalUs / stats.published : 0;
+    response["max_us"] = stats.maxUs;
+    response["free_heap"] = ESP.getFreeHeap();
+    response["min_free_heap"] = ESP.getMinFreeHeap();
+
+    String responseStr;
+    serializeJson(response, responseStr);
+    server.send(200, "application/json", responseStr);
+  });
+
+  // Fortschrittsjournal: letzte Einträge und Schreibstatistik
+  restApi.registerEndpoint("/api/journal", "GET", [](WebServer &server, JsonDocument &doc) {
+    DynamicJsonDocument response(1536);
+    const JournalStats &stats = progressJournal.getStats();
+    response["appended"] = stats.appended;
+    response["written"] = stats.written;
+    response["coalesced"] = stats.coalesced;
+    response["errors"] = stats.errors;
+    response["flash_bytes"] = stats.flashBytes;
+    response["write_amplification"] = progressJournal.getWriteAmplification();
+    response["max_write_us"] = stats.maxWriteUs;
+    uint32_t used, total;
+    if (ProgressJournal::getNvsUsage(used, total)) {
+      response["nvs_used_entries"] = used;
+      response["nvs_total_entries"] = total;
+    }
+
+    JsonArray records = response.createNestedArray("records");
+    for (uint32_t age = 0; age < JOURNAL_SLOTS; age++) {
+      const JournalRecord *record = progressJournal.get(age);
+      if (record == NULL) {
+        break;
+      }
+      JsonObject entry = records.createNestedObject();
+      entry["seq"] = record->seq;
+      entry["type"] = ProgressJournal::typeName(record->type);
+      entry["program"] = record->program;
+      entry["elapsed"] = record->elapsed;
+      entry["duration"] = record->duration;
+    }
+
+    String responseStr;
+    serializeJson(response, responseStr);
+    server.send(200, "application/json", responseStr);
+  });
+
+  // Timer-Räder: Verspätung und ausgefallene Ausführungen je Auftrag
+  restApi.registerEndpoint("/api/timers", "GET", [](WebServer &server, JsonDocument &doc) {
+    DynamicJsonDocument response(2048);
+    TimerWheel *wheels[] = {&controlTimers, &uiTimers, &netTimers};
+    for (TimerWheel *wheel : wheels) {
+      JsonArray jobs = response.createNestedArray(wheel->getName());
+      for (int i = 0; i < TIMER_WHEEL_JOBS; i++) {
+        const TimerJobStats *stats = wheel->getStats(i);
+        if (stats == NULL) {
+          continue;
+        }
+        JsonObject job = jobs.createNestedObject();
+        job["name"] = stats->name;
+        job["period_ms"] = stats->periodMs;
+        job["runs"] = stats->runs;
+        job["jitter_ms"] = stats->lastJitterMs;
+        job["avg_jitter_ms"] = stats->runs > 0 ? stats->jitterSumMs / stats->runs : 0;
+        job["max_jitter_ms"] = stats->maxJitterMs;
+        job["overruns"] = stats->overruns;
+        job["max_run_us"] = stats->maxRunUs;
+      }
+    }
+
+    // Frist des laufenden Programms (einmaliger esp_timer statt Rad-Auftrag)
+    JsonObject program = response.createNestedObject("program_deadline");
+    program["remaining_ms"] = programSupervisor.getRemainingMs();
+    program["armed"] = programSupervisor.getArmCount();
+    program["expired"] = programSupervisor.getExpiries();
+
+    String responseStr;
+    serializeJson(response, responseStr);
+    server.send(200, "application/json", responseStr);
+  });
+
+  // Display-Messwerte: Histogramme über die letzten Refreshs
+  restApi.registerEndpoint("/api/display/metrics", "GET", [](WebServer &server, JsonDocument &doc) {
+    // Läuft im Netzwerk-Task: Kopie statt des Ringpuffers, den der UI-Task beschreibt
+    // (statisch, damit der Ringpuffer nicht auf dem Stack liegt)
+    static DisplayMetrics::Stats stats;
+    displayMetrics.read(stats);
+
+    DynamicJsonDocument response(2048);
+    response["refreshes"] = stats.refreshes;
+    response["samples"] = stats.count;
+    response["pixels_per_s"] = stats.getPixelsPerSecond();
+    response["overlay"] = displayMetrics.isOverlayVisible();
+    response["bus_bytes_per_px"] = displayMetrics.getBusBytesPerPixel();
+
+    DisplayMetrics::Sample last = stats.last();
+    response["heap_used"] = last.heapUsed;
+
+    const struct {
+      const char *name;
+      uint32_t DisplayMetrics::Sample::*field;
+      uint32_t base;
+    } series[] = {
+      {"render_us", &DisplayMetrics::Sample::renderUs, DISPLAY_METRICS_TIME_BASE_US},
+      {"flush_us", &DisplayMetrics::Sample::flushUs, DISPLAY_METRICS_TIME_BASE_US},
+      {"area_px", &DisplayMetrics::Sample::areaPx, DISPLAY_METRICS_AREA_BASE_PX},
+      {"bytes", &DisplayMetrics::Sample::bytes, DISPLAY_METRICS_AREA_BASE_PX * displayMetrics.getBusBytesPerPixel()},
+      {"heap_used", &DisplayMetrics::Sample::heapUsed, 4096},
+    };
+
+    JsonObject histograms = response.createNestedObject("histograms");
+    for (const auto &s : series) {
+      uint32_t avg, max;
+      stats.summary(s.field, avg, max);
+      DisplayMetrics::Histogram h = stats.histogram(s.field, s.base);
+
+      JsonObject entry = histograms.createNestedObject(s.name);
+      entry["avg"] = avg;
+      entry["max"] = max;
+      entry["base"] = h.base; // Obere Grenze der ersten Klasse, danach jeweils verdoppelt
+      JsonArray counts = entry.createNestedArray("counts");
+      for (int i = 0; i < DISPLAY_METRICS_BUCKETS; i++) {
+        counts.add(h.counts[i]);
+      }
+    }
+
+    // Vorgerenderte Button- und Menü-Dekorationen
+    const UiDecorCache::Stats &decor = uiDecorCache.getStats();
+    JsonObject decorEntry = response.createNestedObject("decor");
+    decorEntry["renders"] = decor.renders;
+    decorEntry["hits"] = decor.hits;
+    decorEntry["evictions"] = decor.evictions;
+    decorEntry["failures"] = decor.failures;
+    decorEntry["bytes"] = decor.bytes;
+
+    // Bilder aus dem Flash: Auspackzeit und Trefferquote des Bildcaches
+    JsonObject images = response.createNestedObject("images");
+    images["lookups"] = uiImageStats.lookups;
+    images["decodes"] = uiImageStats.decodes;
+    images["decode_us"] = uiImageStats.decodeUs;
+    images["max_decode_us"] = uiImageStats.maxDecodeUs;
+    images["hit_rate"] = uiImageHitRate();
+    images["failures"] = uiImageStats.failures;
+    images["bytes"] = uiImageStats.bytes;
+
+#if DISPLAY_RGB_PANEL
+    // RGB-Panel: Umschaltungen und zwischen den Framebuffern kopierte Pixel
+    JsonObject panel = response.createNestedObject("panel");
+    panel["presents"] = rgbPanel.getSync().getPresentCount();
+    panel["synced_px"] = rgbPanel.getSync().getSyncedPixels();
+    panel["vsync_timeouts"] = rgbPanel.getVsyncTimeouts();
+#else
+    // SPI-Bus: Belegung und Wartezeit je Client
+    const char *clientNames[SPI_CLIENT_COUNT] = {"display", "touch"};
+    JsonObject spi = response.createNestedObject("spi");
+    for (int c = 0; c < SPI_CLIENT_COUNT; c++) {
+      const SpiBusArbiter::ClientStats &stats = spiArbiter.getStats((SpiClient)c);
+      JsonObject entry = spi.createNestedObject(clientNames[c]);
+      entry["busy_permille"] = spiArbiter.getOccupancyPermille((SpiClient)c);
+      entry["transactions"] = stats.transactions;
+      entry["wait_avg_us"] = stats.transactions > 0 ? (uint32_t)(stats.waitUs / stats.transactions) : 0;
+      entry["wait_max_us"] = stats.maxWaitUs;
+    }
+#endif
+
+    String responseStr;
+    serializeJson(response, responseStr);
+    server.send(200, "application/json", responseStr);
+  });
+
+  // Overlay mit Display-Messwerten ein- und ausblenden (LVGL-Objekte legt die Oberfläche an)
+  restApi.registerEndpoint("/api/display/overlay", "POST", [](WebServer &server, JsonDocument &doc) {
+    if (doc.containsKey("visible")) {
+      bool visible = doc["visible"].as<bool>();
+      bool queued = appTasks.postUi(UI_EVENT_SET_OVERLAY, visible);
+
+      DynamicJsonDocument response(128);
+      response["success"] = queued;
+      response["visible"] = visible;
+
+      String responseStr;
+      serializeJson(response, responseStr);
+      server.send(200, "application/json", responseStr);
+    } else {
+      server.send(400, "application/json", "{\"error\":\"Parameter visible fehlt\"}");
+    }
+  });
+  
   // API starten
   restApi.begin();
 }
 
-// LVGL Display- und Flush-Funktionen
+#if DISPLAY_RGB_PANEL
+// Flush im Direct Mode: Umschalten und Synchronisieren übernimmt RgbFramebufferSync
 void lvglFlushCb(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
-  uint32_t w = (area->x2 - area->x1 + 1);
-  uint32_t h = (area->y2 - area->y1 + 1);
+  displayMetrics.flushStart();
+  RgbFramebufferSync::flushCb(disp, area, color_p);
+  displayMetrics.flushEnd(lv_area_get_size(area));
+}
+
+// Touchscreen-Lesefunktion für LVGL (GT911 über I2C, eigener Bus)
+void touchpadReadCb(lv_indev_drv_t *indev_driver, lv_indev_data_t *data) {
+  uint16_t touchX = 0, touchY = 0;
+  bool touched = gt911.read(&touchX, &touchY);
+
+  // Touch holt das Display aus dem Leerlauf
+  if (touched) {
+    refreshScheduler.notifyActivity();
+  }
+
+  data->state = touched ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+  data->point.x = touchX;
+  data->point.y = touchY;
+}
+#else
+// Laufender Flush, wird blockweise übertragen (siehe SPI_FLUSH_CHUNK_LINES)
+struct FlushJob {
+  lv_disp_drv_t *disp;   // NULL = kein Flush aktiv
+  lv_area_t area;
+  uint16_t *pixels;
+  lv_coord_t nextY;      // Erste noch nicht übertragene Zeile
+  uint16_t chunkLines;   // Zeilen des laufenden Blocks
+  uint32_t requestedAt;  // Seit wann der nächste Block auf den Bus wartet (micros)
+};
+static FlushJob flushJob = {NULL};
+
+#if LVGL_FLUSH_DMA
+// Ein Block wird gerade per DMA übertragen
+static volatile bool dmaChunkPending = false;
+#ifdef ILI9488_DRIVER
+// Block in RGB666 für den DMA-Transfer (interner RAM), +1 Byte zum Auffüllen auf 16 Bit
+static DMA_ATTR uint8_t rgb666Chunk[LVGL_BUFFER_SIZE * 3 + 1];
+#endif
+#endif
+
+#if TOUCH_IRQ_MODE
+void touchSubmitIfNeeded();
+#endif
+
+// Gibt zurück, ob der SPI-Bus gerade belegt ist
+bool displayBusBusy() {
+  return spiArbiter.isBusy();
+}
+
+// Zeilen des nächsten Blocks: geteilt wird nur, wenn eine Touch-Abfrage ansteht.
+// Beim zyklischen Abfragen liest LVGL den Touch im selben Task wie der Flush,
+// zwischen zwei Blöcken käme dort nichts zum Zug.
+uint16_t flushChunkLines(uint32_t remaining) {
+#if TOUCH_IRQ_MODE
+  if (touchInput.needsSample() && remaining > SPI_FLUSH_CHUNK_LINES) {
+    return SPI_FLUSH_CHUNK_LINES;
+  }
+#endif
+  return remaining;
+}
+
+// Belegt den Bus und startet die Übertragung des nächsten Blocks
+void flushStartChunk() {
+  uint32_t w = lv_area_get_width(&flushJob.area);
+  uint32_t remaining = flushJob.area.y2 - flushJob.nextY + 1;
+  uint16_t lines = flushChunkLines(remaining);
+  uint16_t *chunk = flushJob.pixels + (flushJob.nextY - flushJob.area.y1) * w;
 
+  spiArbiter.acquire(SPI_CLIENT_DISPLAY, flushJob.requestedAt);
+  flushJob.chunkLines = lines;
   tft.startWrite();
-  tft.setAddrWindow(area->x1, area->y1, w, h);
-  tft.pushColors((uint16_t *)&color_p->full, w * h, true);
+#if LVGL_FLUSH_DMA && defined(ILI9488_DRIVER)
+  // pushPixelsDMA zählt 16-Bit-Worte; ein überzähliges Füllbyte verwirft der
+  // Controller mit dem Ende der Transaktion als unvollständiges Pixel
+  rgb565ToRgb666(chunk, rgb666Chunk, w * lines);
+  tft.setAddrWindow(flushJob.area.x1, flushJob.nextY, w, lines);
+  tft.pushPixelsDMA((uint16_t *)rgb666Chunk, (w * lines * 3 + 1) / 2);
+  dmaChunkPending = true;
+#elif LVGL_FLUSH_DMA
+  tft.pushImageDMA(flushJob.area.x1, flushJob.nextY, w, lines, chunk);
+  dmaChunkPending = true;
+#else
+  tft.setAddrWindow(flushJob.area.x1, flushJob.nextY, w, lines);
+  tft.pushColors(chunk, w * lines, false);
+#endif
+}
+
+// Gibt den Bus nach einem Block frei und lässt wartende Transaktionen (Touch) zum Zug kommen.
+// Gibt true zurück, wenn der Flush vollständig ist und der Puffer an LVGL zurückging.
+bool flushChunkDone() {
   tft.endWrite();
+  spiArbiter.release();
+  flushJob.nextY += flushJob.chunkLines;
+  flushJob.requestedAt = micros();
+
+#if TOUCH_IRQ_MODE
+  touchSubmitIfNeeded();
+#endif
+  spiArbiter.runPending();
+
+  if (flushJob.nextY <= flushJob.area.y2) {
+    return false;
+  }
 
+  lv_disp_drv_t *disp = flushJob.disp;
+  flushJob.disp = NULL;
+  displayMetrics.flushEnd(lv_area_get_size(&flushJob.area));
   lv_disp_flush_ready(disp);
+  return true;
 }
 
+#if LVGL_FLUSH_DMA
+// Prüft, ob der laufende DMA-Block abgeschlossen ist, und startet den nächsten
+void lvglDmaPoll() {
+  if (dmaChunkPending && !tft.dmaBusy()) {
+    dmaChunkPending = false;
+    if (!flushChunkDone()) {
+      flushStartChunk();
+    }
+  }
+}
+
+// Wird von LVGL aufgerufen, solange es auf einen freien Puffer wartet
+void lvglWaitCb(lv_disp_drv_t *disp) {
+  uint32_t t0 = micros();
+  lvglDmaPoll();
+  displayMetrics.addBlocked(micros() - t0);
+}
+#endif
+
+// LVGL Display- und Flush-Funktionen
+void lvglFlushCb(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
+  uint32_t t0 = micros();
+  displayMetrics.flushStart();
+
+#if !LV_COLOR_16_SWAP
+  // LVGL rendert in Host-Reihenfolge: Bytes für den SPI-Bus tauschen
+  rgb565Swap((uint16_t *)&color_p->full, lv_area_get_size(area));
+#endif
+
+  flushJob.disp = disp;
+  flushJob.area = *area;
+  flushJob.pixels = (uint16_t *)&color_p->full;
+  flushJob.nextY = area->y1;
+  flushJob.requestedAt = t0;
+
+#if LVGL_FLUSH_DMA
+  // Ersten Block per DMA senden; LVGL rendert währenddessen in den zweiten Puffer.
+  // Die weiteren Blöcke und lv_disp_flush_ready() folgen in lvglDmaPoll().
+  flushStartChunk();
+#else
+  do {
+    flushStartChunk();
+  } while (!flushChunkDone());
+#endif
+  displayMetrics.addBlocked(micros() - t0);
+}
+
+#if UI_SNAPSHOT_CACHE
+// Überträgt ein vorgerendertes Vollbild aus dem Snapshot-Cache an das Display
+void lvglBlitSnapshot(const lv_color_t *pixels, uint16_t width, uint16_t height) {
+  uint32_t t0 = micros();
+#if LVGL_FLUSH_DMA
+  // Laufenden Flush abwarten, bevor der Bus neu belegt wird
+  while (flushJob.disp != NULL) {
+    lvglDmaPoll();
+  }
+#endif
+
+  spiArbiter.acquire(SPI_CLIENT_DISPLAY, t0);
+  tft.startWrite();
+  tft.setAddrWindow(0, 0, width, height);
+  // Snapshot liegt im LVGL-Farbformat vor und bleibt unverändert im Cache
+  tft.pushColors((uint16_t *)pixels, width * height, !LV_COLOR_16_SWAP);
+  tft.endWrite();
+  spiArbiter.release();
+  spiArbiter.runPending();
+}
+#endif
+
+#if TOUCH_IRQ_MODE
+// Neues Druck- oder Loslass-Ereignis, wird in loop() an den Scheduler gemeldet
+static bool touchEventPending = false;
+
+// Liest den Touch-Controller aus (nur bei freiem Bus aufgerufen)
+bool touchReadController(uint16_t *x, uint16_t *y) {
+  return tft.getTouch(x, y);
+}
+
+// Touch-Abfrage als Bus-Transaktion
+void touchPollTransaction() {
+  if (touchInput.poll()) {
+    touchEventPending = true;
+  }
+}
+
+// Reiht eine Touch-Abfrage ein, wenn ein Interrupt anliegt oder der Touch gedrückt ist
+void touchSubmitIfNeeded() {
+  if (touchInput.needsSample()) {
+    spiArbiter.submit(SPI_CLIENT_TOUCH, touchPollTransaction);
+  }
+}
+
+// Touchscreen-Lesefunktion für LVGL: liest nur die Ereignis-Warteschlange
+void touchpadReadCb(lv_indev_drv_t *indev_driver, lv_indev_data_t *data) {
+  touchInput.read(data);
+  if (data->state == LV_INDEV_STATE_PR) {
+    refreshScheduler.notifyActivity();
+  }
+}
+#else
 // Touchscreen-Lesefunction für LVGL
 void touchpadReadCb(lv_indev_drv_t *indev_driver, lv_indev_data_t *data) {
-  uint16_t touchX, touchY;
-  bool touched = tft.getTouch(&touchX, &touchY);
+  static lv_indev_state_t lastState = LV_INDEV_STATE_REL;
+  static uint16_t touchX = 0, touchY = 0;
 
-  if (touched) {
-    data->state = LV_INDEV_STATE_PR;
+#if LVGL_FLUSH_DMA
+  // Touch und Display teilen sich den SPI-Bus: während eines DMA-Transfers
+  // den letzten bekannten Zustand melden statt den Bus zu blockieren
+  // (beim synchronen Flush ist der Bus hier immer frei)
+  if (displayBusBusy()) {
+    data->state = lastState;
     data->point.x = touchX;
     data->point.y = touchY;
-  } else {
-    data->state = LV_INDEV_STATE_REL;
+    return;
   }
-}
+#endif
 
-// Timer-Interrupt für LVGL-Ticks
-void IRAM_ATTR onLvglTimer() {
-  lv_tick_inc(5); // LVGL Tick alle 5ms
-}
+  spiArbiter.acquire(SPI_CLIENT_TOUCH, micros());
+  bool touched = tft.getTouch(&touchX, &touchY);
+  spiArbiter.release();
+  lastState = touched ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
 
-// Timer für Programm- und Sensor-Überwachung
-void IRAM_ATTR onProgramTimer() {
-  if (systemState.state == RUNNING) {
-    uint32_t elapsedTime = rtc.getEpoch() - systemState.startTime;
-    
-    // Programm beendet?
-    if (systemState.programDuration > 0 && elapsedTime >= systemState.programDuration) {
-      systemState.state = COMPLETED;
-      systemState.motorActive = false;
-      digitalWrite(MOTOR_PIN, LOW);
-      setLedStatus(COMPLETED);
-    }
+  // Touch holt das Display aus dem Leerlauf
+  if (touched) {
+    refreshScheduler.notifyActivity();
   }
+
+  data->state = lastState;
+  data->point.x = touchX;
+  data->point.y = touchY;
 }
+#endif
+#endif // DISPLAY_RGB_PANEL
+
+#if !LV_TICK_CUSTOM
+// LVGL-Tick aus dem esp_timer-Task (Arduino-ESP32 2.x und 3.x)
+void onLvglTick(void *arg) {
+  lv_tick_inc(LVGL_TICK_MS);
+}
+#endif
 
 void setup() {
+  // Startphasen messen, die erste reicht bis zum Start der Anwendung zurück
+  bootProfiler.begin(FAST_BOOT);
+  bootProfiler.mark("core");
+
   Serial.begin(115200);
   Serial.println("Desinfektionseinheit mit LVGL und Remote-Steuerung startet...");
 
   // GPIO-Setup
-  pinMode(RED_PIN, OUTPUT);
-  pinMode(GREEN_PIN, OUTPUT);
-  pinMode(BLUE_PIN, OUTPUT);
   pinMode(MOTOR_PIN, OUTPUT);
   pinMode(SENSOR_PIN, INPUT);
+  digitalWrite(MOTOR_PIN, LOW);   // Motor aus
 
   // Initialisierung der Status-LEDs
-  digitalWrite(RED_PIN, LOW);
-  digitalWrite(GREEN_PIN, HIGH);  // Grün im Standby
-  digitalWrite(BLUE_PIN, LOW);
-  digitalWrite(MOTOR_PIN, LOW);   // Motor aus
+  statusLed.begin();
+  statusLed.attachTimers(controlTimers);
+  setLedStatus(IDLE);             // Grün im Standby
 
   // System-Status initialisieren
   systemState.state = IDLE;
@@ -323,194 +969,436 @@ void setup() {
   systemState.tankLevelOk = true;
   systemState.motorActive = false;
   systemState.remoteControlEnabled = true; // Remote-Steuerung standardmäßig aktiviert
+  publishSystemState();
+
+  // Warteschlangen vor allen Modulen anlegen, die Befehle oder Ereignisse senden
+  appTasks.createQueues();
+  bootProfiler.mark("gpio_state");
 
   // LVGL initialisieren
   lv_init();
+  bootProfiler.mark("lv_init");
 
+#if DISPLAY_RGB_PANEL
+  // RGB-Panel initialisieren, LVGL zeichnet direkt in dessen Framebuffer
+  lv_disp_drv_init(&dispDriver);
+  if (!rgbPanel.begin(SCREEN_WIDTH, SCREEN_HEIGHT, &dispDriver)) {
+    Serial.println("RGB-Panel konnte nicht initialisiert werden (PSRAM?)");
+  }
+  dispDriver.flush_cb = lvglFlushCb;
+  lv_disp_t *disp = lv_disp_drv_register(&dispDriver);
+  bootProfiler.mark("panel");
+#else
   // TFT-Display initialisieren
   tft.begin();
   tft.setRotation(1); // Landscape
   tft.fillScreen(TFT_BLACK);
+#if LVGL_FLUSH_DMA
+  // DMA-Kanal für den SPI-Bus einrichten, die Puffer liegen bereits in SPI-Reihenfolge vor
+  tft.initDMA();
+  tft.setSwapBytes(false);
+#endif
+  bootProfiler.mark("tft_begin");
 
   // Touchscreen kalibrieren - Werte anpassen, je nach Display
   uint16_t calData[5] = {275, 3620, 264, 3532, 1};
   tft.setTouch(calData);
+  bootProfiler.mark("touch_cal");
 
   // LVGL-Displaytreiber initialisieren
-  lv_disp_draw_buf_init(&drawBuffer, buf1, buf2, SCREEN_WIDTH * 10);
+  lv_disp_draw_buf_init(&drawBuffer, buf1, buf2, LVGL_BUFFER_SIZE);
   lv_disp_drv_init(&dispDriver);
   dispDriver.hor_res = SCREEN_WIDTH;
   dispDriver.ver_res = SCREEN_HEIGHT;
   dispDriver.flush_cb = lvglFlushCb;
+#if LVGL_FLUSH_DMA
+  dispDriver.wait_cb = lvglWaitCb;
+#endif
   dispDriver.draw_buf = &drawBuffer;
-  lv_disp_drv_register(&dispDriver);
+  lv_disp_t *disp = lv_disp_drv_register(&dispDriver);
+#endif
 
   // LVGL-Touchscreen-Treiber initialisieren
   lv_indev_drv_init(&indevDriver);
   indevDriver.type = LV_INDEV_TYPE_POINTER;
   indevDriver.read_cb = touchpadReadCb;
-  lv_indev_drv_register(&indevDriver);
+  lv_indev_t *indev = lv_indev_drv_register(&indevDriver);
+#if TOUCH_IRQ_MODE
+  touchInput.begin(TOUCH_IRQ, touchReadController);
+#endif
 
-  // Timer für LVGL initialisieren
-  lvglTimer = timerBegin(0, 80, true);
-  timerAttachInterrupt(lvglTimer, &onLvglTimer, true);
-  timerAlarmWrite(lvglTimer, 5000, true); // 5ms
-  timerAlarmEnable(lvglTimer);
+  // Adaptive Refresh-Rate aktivieren
+  refreshScheduler.begin(disp, indev);
 
-  // Timer für Programmüberwachung
-  programTimer = timerBegin(1, 80, true);
-  timerAttachInterrupt(programTimer, &onProgramTimer, true);
-  timerAlarmWrite(programTimer, 1000000, true); // 1 Sekunde
-  timerAlarmEnable(programTimer);
+  // Refreshs und Flushs vermessen
+  displayMetrics.begin(disp, DISPLAY_BUS_BYTES_PER_PIXEL);
+#if !DISPLAY_RGB_PANEL
+  spiArbiter.begin();
+#endif
+  bootProfiler.mark("lv_drivers");
+
+#if !LV_TICK_CUSTOM
+  // Timer für LVGL-Ticks; mit LV_TICK_CUSTOM (lv_conf.h) liest LVGL millis() selbst
+  esp_timer_create_args_t tickArgs = {};
+  tickArgs.callback = onLvglTick;
+  tickArgs.name = "lvgl_tick";
+  if (esp_timer_create(&tickArgs, &lvglTickTimer) == ESP_OK) {
+    esp_timer_start_periodic(lvglTickTimer, LVGL_TICK_MS * 1000);
+  }
+#endif
+
+  // Frist für das Programmende (einmaliger esp_timer, meldet sich über die Befehlswarteschlange)
+  if (!programSupervisor.begin()) {
+    Serial.println("Programm-Timer konnte nicht angelegt werden");
+  }
+
+  // Nach einem Neustart das laufende Programm aus dem Journal fortsetzen
+  bool resumed = resumeFromJournal();
+  bootProfiler.mark("journal");
 
   // MQTT-Callback für Fernsteuerungsbefehle registrieren
   mqttClient.setCommandCallback(onMqttCommand);
 
   // WiFi und Remote-Steuerung initialisieren
   initWiFi();
+  bootProfiler.mark("init_wifi");
 
-  // GUI erstellen
-  createMainScreen();
-  createProgramScreen();
-  createSettingsScreen();
-  createRunningScreen();
-  createCompletedScreen();
-  createErrorScreen();
+  // GUI registrieren, Bildschirme werden erst bei Bedarf aufgebaut
+  uiInitScreens();
+#if UI_SNAPSHOT_CACHE && !DISPLAY_RGB_PANEL
+  snapshotCache.setBlitCallback(lvglBlitSnapshot);
+#endif
+  bootProfiler.mark("ui_init");
+
+  // Starte mit dem Hauptbildschirm (bzw. dem fortgesetzten Programm)
+  uiShowScreen(resumed ? SCREEN_RUNNING : SCREEN_MAIN);
+  bootProfiler.mark("first_screen");
+
+#if !FAST_BOOT
+  // Im Schnellstart erst nach dem ersten Frame (uiTask)
+  reportStyles();
+  bootProfiler.mark("style_report");
+#endif
+
+  // Steuerung, Oberfläche und Netzwerk in eigenen Tasks starten
+  if (!appTasks.start(controlTask, uiTask, netTask)) {
+    Serial.println("Tasks konnten nicht gestartet werden");
+  }
+  bootProfiler.mark("tasks");
+
+  // Profil des vorherigen Starts ausgeben (der laufende folgt mit dem Startbericht)
+  const BootProfile *previous = bootProfiler.get(1);
+  if (previous != NULL) {
+    BootProfiler::print(Serial, *previous);
+  }
 
-  // Starte mit dem Hauptbildschirm
-  lv_scr_load(mainScreen);
-  
   Serial.println("Initialisierung abgeschlossen!");
 }
 
+// Style-Speicherbedarf des angezeigten Bildschirms ausgeben (nur Diagnose)
+void reportStyles() {
+  UiStyleReport styleReport = {};
+  uiStyleReport(lv_scr_act(), styleReport);
+  Serial.printf("Styles: %u lokal (%u Bytes), %u geteilt (als lokale Styles %u Bytes)\n",
+                (unsigned)styleReport.localStyles, (unsigned)styleReport.localBytes,
+                (unsigned)styleReport.sharedRefs, (unsigned)styleReport.sharedAsLocalBytes);
+}
+
 void loop() {
-  lv_timer_handler(); // LVGL-Tasks ausführen
-  
-  // Sensor-Check
-  static uint32_t lastSensorCheck = 0;
-  if (millis() - lastSensorCheck > 1000) {
-    lastSensorCheck = millis();
+  // Die Arbeit erledigen controlTask, uiTask und netTask
+  vTaskDelete(NULL);
+}
+
+// Steuerungs-Task: Befehle ausführen und den Tank überwachen
+void controlTask(void *param) {
+  controlTimers.every("tank_check", CONTROL_TANK_CHECK_MS, [](void *arg) {
     checkTankLevel();
+  });
+  controlTimers.every("journal_checkpoint", JOURNAL_CHECKPOINT_MS, [](void *arg) {
+    // Zwischenstand für die Wiederaufnahme nach einem Neustart
+    if (systemState.state == RUNNING) {
+      progressJournal.append(JOURNAL_CHECKPOINT, systemState.activeProgram, systemState.programDuration, getElapsedTime());
+    }
+  });
+  bootProfiler.milestone("control");
+
+  for (;;) {
+    // Bis zum nächsten Auftrag im Timer-Rad oder zum nächsten Befehl warten
+    uint32_t waitMs = min(controlTimers.nextDeadline(), (uint32_t)CONTROL_TANK_CHECK_MS);
+    ControlCommand cmd;
+    bool received = appTasks.receiveControl(&cmd, waitMs);
+
+    appTasks.busyBegin(APP_TASK_CONTROL);
+    // Alle wartenden Befehle ausführen, nur hier wird der Programmzustand geändert
+    while (received) {
+      CommandResult result = COMMAND_INVALID;
+      switch (cmd.type) {
+        case CONTROL_START_PROGRAM:
+          result = controlStartProgram(cmd.value);
+          break;
+        case CONTROL_STOP_PROGRAM:
+          result = controlStopProgram();
+          break;
+        case CONTROL_SET_CUSTOM_DAYS:
+          if (cmd.value >= 1 && cmd.value <= 99) {
+            systemState.customDays = cmd.value;
+            result = COMMAND_OK;
+          }
+          break;
+        case CONTROL_PROGRAM_DEADLINE:
+          result = controlProgramDeadline(cmd.value);
+          break;
+        case CONTROL_SET_REMOTE_CONTROL:
+          systemState.remoteControlEnabled = cmd.value != 0;
+          result = COMMAND_OK;
+          break;
+      }
+      // Vor complete() veröffentlichen, damit der Einsender den neuen Zustand liest
+      publishSystemState();
+      commandQueue.complete(cmd, result);
+      received = commandQueue.take(&cmd);
+    }
+    controlTimers.poll();
+    publishSystemState();
+    appTasks.busyEnd(APP_TASK_CONTROL);
   }
-  
-  // Status-Updates für laufendes Programm
-  if (systemState.state == RUNNING) {
-    static uint32_t lastStatusUpdate = 0;
-    if (millis() - lastStatusUpdate > 1000) {
-      lastStatusUpdate = millis();
-      updateRunningScreen();
+}
+
+// Oberflächen-Task: LVGL, Display und Touch
+void uiTask(void *param) {
+  uiTimers.every("ui_housekeeping", 1000, [](void *arg) {
+    // Länger nicht angezeigte Bildschirme freigeben
+    screenManager.collect();
+
+    // Messwerte im Overlay aktualisieren (nur wenn eingeblendet)
+    displayMetrics.updateOverlay();
+  });
+  uiTimers.every("running_screen", 1000, [](void *arg) {
+    // Status-Updates für laufendes Programm (prüft den Zustand selbst)
+    updateRunningScreen();
+  });
+
+  for (;;) {
+    appTasks.busyBegin(APP_TASK_UI);
+#if LVGL_FLUSH_DMA
+    lvglDmaPoll(); // Abgeschlossenen DMA-Transfer an LVGL melden
+#endif
+#if TOUCH_IRQ_MODE
+    // Touch nach Interrupt bzw. während der Berührung abfragen, bei belegtem Bus zwischen zwei Display-Blöcken
+    touchSubmitIfNeeded();
+    if (touchEventPending) {
+      touchEventPending = false;
+      refreshScheduler.notifyInput();
+    }
+#endif
+    // Ereignisse von Steuerung und Netzwerk übernehmen
+    UiEvent event;
+    while (appTasks.receiveUi(&event)) {
+      switch (event.type) {
+        case UI_EVENT_STATUS_TEXT:
+          setStatusText(event.text);
+          break;
+        case UI_EVENT_SHOW_SCREEN:
+          uiShowScreen((ScreenId)event.value);
+          break;
+        case UI_EVENT_ACTIVITY:
+          refreshScheduler.notifyActivity();
+          break;
+        case UI_EVENT_SET_OVERLAY:
+          displayMetrics.setOverlayVisible(event.value != 0);
+          refreshScheduler.notifyActivity();
+          break;
+      }
+    }
+
+    // LVGL-Tasks und fällige Aufträge ausführen, Schlafzeit bis zur nächsten Deadline ermitteln
+    uint32_t sleepMs = refreshScheduler.handle();
+    sleepMs = min(sleepMs, uiTimers.poll());
+
+    if (!firstFrameDone && displayMetrics.getRefreshCount() > 0) {
+      bootProfiler.milestone("first_frame");
+      firstFrameDone = true;
+#if FAST_BOOT
+      // Zurückgestellte Arbeit: Diagnose der Oberfläche, dann das Netzwerk freigeben
+      uint32_t start = BootProfiler::now();
+      reportStyles();
+      bootProfiler.record("style_report", start);
+      if (appTasks.getTask(APP_TASK_NET) != NULL) {
+        xTaskNotifyGive(appTasks.getTask(APP_TASK_NET));
+      }
+#endif
     }
+    appTasks.busyEnd(APP_TASK_UI);
+
+    // Mindestens eine Millisekunde abgeben, sonst kommt der Idle-Task dieses Kerns nie dran
+    sleepMs = sleepMs > 0 ? sleepMs : 1;
+#if TOUCH_IRQ_MODE
+    touchInput.sleep(sleepMs); // Bis zur nächsten LVGL-Deadline oder zum nächsten Touch schlafen
+#else
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleepMs)); // Bis zur nächsten LVGL-Deadline oder zum nächsten Ereignis schlafen
+#endif
   }
-  
-  // WiFi und Remote-Kommunikation verwalten
-  wifiManager.loop();
-  
-  if (wifiManager.isConnected()) {
-    mqttClient.loop();
-    restApi.loop();
-    
-    // Telemetriedaten periodisch senden, wenn verbunden
-    static uint32_t lastTelemetryUpdate = 0;
-    if (millis() - lastTelemetryUpdate > 60000) { // Alle 60 Sekunden
-      lastTelemetryUpdate = millis();
-      
-      // Telemetriedaten sammeln und senden
-      DynamicJsonDocument telemetryDoc(256);
-      telemetryDoc["state"] = (int)systemState.state;
-      telemetryDoc["program"] = systemState.activeProgram;
-      telemetryDoc["remaining_time"] = getRemainingTime();
-      telemetryDoc["progress"] = getProgressPercent();
-      telemetryDoc["tank_level_ok"] = systemState.tankLevelOk;
-      telemetryDoc["uptime"] = millis() / 1000;
-      
-      mqttClient.publishTelemetry(telemetryDoc.as<JsonObject>());
+}
+
+// Netzwerk-Task: WiFi, MQTT, REST und Telemetrie
+void netTask(void *param) {
+#if FAST_BOOT
+  // Erst nach dem ersten Frame starten (höchstens BOOT_NET_DEFER_MAX_MS warten)
+  if (!firstFrameDone) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BOOT_NET_DEFER_MAX_MS));
+  }
+#endif
+  bootProfiler.milestone("net");
+
+  // Verbindungsaufbau starten, Ereignisse und AP-Fallback verarbeitet wifiManager.loop()
+  uint32_t start = BootProfiler::now();
+  wifiManager.begin();
+  bootProfiler.record("wifi_begin", start);
+  wifiManager.attachTimers(netTimers);
+  mqttClient.attachTimers(netTimers);
+  netTimers.every("telemetry", TELEMETRY_INTERVAL_MS, [](void *arg) {
+    sendTelemetry();
+  });
+  netTimers.every("journal_flush", JOURNAL_FLUSH_MS, [](void *arg) {
+    // Neuesten Journal-Eintrag schreiben, der Flash blockiert so nie die Steuerung
+    progressJournal.flush();
+  });
+  netTimers.after("boot_report", BOOT_REPORT_DELAY_MS, sendBootReport);
+
+  for (;;) {
+    NetEvent event;
+    bool received = appTasks.receiveNet(&event, min(netTimers.nextDeadline(), (uint32_t)NET_POLL_MS));
+
+    appTasks.busyBegin(APP_TASK_NET);
+    while (received) {
+      bool online = getSystemSnapshot().remoteControlEnabled && wifiManager.isConnected();
+      switch (event.type) {
+        case NET_EVENT_STATUS:
+          if (online) {
+            mqttClient.publishStatus(event.status);
+          }
+          break;
+        case NET_EVENT_PROGRAM_STARTED:
+          if (online) {
+            StaticJsonDocument<128> statusDoc;
+            statusDoc["program"] = event.program;
+            statusDoc["duration"] = event.duration;
+            mqttClient.publishDetailedStatus("program_started", statusDoc.as<JsonObject>());
+          }
+          break;
+        case NET_EVENT_RESET_WIFI:
+          wifiManager.reset();
+          break;
+      }
+      received = appTasks.receiveNet(&event, 0);
+    }
+
+    // WiFi und Remote-Kommunikation verwalten (Verbindungsprüfungen laufen im Timer-Rad)
+    netTimers.poll();
+    wifiManager.loop();
+
+    if (wifiManager.isConnected()) {
+      mqttClient.loop();
+      restApi.loop();
     }
+    appTasks.busyEnd(APP_TASK_NET);
   }
-  
-  delay(5); // Kurze Pause für ESP-Stabilität
 }
 
-// Erstellt den Hauptbildschirm
-void createMainScreen() {
-  mainScreen = lv_obj_create(NULL);
-  lv_obj_set_style_bg_color(mainScreen, lv_color_hex(0x003366), LV_PART_MAIN | LV_STATE_DEFAULT);
-  
-  // Titel
-  lv_obj_t *title = lv_label_create(mainScreen);
-  lv_label_set_text(title, "Desinfektionseinheit");
-  lv_obj_set_style_text_color(title, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_set_style_text_font(title, &lv_font_montserrat_28, LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
-  
-  // Programmauswahl-Button
-  lv_obj_t *programBtn = lv_btn_create(mainScreen);
-  lv_obj_set_size(programBtn, 300, 80);
-  lv_obj_align(programBtn, LV_ALIGN_CENTER, 0, -80);
-  lv_obj_add_event_cb(programBtn, [](lv_event_t *e) {
-    lv_scr_load(programScreen);
-  }, LV_EVENT_CLICKED, NULL);
-  
-  lv_obj_t *programLabel = lv_label_create(programBtn);
-  lv_label_set_text(programLabel, "Programme");
-  lv_obj_center(programLabel);
-  
-  // Einstellungen-Button
-  lv_obj_t *settingsBtn = lv_btn_create(mainScreen);
-  lv_obj_set_size(settingsBtn, 300, 80);
-  lv_obj_align(settingsBtn, LV_ALIGN_CENTER, 0, 20);
-  lv_obj_add_event_cb(settingsBtn, [](lv_event_t *e) {
-    lv_scr_load(settingsScreen);
-  }, LV_EVENT_CLICKED, NULL);
-  
-  lv_obj_t *settingsLabel = lv_label_create(settingsBtn);
-  lv_label_set_text(settingsLabel, "Einstellungen");
-  lv_obj_center(settingsLabel);
-  
-  // Status-Anzeige
-  statusLabel = lv_label_create(mainScreen);
-  lv_label_set_text(statusLabel, "Bereit für Desinfektion");
-  lv_obj_set_style_text_color(statusLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-  lv_obj_align(statusLabel, LV_ALIGN_BOTTOM_MID, 0, -30);
+// Startprofil einmal ausgeben und per MQTT senden, sobald verbunden (Netzwerk-Task)
+void sendBootReport(void *arg) {
+  static bool printed = false;
+  const BootProfile *profile = bootProfiler.get(0);
+  if (!printed) {
+    BootProfiler::print(Serial, *profile);
+    printed = true;
+  }
+  if (!mqttClient.isConnected()) {
+    netTimers.after("boot_report", BOOT_REPORT_DELAY_MS, sendBootReport);
+    return;
+  }
+  StaticJsonDocument<1024> profileDoc;
+  bootProfileToJson(*profile, profileDoc.to<JsonObject>());
+  mqttClient.publishDetailedStatus("boot_profile", profileDoc.as<JsonObject>());
 }
 
-// Erstellt den Programm-Auswahlbildschirm
-void createProgramScreen() {
-  // Hier Programmauswahlbildschirm-Code einfügen
-  // (Gekürzt, um Platz zu sparen)
+// Startprofil als JSON: Dauer der Phasen und Zeitpunkte der Meilensteine in µs
+void bootProfileToJson(const BootProfile &profile, JsonObject obj) {
+  obj["boot"] = profile.boot;
+  obj["reset_reason"] = BootProfiler::resetReasonName(profile.resetReason);
+  obj["fast_boot"] = profile.fastBoot != 0;
+  const BootPhase *firstFrame = BootProfiler::find(profile, "first_frame");
+  obj["first_frame_us"] = firstFrame != NULL ? firstFrame->atUs : 0;
+  JsonObject phases = obj.createNestedObject("phases");
+  JsonObject milestones = obj.createNestedObject("milestones");
+  for (uint8_t i = 0; i < profile.phaseCount && i < BOOT_PROFILE_PHASES; i++) {
+    const BootPhase &phase = profile.phases[i];
+    if (phase.durationUs > 0) {
+      phases[phase.name] = phase.durationUs;
+    } else {
+      milestones[phase.name] = phase.atUs;
+    }
+  }
 }
 
-// Erstellt den Einstellungsbildschirm
-void createSettingsScreen() {
-  // Hier Einstellungsbildschirm-Code einfügen
-  // (Gekürzt, um Platz zu sparen)
+// Telemetriedaten sammeln und senden (Netzwerk-Task, nur wenn verbunden)
+void sendTelemetry() {
+  if (!wifiManager.isConnected()) {
+    return;
+  }
+
+  SystemStateSnapshot snap = getSystemSnapshot();
+  StaticJsonDocument<768> telemetryDoc;
+  telemetryDoc["state"] = (int)snap.state;
+  telemetryDoc["program"] = snap.activeProgram;
+  telemetryDoc["remaining_time"] = snap.remainingTime();
+  telemetryDoc["progress"] = snap.progressPercent();
+  telemetryDoc["tank_level_ok"] = (bool)snap.tankLevelOk;
+  telemetryDoc["uptime"] = millis() / 1000;
+  telemetryDoc["journal_wa"] = progressJournal.getWriteAmplification();
+  telemetryDoc["wifi_connect_ms"] = wifiManager.getTimings().totalMs;
+  telemetryDoc["ui_skipped_updates"] = uiBindingSkippedCount();
+  telemetryDoc["display_active_s"] = refreshScheduler.getActiveMs() / 1000;
+  telemetryDoc["display_idle_s"] = refreshScheduler.getIdleMs() / 1000;
+  telemetryDoc["display_px_per_s"] = displayMetrics.getPixelsPerSecond();
+#if TOUCH_IRQ_MODE
+  telemetryDoc["touch_irqs"] = touchInput.getInterruptCount();
+  telemetryDoc["touch_samples"] = touchInput.getSampleCount();
+#endif
+  telemetryDoc["mqtt_max_bytes"] = mqttClient.getPublishStats().maxBytes;
+  // CPU-Last je Task in Promille (Schlüssel wird ins Dokument kopiert)
+  char loadKey[24];
+  for (uint8_t i = 0; i < taskMonitor.getCount(); i++) {
+    const TaskMonitor::Stats &stats = taskMonitor.get(i);
+    snprintf(loadKey, sizeof(loadKey), "load_%s", stats.name);
+    telemetryDoc[loadKey] = stats.loadPermille;
+  }
+
+  mqttClient.publishTelemetry(telemetryDoc.as<JsonObject>());
 }
 
-// Erstellt den Bildschirm für laufende Programme
-void createRunningScreen() {
-  // Hier Bildschirm für laufende Programme einfügen
-  // (Gekürzt, um Platz zu sparen)
+// Programm starten (Touch-Oberfläche, ausgeführt von der Steuerung)
+void startProgram(int programIndex) {
+  commandQueue.submit(CONTROL_START_PROGRAM, programIndex, COMMAND_SOURCE_TOUCH);
 }
 
-// Erstellt den Bildschirm für abgeschlossene Programme
-void createCompletedScreen() {
-  // Hier Bildschirm für abgeschlossene Programme einfügen
-  // (Gekürzt, um Platz zu sparen)
+// Programm stoppen (Touch-Oberfläche, ausgeführt von der Steuerung)
+void stopProgram() {
+  commandQueue.submit(CONTROL_STOP_PROGRAM, 0, COMMAND_SOURCE_TOUCH);
 }
 
-// Erstellt den Fehlerbildschirm
-void createErrorScreen() {
-  // Hier Fehlerbildschirm-Code einfügen
-  // (Gekürzt, um Platz zu sparen)
+// Tage des individuellen Programms setzen (Touch-Oberfläche, ausgeführt von der Steuerung)
+void setCustomDays(int days) {
+  commandQueue.submit(CONTROL_SET_CUSTOM_DAYS, days, COMMAND_SOURCE_TOUCH);
 }
 
-// Aktualisiert die Anzeige im laufenden Programm
-void updateRunningScreen() {
-  // Hier Code für die Aktualisierung der Anzeige einfügen
-  // (Gekürzt, um Platz zu sparen)
+// Fernsteuerung ein-/ausschalten (Touch-Oberfläche, ausgeführt von der Steuerung)
+void setRemoteControl(bool enabled) {
+  commandQueue.submit(CONTROL_SET_REMOTE_CONTROL, enabled ? 1 : 0, COMMAND_SOURCE_TOUCH);
 }
 
-// Programm starten
-void startProgram(int programIndex) {
+// Programm starten (Steuerungs-Task)
+CommandResult controlStartProgram(int programIndex) {
   // Abhängig vom Programmindex entsprechende Dauer setzen
   switch (programIndex) {
     case 1:
@@ -526,7 +1414,7 @@ void startProgram(int programIndex) {
       systemState.programDuration = systemState.customDays * 24 * 60 * 60;
       break;
     default:
-      return; // Ungültiger Index
+      return COMMAND_INVALID; // Ungültiger Index
   }
   
   // Programm starten
@@ -538,25 +1426,28 @@ void startProgram(int programIndex) {
   // Motor aktivieren
   digitalWrite(MOTOR_PIN, HIGH);
   
+  // Frist für das Programmende stellen und den Start ins Journal eintragen
+  programSupervisor.arm(systemState.programDuration);
+  progressJournal.append(JOURNAL_START, programIndex, systemState.programDuration, 0);
+  
   // Status-LED auf Blau setzen
   setLedStatus(RUNNING);
   
   // Status-Text aktualisieren
-  lv_label_set_text(statusLabel, "Programm läuft");
+  appTasks.postUi(UI_EVENT_ACTIVITY);
+  appTasks.postUi(UI_EVENT_STATUS_TEXT, 0, "Programm läuft");
   
-  // MQTT-Status senden, wenn Fernsteuerung aktiviert
-  if (systemState.remoteControlEnabled && wifiManager.isConnected()) {
-    // Detaillierten Status senden
-    DynamicJsonDocument statusDoc(128);
-    statusDoc["program"] = programIndex;
-    statusDoc["duration"] = systemState.programDuration;
-    
-    mqttClient.publishDetailedStatus("program_started", statusDoc.as<JsonObject>());
-  }
+  // Detaillierten MQTT-Status senden (nur wenn Fernsteuerung aktiviert und verbunden)
+  appTasks.postNet(NET_EVENT_PROGRAM_STARTED, NULL, programIndex, systemState.programDuration);
+  return COMMAND_OK;
 }
 
-// Programm stoppen
-void stopProgram() {
+// Programm stoppen (Steuerungs-Task)
+CommandResult controlStopProgram() {
+  programSupervisor.disarm();
+  if (systemState.state == RUNNING) {
+    progressJournal.append(JOURNAL_STOP, systemState.activeProgram, systemState.programDuration, getElapsedTime());
+  }
   systemState.state = IDLE;
   systemState.motorActive = false;
   
@@ -567,26 +1458,49 @@ void stopProgram() {
   setLedStatus(IDLE);
   
   // Status-Text aktualisieren
-  lv_label_set_text(statusLabel, "Bereit für Desinfektion");
+  appTasks.postUi(UI_EVENT_ACTIVITY);
+  appTasks.postUi(UI_EVENT_STATUS_TEXT, 0, "Bereit für Desinfektion");
   
-  // MQTT-Status senden, wenn Fernsteuerung aktiviert
-  if (systemState.remoteControlEnabled && wifiManager.isConnected()) {
-    mqttClient.publishStatus("program_stopped");
-  }
+  // MQTT-Status senden (nur wenn Fernsteuerung aktiviert und verbunden)
+  appTasks.postNet(NET_EVENT_STATUS, "program_stopped");
+  return COMMAND_OK;
 }
 
-// Formatiert Zeit in Tage, Stunden, Minuten
-String formatTime(uint32_t seconds) {
-  uint32_t days = seconds / (24 * 60 * 60);
-  seconds %= (24 * 60 * 60);
-  uint32_t hours = seconds / (60 * 60);
-  seconds %= (60 * 60);
-  uint32_t minutes = seconds / 60;
+// Frist des Programms abgelaufen (Steuerungs-Task)
+CommandResult controlProgramDeadline(uint32_t generation) {
+  // Verspäteter Ablauf eines gestoppten oder neu gestellten Programms
+  if (!programSupervisor.isCurrent(generation) || systemState.state != RUNNING) {
+    return COMMAND_INVALID;
+  }
   
-  return String(days) + " Tage " + String(hours) + " Std " + String(minutes) + " Min";
+  // Uhr wurde zurückgestellt: Frist mit der Restzeit laut Uhr neu stellen
+  uint32_t remaining = getRemainingTime();
+  if (remaining > 0) {
+    programSupervisor.arm(remaining);
+    return COMMAND_OK;
+  }
+  
+  programSupervisor.disarm();
+  progressJournal.append(JOURNAL_COMPLETE, systemState.activeProgram, systemState.programDuration, systemState.programDuration);
+  systemState.state = COMPLETED;
+  systemState.motorActive = false;
+  
+  // Motor deaktivieren
+  digitalWrite(MOTOR_PIN, LOW);
+  
+  // Status-LED auf Türkis setzen
+  setLedStatus(COMPLETED);
+  
+  // Abschlussbildschirm anzeigen
+  appTasks.postUi(UI_EVENT_ACTIVITY);
+  appTasks.postUi(UI_EVENT_SHOW_SCREEN, SCREEN_COMPLETED);
+  
+  // MQTT-Status senden (nur wenn Fernsteuerung aktiviert und verbunden)
+  appTasks.postNet(NET_EVENT_STATUS, "program_completed");
+  return COMMAND_OK;
 }
 
-// Berechnet die verbleibende Zeit des Programms
+// Berechnet die verbleibende Zeit des Programms (Steuerungs-Task, andere Tasks lesen getSystemSnapshot())
 uint32_t getRemainingTime() {
   if (systemState.state != RUNNING) {
     return 0;
@@ -601,43 +1515,77 @@ uint32_t getRemainingTime() {
   return systemState.programDuration - elapsedTime;
 }
 
-// Berechnet den Fortschritt in Prozent
-int getProgressPercent() {
-  if (systemState.state != RUNNING) {
-    return 0;
+// Gelaufene Zeit des Programms in Sekunden (Steuerungs-Task)
+uint32_t getElapsedTime() {
+  return rtc.getEpoch() - systemState.startTime;
+}
+
+/**
+ * Setzt ein Programm fort, das laut Journal beim letzten Ausschalten lief (in setup(), vor den Tasks).
+ * Die Uhr läuft nach einem Stromausfall nicht weiter, fortgesetzt wird daher mit der
+ * zuletzt eingetragenen Laufzeit; die Zeit ohne Strom zählt nicht als Desinfektion.
+ *
+ * @return true, wenn ein Programm fortgesetzt wurde
+ */
+bool resumeFromJournal() {
+  if (!progressJournal.begin()) {
+    Serial.println("Journal konnte nicht geöffnet werden");
+    return false;
   }
-  
-  uint32_t elapsedTime = rtc.getEpoch() - systemState.startTime;
-  
-  if (elapsedTime >= systemState.programDuration) {
-    return 100;
+  JournalRecord record;
+  if (!progressJournal.latest(record)) {
+    return false;
   }
-  
-  return (elapsedTime * 100) / systemState.programDuration;
+  Serial.printf("Journal: %s, Programm %u, %u/%u s\n", ProgressJournal::typeName(record.type),
+                (unsigned)record.program, (unsigned)record.elapsed, (unsigned)record.duration);
+
+  // Pausen kennt die Steuerung noch nicht, nur laufende Programme werden fortgesetzt
+  bool running = record.type == JOURNAL_START || record.type == JOURNAL_CHECKPOINT || record.type == JOURNAL_RESUME;
+  if (!running || record.program < 1 || record.program > 4 || record.elapsed >= record.duration) {
+    return false;
+  }
+
+  systemState.activeProgram = record.program;
+  systemState.programDuration = record.duration;
+  systemState.state = RUNNING;
+  systemState.startTime = rtc.getEpoch() - record.elapsed;
+  systemState.motorActive = true;
+  digitalWrite(MOTOR_PIN, HIGH);
+  setLedStatus(RUNNING);
+  programSupervisor.arm(record.duration - record.elapsed);
+  progressJournal.append(JOURNAL_RESUME, record.program, record.duration, record.elapsed);
+  publishSystemState();
+
+  appTasks.postUi(UI_EVENT_STATUS_TEXT, 0, "Programm fortgesetzt");
+  appTasks.postNet(NET_EVENT_STATUS, "program_resumed");
+  return true;
+}
+
+// Liest den von der Steuerung veröffentlichten Zustand ohne Sperre (aus jedem Task)
+SystemStateSnapshot getSystemSnapshot() {
+  SystemStateSnapshot snap;
+  snap.version = systemStateSeqlock.read(snap);
+  snap.now = rtc.getEpoch();
+  return snap;
 }
 
 // Setzt die Status-LED entsprechend dem aktuellen Zustand
+// (nur im Steuerungs-Task oder in setup(), das Timer-Rad gehört dem Steuerungs-Task)
 void setLedStatus(ProgramState state) {
   switch (state) {
     case IDLE:
-      digitalWrite(RED_PIN, LOW);
-      digitalWrite(GREEN_PIN, HIGH);
-      digitalWrite(BLUE_PIN, LOW);
+      statusLed.setPresetColor(2);  // Grün
       break;
     case RUNNING:
-      digitalWrite(RED_PIN, LOW);
-      digitalWrite(GREEN_PIN, LOW);
-      digitalWrite(BLUE_PIN, HIGH);
+      statusLed.setPresetColor(3);  // Blau, pulsierend
+      statusLed.enablePulse();
       break;
     case COMPLETED:
-      digitalWrite(RED_PIN, LOW);
-      digitalWrite(GREEN_PIN, HIGH);
-      digitalWrite(BLUE_PIN, HIGH);
+      statusLed.setPresetColor(5);  // Türkis
       break;
     case ERROR:
-      digitalWrite(RED_PIN, HIGH);
-      digitalWrite(GREEN_PIN, LOW);
-      digitalWrite(BLUE_PIN, LOW);
+      statusLed.setPresetColor(1);  // Rot, blinkend
+      statusLed.enableBlink(500);
       break;
   }
 }
@@ -654,6 +1602,8 @@ void checkTankLevel() {
     // Wenn Füllstand zu niedrig und ein Programm läuft
     if (!systemState.tankLevelOk && systemState.state == RUNNING) {
       // Fehler-Zustand setzen
+      programSupervisor.disarm();
+      progressJournal.append(JOURNAL_ERROR, systemState.activeProgram, systemState.programDuration, getElapsedTime());
       systemState.state = ERROR;
       systemState.motorActive = false;
       
@@ -664,12 +1614,11 @@ void checkTankLevel() {
       setLedStatus(ERROR);
       
       // Zum Fehlerbildschirm wechseln
-      lv_scr_load(errorScreen);
+      appTasks.postUi(UI_EVENT_ACTIVITY);
+      appTasks.postUi(UI_EVENT_SHOW_SCREEN, SCREEN_ERROR);
       
-      // MQTT-Status senden, wenn Fernsteuerung aktiviert
-      if (systemState.remoteControlEnabled && wifiManager.isConnected()) {
-        mqttClient.publishStatus("error_tank_empty");
-      }
+      // MQTT-Status senden (nur wenn Fernsteuerung aktiviert und verbunden)
+      appTasks.postNet(NET_EVENT_STATUS, "error_tank_empty");
     }
   }
 }
\ No newline at end of file
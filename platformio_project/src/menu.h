@@ -4,6 +4,10 @@
 #include <Arduino.h>
 #include <lvgl.h>
 
+#include "ui_bindings.h"
+#include "ui_decor.h"
+#include "ui_styles.h"
+
 /**
  * Erstellt eine moderne Menüstruktur für LVGL
  */
@@ -12,6 +16,7 @@ private:
   lv_obj_t* parent;     // Übergeordnetes Objekt für das Menü
   lv_obj_t* menuCont;   // Container für das Menü
   lv_obj_t* titleLabel; // Titel des Menüs
+  uint32_t firstItemIndex; // Kindindex des ersten Menüeintrags
   
   // Callback-Typen
   typedef void (*MenuCallback)();
@@ -28,12 +33,6 @@ private:
   
   // Menüeinträge
   std::vector<MenuItem> items;
-  
-  // Visuelle Einstellungen
-  lv_style_t styleMenuItem;
-  lv_style_t styleMenuItemSelected;
-  lv_style_t styleMenuContainer;
-  lv_style_t styleMenuTitle;
 
 public:
   /**
@@ -48,34 +47,29 @@ public:
   MenuSystem(lv_obj_t* parent, const char* title, int16_t x, int16_t y, int16_t width) {
     this->parent = parent;
     
-    // Styles initialisieren
-    initStyles();
-    
     // Menü-Container erstellen
     menuCont = lv_obj_create(parent);
     lv_obj_remove_style_all(menuCont);
-    lv_obj_add_style(menuCont, &styleMenuContainer, 0);
+    uiDecorate(menuCont, UI_DECOR_MENU);
     lv_obj_set_size(menuCont, width, LV_SIZE_CONTENT);
     lv_obj_set_pos(menuCont, x, y);
     lv_obj_set_layout(menuCont, LV_LAYOUT_FLEX);
     lv_obj_set_flex_flow(menuCont, LV_FLEX_FLOW_COLUMN);
     lv_obj_set_flex_align(menuCont, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_row(menuCont, 8, 0);
-    lv_obj_set_style_pad_all(menuCont, 10, 0);
     
     // Titel erstellen
     titleLabel = lv_label_create(menuCont);
-    lv_obj_add_style(titleLabel, &styleMenuTitle, 0);
+    lv_obj_add_style(titleLabel, &uiStyles.menuTitle, 0);
     lv_label_set_text(titleLabel, title);
     
     // Trennlinie nach Titel
     lv_obj_t* line = lv_line_create(menuCont);
     static lv_point_t line_points[] = {{0, 0}, {width - 30, 0}};
     lv_line_set_points(line, line_points, 2);
-    lv_obj_set_style_line_width(line, 2, 0);
-    lv_obj_set_style_line_color(line, lv_color_hex(0x00DDDD), 0);
-    lv_obj_set_style_margin_top(line, 5, 0);
-    lv_obj_set_style_margin_bottom(line, 8, 0);
+    lv_obj_add_style(line, &uiStyles.menuDivider, 0);
+
+    // Einträge folgen auf Titel, Trennlinie und ggf. das Dekorationsbild
+    firstItemIndex = lv_obj_get_child_cnt(menuCont);
   }
   
   /**
@@ -135,11 +129,11 @@ public:
       items[index].text = text;
       
       // Button finden und Text aktualisieren
-      lv_obj_t* btn = lv_obj_get_child(menuCont, index + 2); // +2 wegen Titel und Trennlinie
+      lv_obj_t* btn = lv_obj_get_child(menuCont, firstItemIndex + index);
       if (btn) {
         lv_obj_t* label = lv_obj_get_child(btn, 0);
         if (label) {
-          lv_label_set_text(label, text);
+          uiBindLabelText(label, text);
         }
       }
     }
@@ -164,7 +158,7 @@ public:
   void setItemEnabled(int index, bool enabled) {
     if (index >= 0 && index < items.size()) {
       // Button finden und aktivieren/deaktivieren
-      lv_obj_t* btn = lv_obj_get_child(menuCont, index + 2); // +2 wegen Titel und Trennlinie
+      lv_obj_t* btn = lv_obj_get_child(menuCont, firstItemIndex + index);
       if (btn) {
         lv_obj_set_click(btn, enabled);
         
@@ -178,42 +172,6 @@ public:
   }
   
 private:
-  /**
-   * Initialisiert die Styles für das Menü.
-   */
-  void initStyles() {
-    // Style für Menüeinträge
-    lv_style_init(&styleMenuItem);
-    lv_style_set_width(&styleMenuItem, lv_pct(100));
-    lv_style_set_height(&styleMenuItem, LV_SIZE_CONTENT);
-    lv_style_set_bg_color(&styleMenuItem, lv_color_hex(0x005577));
-    lv_style_set_bg_opa(&styleMenuItem, LV_OPA_70);
-    lv_style_set_border_width(&styleMenuItem, 0);
-    lv_style_set_radius(&styleMenuItem, 10);
-    lv_style_set_pad_all(&styleMenuItem, 10);
-    lv_style_set_text_color(&styleMenuItem, lv_color_hex(0xFFFFFF));
-    
-    // Style für ausgewählte Menüeinträge
-    lv_style_init(&styleMenuItemSelected);
-    lv_style_set_bg_color(&styleMenuItemSelected, lv_color_hex(0x00BBDD));
-    lv_style_set_text_color(&styleMenuItemSelected, lv_color_hex(0xFFFFFF));
-    
-    // Style für den Menü-Container
-    lv_style_init(&styleMenuContainer);
-    lv_style_set_bg_color(&styleMenuContainer, lv_color_hex(0x003344));
-    lv_style_set_bg_opa(&styleMenuContainer, LV_OPA_80);
-    lv_style_set_border_width(&styleMenuContainer, 2);
-    lv_style_set_border_color(&styleMenuContainer, lv_color_hex(0x006688));
-    lv_style_set_radius(&styleMenuContainer, 15);
-    lv_style_set_shadow_width(&styleMenuContainer, 10);
-    lv_style_set_shadow_opa(&styleMenuContainer, LV_OPA_50);
-    
-    // Style für den Menütitel
-    lv_style_init(&styleMenuTitle);
-    lv_style_set_text_font(&styleMenuTitle, &lv_font_montserrat_22);
-    lv_style_set_text_color(&styleMenuTitle, lv_color_hex(0x00DDDD));
-  }
-  
   /**
    * Erstellt einen Button für einen Menüeintrag.
    * 
@@ -222,8 +180,8 @@ private:
    */
   void createMenuButton(const char* text, int index) {
     lv_obj_t* btn = lv_btn_create(menuCont);
-    lv_obj_add_style(btn, &styleMenuItem, 0);
-    lv_obj_add_style(btn, &styleMenuItemSelected, LV_STATE_PRESSED);
+    lv_obj_add_style(btn, &uiStyles.menuItem, 0);
+    lv_obj_add_style(btn, &uiStyles.menuItemSelected, LV_STATE_PRESSED);
     
     lv_obj_t* label = lv_label_create(btn);
     lv_label_set_text(label, text);
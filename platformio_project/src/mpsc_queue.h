@@ -0,0 +1,90 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * Begrenzte lock-freie Warteschlange für beliebig viele Produzenten und genau
+ * einen Konsumenten. Jeder Platz trägt eine Sequenznummer: Produzenten
+ * reservieren einen Platz per compare_exchange auf head und geben ihn nach
+ * dem Schreiben über die Sequenznummer frei, der Konsument liest nur Plätze,
+ * deren Schreiben abgeschlossen ist. Ein Produzent, der mitten im Schreiben
+ * verdrängt wird, hält nur den Konsumenten an diesem Platz auf, andere
+ * Produzenten kommen weiter zum Zug. Die Kapazität muss eine Zweierpotenz sein.
+ */
+template <typename T, uint16_t Capacity>
+class MpscQueue {
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity muss eine Zweierpotenz sein");
+
+private:
+  struct Cell {
+    std::atomic<uint32_t> seq;
+    T item;
+  };
+
+  Cell cells[Capacity];
+  std::atomic<uint32_t> head;  // Nächste Schreibposition (alle Produzenten)
+  std::atomic<uint32_t> tail;  // Nächste Leseposition (nur Konsument)
+
+public:
+  MpscQueue() : head(0), tail(0) {
+    for (uint32_t i = 0; i < Capacity; i++) {
+      cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Legt ein Element ab (aus jedem Task).
+   *
+   * @return false, wenn die Warteschlange voll ist
+   */
+  bool push(const T &item) {
+    uint32_t pos = head.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells[pos & (Capacity - 1)];
+      int32_t diff = (int32_t)(cell->seq.load(std::memory_order_acquire) - pos);
+      if (diff == 0) {
+        // Platz frei: reservieren, bei Konkurrenz mit der neuen Position weiter
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // Der Konsument hat diesen Platz noch nicht geleert
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+    cell->item = item;
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Entnimmt ein Element (nur vom Konsumenten aufrufen).
+   *
+   * @return false, wenn kein fertig geschriebenes Element bereitliegt
+   */
+  bool pop(T &item) {
+    uint32_t pos = tail.load(std::memory_order_relaxed);
+    Cell *cell = &cells[pos & (Capacity - 1)];
+    if ((int32_t)(cell->seq.load(std::memory_order_acquire) - (pos + 1)) < 0) {
+      return false;
+    }
+    item = cell->item;
+    cell->seq.store(pos + Capacity, std::memory_order_release);
+    tail.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * Gibt die Anzahl der reservierten, noch nicht entnommenen Plätze zurück (Momentaufnahme).
+   */
+  uint32_t size() const {
+    uint32_t t = tail.load(std::memory_order_relaxed);  // Zuerst lesen, head kann tail nicht unterschreiten
+    return head.load(std::memory_order_relaxed) - t;
+  }
+};
+
+#endif // MPSC_QUEUE_H
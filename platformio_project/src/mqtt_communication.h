@@ -5,6 +5,9 @@
 #include <PubSubClient.h>
 #include <ArduinoJson.h>
 
+#include "timer_wheel.h"
+#include "mqtt_payload.h"
+
 // MQTT-Verbindungseinstellungen
 #define MQTT_SERVER "mqtt.swissairdry.local"  // MQTT-Server Adresse (ändern Sie dies nach Bedarf)
 #define MQTT_PORT 1883                         // Standard MQTT-Port
@@ -17,9 +20,17 @@
 #define MQTT_TOPIC_COMMAND "swissairdry/desinfektion/command"  // Befehle an das Gerät
 #define MQTT_TOPIC_TELEMETRY "swissairdry/desinfektion/telemetry" // Telemetriedaten vom Gerät
 
+// Abstand der Verbindungsversuche in ms
+#define MQTT_RECONNECT_INTERVAL 5000
+
 // Maximale Puffergröße für JSON-Daten
 #define JSON_BUFFER_SIZE 512
 
+// Sendepuffer je Verbindung für ausgehende Nachrichten (ohne MQTT-Header)
+#ifndef MQTT_PUBLISH_BUFFER_SIZE
+#define MQTT_PUBLISH_BUFFER_SIZE 1024
+#endif
+
 // MQTT-Callbacks
 typedef void (*CommandCallback)(const String &command, const JsonObject &payload);
 
@@ -29,10 +40,16 @@ private:
     PubSubClient mqttClient;
     String clientId;
     bool connected;
-    unsigned long lastReconnectAttempt;
+    bool started;
+    TimerWheel* timers;
+    int reconnectJob;
     
     CommandCallback commandCallback;
     
+    // Nur der Netzwerk-Task sendet, ein Puffer genügt
+    char publishBuffer[MQTT_PUBLISH_BUFFER_SIZE];
+    MqttPublishStats publishStats;
+    
     // MQTT-Callback-Funktion für eingehende Nachrichten
     static void mqttCallback(char* topic, byte* payload, unsigned int length, void* instance) {
         if (instance != nullptr) {
@@ -99,7 +116,8 @@ private:
     }
 
 public:
-    MQTTCommunication() : mqttClient(espClient), connected(false), lastReconnectAttempt(0), commandCallback(nullptr) {
+    MQTTCommunication() : mqttClient(espClient), connected(false), started(false), timers(nullptr), reconnectJob(-1), commandCallback(nullptr) {
+        memset(&publishStats, 0, sizeof(publishStats));
         // Client-ID mit ESP-ID erweitern
         clientId = String(MQTT_CLIENT_ID) + String(ESP.getEfuseMac(), HEX);
     }
@@ -111,21 +129,34 @@ public:
             this->handleCallback(topic, payload, length);
         });
         
-        lastReconnectAttempt = 0;
+        // Ersten Verbindungsversuch sofort starten
+        started = true;
+        if (timers != nullptr) {
+            timers->restart(reconnectJob, 0);
+        }
+    }
+    
+    // Registriert die Verbindungsversuche (alle MQTT_RECONNECT_INTERVAL ms) im Timer-Rad des Netzwerk-Tasks
+    void attachTimers(TimerWheel &wheel) {
+        timers = &wheel;
+        // Wurde begin() schon aufgerufen, sofort den ersten Versuch starten
+        reconnectJob = wheel.every("mqtt_reconnect", MQTT_RECONNECT_INTERVAL, [](void* arg) {
+            ((MQTTCommunication*)arg)->reconnect();
+        }, this, started ? 0 : MQTT_RECONNECT_INTERVAL);
     }
     
-    // Verbindung regelmäßig prüfen und ggf. wiederherstellen
+    // Baut die Verbindung wieder auf, falls begin() aufgerufen wurde und WLAN besteht
+    void reconnect() {
+        if (!started || WiFi.status() != WL_CONNECTED || mqttClient.connected()) {
+            return;
+        }
+        connected = connect();
+    }
+    
+    // Eingehende Nachrichten verarbeiten
     void loop() {
         if (!mqttClient.connected()) {
             connected = false;
-            unsigned long now = millis();
-            if (now - lastReconnectAttempt > 5000) {
-                lastReconnectAttempt = now;
-                if (connect()) {
-                    connected = true;
-                    lastReconnectAttempt = 0;
-                }
-            }
         } else {
             connected = true;
             mqttClient.loop();
@@ -138,51 +169,62 @@ public:
     }
     
     // Veröffentlicht den Status des Geräts
-    bool publishStatus(const String &status) {
-        DynamicJsonDocument doc(JSON_BUFFER_SIZE);
-        doc["status"] = status;
-        doc["device_id"] = clientId;
-        doc["timestamp"] = millis();
-        
-        String jsonStr;
-        serializeJson(doc, jsonStr);
-        
-        return mqttClient.publish(MQTT_TOPIC_STATUS, jsonStr.c_str());
+    bool publishStatus(const char* status) {
+        return publish(MQTT_TOPIC_STATUS, status, JsonObjectConst());
     }
     
     // Veröffentlicht detaillierte Statusinformationen
-    bool publishDetailedStatus(const String &status, const JsonObject &details) {
-        DynamicJsonDocument doc(JSON_BUFFER_SIZE);
-        doc["status"] = status;
-        doc["device_id"] = clientId;
-        doc["timestamp"] = millis();
-        
-        // Details hinzufügen
-        for (JsonPair p : details) {
-            doc[p.key().c_str()] = p.value();
-        }
-        
-        String jsonStr;
-        serializeJson(doc, jsonStr);
-        
-        return mqttClient.publish(MQTT_TOPIC_STATUS, jsonStr.c_str());
+    bool publishDetailedStatus(const char* status, JsonObjectConst details) {
+        return publish(MQTT_TOPIC_STATUS, status, details);
     }
     
     // Veröffentlicht Telemetriedaten
-    bool publishTelemetry(const JsonObject &data) {
-        DynamicJsonDocument doc(JSON_BUFFER_SIZE);
-        doc["device_id"] = clientId;
-        doc["timestamp"] = millis();
-        
-        // Telemetriedaten hinzufügen
-        for (JsonPair p : data) {
-            doc[p.key().c_str()] = p.value();
+    bool publishTelemetry(JsonObjectConst data) {
+        return publish(MQTT_TOPIC_TELEMETRY, nullptr, data);
+    }
+    
+    /**
+     * Setzt die Nachricht im Sendepuffer zusammen und sendet sie mit
+     * beginPublish()/write()/endPublish(), ohne Heap und ohne Umweg über
+     * den internen Puffer von PubSubClient (Standard 256 Bytes).
+     *
+     * @param topic Ziel-Topic
+     * @param status Statustext oder nullptr
+     * @param details Nutzdaten, werden hinter device_id und timestamp angefügt
+     * @return true, wenn die Nachricht gesendet wurde
+     */
+    bool publish(const char* topic, const char* status, JsonObjectConst details) {
+        uint32_t start = micros();
+        size_t length = mqttComposePayload(publishBuffer, sizeof(publishBuffer), status, clientId.c_str(), millis(), details);
+        if (length == 0) {
+            publishStats.oversize++;
+            return false;
         }
         
-        String jsonStr;
-        serializeJson(doc, jsonStr);
+        bool sent = mqttClient.beginPublish(topic, length, false) &&
+                    mqttClient.write((const uint8_t*)publishBuffer, length) == length &&
+                    mqttClient.endPublish();
         
-        return mqttClient.publish(MQTT_TOPIC_TELEMETRY, jsonStr.c_str());
+        uint32_t elapsed = micros() - start;
+        if (!sent) {
+            publishStats.failed++;
+            return false;
+        }
+        publishStats.published++;
+        publishStats.bytes += length;
+        publishStats.totalUs += elapsed;
+        if (length > publishStats.maxBytes) {
+            publishStats.maxBytes = length;
+        }
+        if (elapsed > publishStats.maxUs) {
+            publishStats.maxUs = elapsed;
+        }
+        return true;
+    }
+    
+    // Zähler der gesendeten Nachrichten
+    const MqttPublishStats &getPublishStats() {
+        return publishStats;
     }
     
     // Prüft, ob eine Verbindung zum MQTT-Server besteht
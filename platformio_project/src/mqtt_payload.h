@@ -0,0 +1,67 @@
+#ifndef MQTT_PAYLOAD_H
+#define MQTT_PAYLOAD_H
+
+#include <ArduinoJson.h>
+#include <stdint.h>
+
+// Kopf jeder Nachricht: status (optional), device_id, timestamp
+#define MQTT_PAYLOAD_HEADER_CAPACITY JSON_OBJECT_SIZE(3)
+
+/**
+ * Zähler der gesendeten Nachrichten seit dem Start.
+ * oversize zählt Nachrichten, die nicht in den Sendepuffer passten und
+ * deshalb nicht gesendet wurden.
+ */
+struct MqttPublishStats {
+  uint32_t published;
+  uint32_t failed;
+  uint32_t oversize;
+  uint32_t bytes;
+  uint32_t maxBytes;
+  uint32_t totalUs;  // Zusammensetzen und Senden
+  uint32_t maxUs;
+};
+
+/**
+ * Setzt eine Nachricht aus Kopf und Nutzdaten in einen vorhandenen Puffer
+ * zusammen, ohne Heap: Der Kopf liegt in einem StaticJsonDocument auf dem
+ * Stack, die Nutzdaten werden direkt hinter ihn serialisiert statt Paar für
+ * Paar in ein zweites Dokument kopiert. Ergebnis:
+ * {"status":...,"device_id":...,"timestamp":...,<Felder von details>}
+ * Hardwarefrei, damit der native Benchmark denselben Pfad misst.
+ *
+ * @param buffer Zielpuffer (wird nullterminiert)
+ * @param size Größe des Zielpuffers
+ * @param status Statustext oder NULL (Telemetrie)
+ * @param deviceId Geräte-ID
+ * @param timestamp Zeitstempel in ms
+ * @param details Nutzdaten (darf leer oder null sein)
+ * @return Länge der Nachricht, 0 wenn sie nicht in den Puffer passt
+ */
+inline size_t mqttComposePayload(char* buffer, size_t size, const char* status, const char* deviceId,
+                                 uint32_t timestamp, JsonObjectConst details) {
+  StaticJsonDocument<MQTT_PAYLOAD_HEADER_CAPACITY> header;
+  if (status != NULL) {
+    header["status"] = status;
+  }
+  header["device_id"] = deviceId;
+  header["timestamp"] = timestamp;
+
+  // {kopf} und {details} ergeben {kopf,details}; leere Details fallen weg
+  size_t headerLength = measureJson(header);
+  size_t detailsLength = (details.isNull() || details.size() == 0) ? 0 : measureJson(details);
+  size_t length = detailsLength > 0 ? headerLength + detailsLength - 1 : headerLength;
+  if (length + 1 > size) {
+    return 0;
+  }
+
+  serializeJson(header, buffer, size);
+  if (detailsLength > 0) {
+    // Die Details ab der schließenden Klammer des Kopfes schreiben, ihre öffnende wird zum Komma
+    serializeJson(details, buffer + headerLength - 1, size - headerLength + 1);
+    buffer[headerLength - 1] = ',';
+  }
+  return length;
+}
+
+#endif // MQTT_PAYLOAD_H
@@ -0,0 +1,49 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+/**
+ * Minimaler Arduino-Ersatz für den nativen Build (env:native).
+ * Stellt nur das bereit, was die UI-Module und LVGL (LV_TICK_CUSTOM)
+ * tatsächlich verwenden: Zeitfunktionen und eine schlanke String-Klasse.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+inline uint32_t micros() {
+  static const auto start = std::chrono::steady_clock::now();
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
+inline uint32_t millis() {
+  return micros() / 1000;
+}
+
+inline void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+class String : public std::string {
+public:
+  String() {}
+  String(const char *s) : std::string(s ? s : "") {}
+  String(const std::string &s) : std::string(s) {}
+  String(int value) : std::string(std::to_string(value)) {}
+  String(unsigned int value) : std::string(std::to_string(value)) {}
+  String(long value) : std::string(std::to_string(value)) {}
+  String(unsigned long value) : std::string(std::to_string(value)) {}
+
+  String operator+(const String &other) const {
+    return String(static_cast<const std::string &>(*this) + other);
+  }
+  String operator+(const char *other) const {
+    return String(static_cast<const std::string &>(*this) + other);
+  }
+};
+
+#endif // NATIVE_ARDUINO_H
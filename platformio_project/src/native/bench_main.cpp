@@ -0,0 +1,731 @@
+/*
+ * Nativer Render-Benchmark für die LVGL-Bildschirme
+ *
+ * Baut die Bildschirme aus ui_screens.h auf dem Host (env:native) und
+ * rendert sie in einen Framebuffer im Arbeitsspeicher statt über TFT_eSPI.
+ * Pro Bildschirm werden gemessen:
+ * - Erstellungszeit (create*Screen)
+ * - Renderzeit des ersten Frames (komplettes Neuzeichnen)
+ * - Renderzeit im Dauerbetrieb (periodisches Update + Refresh)
+ * - Belegter LVGL-Heap
+ * - Lokale Styles und deren Heap-Bedarf (siehe ui_styles.h)
+ * Zusätzlich wird die Glyphen-Suchzeit je Schrift gemessen (siehe ui_fonts.h)
+ * und der RGB565-Byte-Tausch des Flush-Pfads verglichen (siehe rgb565_swap.h).
+ * Der Programmauswahl-Bildschirm wird mit gezeichneter und mit vorgerenderter
+ * Button-Dekoration verglichen (siehe ui_decor.h).
+ * Das Fortschritts-Widget (siehe ui_progress.h) wird schrittweise gefüllt
+ * und mit lv_bar verglichen. Die Bilder aus tools/image_assets.py werden
+ * mit und ohne LVGL-Bildcache gezeichnet (siehe ui_images.h).
+ * Abschließend läuft der Laufbildschirm über ein nachgebildetes RGB-Panel
+ * (Direct Mode, zwei Framebuffer, siehe rgb_framebuffer.h und mock_panel.h).
+ * Außerdem wird das Zusammensetzen einer MQTT-Telemetrie-Nachricht mit dem
+ * früheren Weg (DynamicJsonDocument, Kopie der Paare, String) verglichen und
+ * die Heap-Anforderungen je Nachricht gezählt (siehe mqtt_payload.h).
+ *
+ * Aufruf: pio run -e native && .pio/build/native/program [Wiederholungen]
+ */
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <lvgl.h>
+#include <stdlib.h>
+#include <string>
+
+#include "../system_state.h"
+#include "../ui_screens.h"
+#include "../rgb565_swap.h"
+#include "../mqtt_payload.h"
+#include "mock_panel.h"
+
+#define SCREEN_WIDTH  800
+#define SCREEN_HEIGHT 480
+
+// Gleiche Puffergröße wie in der Firmware (siehe platformio.ini)
+#ifndef LVGL_BUFFER_LINES
+#define LVGL_BUFFER_LINES 10
+#endif
+#define LVGL_BUFFER_SIZE (SCREEN_WIDTH * LVGL_BUFFER_LINES)
+
+// Standard-Anzahl der Refreshs für die Dauerbetriebsmessung
+#define BENCH_DEFAULT_ITERATIONS 50
+
+// Durchläufe für die Glyphen-Suchzeit
+#define BENCH_GLYPH_ROUNDS 2000
+
+// Durchläufe für den Byte-Tausch
+#define BENCH_SWAP_ROUNDS 200
+
+// Kindindex des Buttons "Programm 1" auf dem Programmauswahl-Bildschirm (nach dem Titel)
+#define BENCH_PROGRAM_BUTTON_INDEX 1
+
+// Wertschritte für den Fortschritts-Vergleich
+#define BENCH_PROGRESS_STEPS 1000
+
+// Durchläufe für den MQTT-Vergleich
+#define BENCH_MQTT_ROUNDS 10000
+
+// Kapazität der JSON-Dokumente im MQTT-Vergleich. Entspricht den 512 Bytes der
+// Firmware; die Slots sind auf 64-Bit-Hosts doppelt so groß wie auf dem ESP32.
+#define BENCH_MQTT_DOC_SIZE (JSON_OBJECT_SIZE(24) + 128)
+
+// Typischer UI-Text für die Glyphen-Suche
+static const char *glyphSample = "Tankfüllstand: OK Zurück Hauptmenü Programm läuft 12:34:56 100%";
+
+SystemState systemState;
+
+// Simulierte Uhr für Programmlaufzeiten (Sekunden)
+static uint32_t simulatedEpoch = 1700000000;
+
+// In-Memory-Framebuffer anstelle des Displays
+static lv_color_t framebuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+static lv_disp_draw_buf_t drawBuffer;
+static lv_color_t buf1[LVGL_BUFFER_SIZE];
+static lv_color_t buf2[LVGL_BUFFER_SIZE];
+static lv_disp_drv_t dispDriver;
+static lv_disp_t *display;
+
+// Zähler für den Flush-Pfad
+static uint32_t flushedPixels = 0;
+
+// Kopiert den gerenderten Bereich in den Framebuffer
+void benchFlushCb(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
+  uint32_t w = (area->x2 - area->x1 + 1);
+
+  for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+    memcpy(&framebuffer[y * SCREEN_WIDTH + area->x1], color_p, w * sizeof(lv_color_t));
+    color_p += w;
+  }
+  flushedPixels += w * (area->y2 - area->y1 + 1);
+
+  lv_disp_flush_ready(disp);
+}
+
+// Stubs für die Anwendungsfunktionen, die die Bildschirme aufrufen
+void startProgram(int programIndex) {
+  systemState.activeProgram = programIndex;
+  systemState.programDuration = (programIndex == 4 ? systemState.customDays : programIndex * 7) * 24 * 60 * 60;
+  systemState.state = RUNNING;
+  systemState.startTime = simulatedEpoch;
+  systemState.motorActive = true;
+  publishSystemState();
+}
+
+void stopProgram() {
+  systemState.state = IDLE;
+  systemState.motorActive = false;
+  publishSystemState();
+}
+
+void setCustomDays(int days) {
+  systemState.customDays = days;
+  publishSystemState();
+}
+
+void setRemoteControl(bool enabled) {
+  systemState.remoteControlEnabled = enabled;
+  publishSystemState();
+}
+
+SystemStateSnapshot getSystemSnapshot() {
+  SystemStateSnapshot snap;
+  snap.version = systemStateSeqlock.read(snap);
+  snap.now = simulatedEpoch;
+  return snap;
+}
+
+void resetWiFiConfig() {
+}
+
+// Beschreibung eines zu messenden Bildschirms
+struct BenchScreen {
+  const char *name;
+  void (*create)();
+  lv_obj_t **screen;
+  void (*periodicUpdate)(); // NULL für statische Bildschirme
+};
+
+// Periodisches Update des Laufbildschirms wie in loop(): eine Sekunde pro Aufruf
+void benchRunningUpdate() {
+  simulatedEpoch += 1;
+  updateRunningScreen();
+}
+
+// Ergebnisse einer Messung
+struct BenchResult {
+  uint32_t createUs;
+  uint32_t firstFrameUs;
+  uint32_t steadyUs;
+  uint32_t steadyPixels;
+  uint32_t heapBytes;
+  UiStyleReport styles;
+};
+
+// Gesamten LVGL-Heap-Verbrauch ermitteln
+static uint32_t lvglHeapUsed() {
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);
+  return mon.total_size - mon.free_size;
+}
+
+BenchResult benchScreen(const BenchScreen &entry, int iterations) {
+  BenchResult result;
+
+  // Erstellung
+  uint32_t heapBefore = lvglHeapUsed();
+  uint32_t t0 = micros();
+  entry.create();
+  result.createUs = micros() - t0;
+  result.heapBytes = lvglHeapUsed() - heapBefore;
+  result.styles = UiStyleReport();
+  uiStyleReport(*entry.screen, result.styles);
+
+  // Erster Frame: komplettes Neuzeichnen nach dem Laden
+  lv_scr_load(*entry.screen);
+  lv_obj_invalidate(*entry.screen);
+  t0 = micros();
+  lv_refr_now(display);
+  result.firstFrameUs = micros() - t0;
+
+  // Dauerbetrieb: periodisches Update und anschließender Refresh
+  flushedPixels = 0;
+  t0 = micros();
+  for (int i = 0; i < iterations; i++) {
+    if (entry.periodicUpdate) {
+      entry.periodicUpdate();
+    }
+    lv_timer_handler();
+    lv_refr_now(display);
+  }
+  result.steadyUs = (micros() - t0) / iterations;
+  result.steadyPixels = flushedPixels / iterations;
+
+  return result;
+}
+
+// Mittlere Zeit pro Glyphen-Suche (lv_font_get_glyph_dsc) in ns
+static uint32_t benchGlyphLookup(const lv_font_t *font) {
+  uint32_t lookups = 0;
+  lv_font_glyph_dsc_t dsc;
+  uint32_t t0 = micros();
+  for (int round = 0; round < BENCH_GLYPH_ROUNDS; round++) {
+    uint32_t i = 0;
+    uint32_t letter = _lv_txt_encoded_next(glyphSample, &i);
+    while (letter != 0) {
+      uint32_t next = _lv_txt_encoded_next(glyphSample, &i);
+      lv_font_get_glyph_dsc(font, &dsc, letter, next);
+      letter = next;
+      lookups++;
+    }
+  }
+  return (uint64_t)(micros() - t0) * 1000 / lookups;
+}
+
+// Mittlere Zeit für den Byte-Tausch eines Flushs mit der angegebenen Pixelzahl in us
+static uint32_t benchSwap(void (*swap)(uint16_t *, uint32_t), uint32_t pixels) {
+  uint16_t *buf = (uint16_t *)framebuffer;
+  uint32_t t0 = micros();
+  for (int round = 0; round < BENCH_SWAP_ROUNDS; round++) {
+    swap(buf, pixels);
+  }
+  return (micros() - t0) / BENCH_SWAP_ROUNDS;
+}
+
+// Variante ohne Tausch (LV_COLOR_16_SWAP=1): LVGL rendert bereits in SPI-Reihenfolge
+static void swapNone(uint16_t *, uint32_t) {
+}
+
+// Ergebnisse des Dekorationsvergleichs
+struct DecorResult {
+  uint32_t createUs;
+  uint32_t firstFrameUs;
+  uint32_t pressUs;      // Refresh nach Drücken bzw. Loslassen eines Buttons
+  uint32_t pressPixels;
+};
+
+// Programmauswahl mit gezeichneter oder vorgerenderter Button-Dekoration messen
+static DecorResult benchProgramDecor(bool cached, int iterations) {
+  DecorResult result;
+  uiDecorCache.setEnabled(cached);
+
+  uint32_t t0 = micros();
+  createProgramScreen();
+  result.createUs = micros() - t0;
+
+  lv_scr_load(programScreen);
+  lv_obj_invalidate(programScreen);
+  t0 = micros();
+  lv_refr_now(display);
+  result.firstFrameUs = micros() - t0;
+
+  // Drücken und Loslassen wie durch den Touch-Treiber
+  lv_obj_t *btn = lv_obj_get_child(programScreen, BENCH_PROGRAM_BUTTON_INDEX);
+  flushedPixels = 0;
+  t0 = micros();
+  for (int i = 0; i < iterations; i++) {
+    lv_obj_add_state(btn, LV_STATE_PRESSED);
+    lv_event_send(btn, LV_EVENT_PRESSED, NULL);
+    lv_refr_now(display);
+    lv_obj_clear_state(btn, LV_STATE_PRESSED);
+    lv_event_send(btn, LV_EVENT_RELEASED, NULL);
+    lv_refr_now(display);
+  }
+  result.pressUs = (micros() - t0) / (iterations * 2);
+  result.pressPixels = flushedPixels / (iterations * 2);
+
+  lv_scr_load(mainScreen);
+  lv_obj_del(programScreen);
+  programScreen = NULL;
+  return result;
+}
+
+// Ergebnisse des Fortschritts-Vergleichs
+struct ProgressResult {
+  uint32_t stepUs;
+  uint32_t stepPixels;
+  bool matchesFullRedraw;  // Inkrementelles Ergebnis gleich vollständigem Neuzeichnen
+};
+
+// Fortschrittsanzeige in BENCH_PROGRESS_STEPS Schritten füllen, je Schritt ein Refresh
+static ProgressResult benchProgress(ProgressBarType type, bool lvBar) {
+  ProgressResult result;
+  lv_obj_t *screen = lv_obj_create(NULL);
+  lv_obj_add_style(screen, &uiStyles.screen, 0);
+
+  lv_obj_t *progress;
+  if (lvBar) {
+    progress = lv_bar_create(screen);
+    lv_obj_add_style(progress, &uiStyles.barBg, LV_PART_MAIN);
+    lv_obj_add_style(progress, &uiStyles.barIndicator, LV_PART_INDICATOR);
+    lv_bar_set_range(progress, 0, BENCH_PROGRESS_STEPS);
+  } else {
+    progress = uiProgressCreate(screen, type);
+    uiProgressSetRange(progress, 0, BENCH_PROGRESS_STEPS);
+  }
+  if (type == BAR_HORIZONTAL) {
+    lv_obj_set_size(progress, 700, 30);
+  } else if (type == BAR_VERTICAL) {
+    lv_obj_set_size(progress, 30, 400);
+  } else {
+    lv_obj_set_size(progress, 240, 240);
+  }
+  lv_obj_center(progress);
+
+  lv_scr_load(screen);
+  lv_refr_now(display);
+
+  flushedPixels = 0;
+  uint32_t t0 = micros();
+  for (int32_t value = 1; value <= BENCH_PROGRESS_STEPS; value++) {
+    if (lvBar) {
+      lv_bar_set_value(progress, value, LV_ANIM_OFF);
+    } else {
+      uiProgressSetValue(progress, value, LV_ANIM_OFF);
+    }
+    lv_refr_now(display);
+  }
+  result.stepUs = (micros() - t0) / BENCH_PROGRESS_STEPS;
+  result.stepPixels = flushedPixels / BENCH_PROGRESS_STEPS;
+
+  // Angezeigtes Bild mit einem vollständig neu gezeichneten Frame vergleichen
+  lv_color_t *incremental = (lv_color_t *)malloc(sizeof(framebuffer));
+  memcpy(incremental, framebuffer, sizeof(framebuffer));
+  lv_obj_invalidate(screen);
+  lv_refr_now(display);
+  result.matchesFullRedraw = memcmp(incremental, framebuffer, sizeof(framebuffer)) == 0;
+  free(incremental);
+
+  lv_scr_load(mainScreen);
+  lv_obj_del(screen);
+  return result;
+}
+
+#if UI_IMAGE_ASSETS
+// Ergebnisse der Bildmessung
+struct ImageResult {
+  uint32_t redrawUs;   // Refresh nach Invalidierung des Bildes
+  uint32_t decodes;    // Auspackvorgänge während der Messung
+};
+
+// Bild wiederholt invalidieren und zeichnen. Ohne Cache wird der Bildcache-Eintrag
+// vor jedem Refresh verworfen, das Bild also mindestens einmal je Refresh ausgepackt.
+static ImageResult benchImage(const lv_img_dsc_t *src, bool cached, int iterations) {
+  ImageResult result;
+  lv_obj_t *screen = lv_obj_create(NULL);
+  lv_obj_add_style(screen, &uiStyles.screen, 0);
+  lv_obj_t *img = uiImageCreate(screen, src);
+  lv_obj_center(img);
+  lv_scr_load(screen);
+  lv_refr_now(display);
+
+  uint32_t decodesBefore = uiImageStats.decodes;
+  uint32_t t0 = micros();
+  for (int i = 0; i < iterations; i++) {
+    if (!cached) {
+      lv_img_cache_invalidate_src(src);
+    }
+    lv_obj_invalidate(img);
+    lv_refr_now(display);
+  }
+  result.redrawUs = (micros() - t0) / iterations;
+  result.decodes = uiImageStats.decodes - decodesBefore;
+
+  lv_scr_load(mainScreen);
+  lv_obj_del(screen);
+  return result;
+}
+#endif
+
+// Ergebnisse des RGB-Panel-Durchlaufs
+struct RgbPanelResult {
+  uint32_t steadyUs;
+  uint32_t syncedPixels;   // Pro Refresh in den anderen Puffer kopiert
+  uint32_t presents;
+  uint32_t outOfSync;      // Refreshs, nach denen die Framebuffer abwichen
+  bool matchesFullRedraw;  // Inkrementelles Ergebnis gleich vollständigem Neuzeichnen
+};
+
+// Laufbildschirm auf einem zweiten Display über das nachgebildete RGB-Panel rendern
+static RgbPanelResult benchRgbPanel(int iterations) {
+  static MockRgbPanel panel;
+  static lv_disp_drv_t panelDriver;
+  RgbPanelResult result = {};
+
+  lv_disp_drv_init(&panelDriver);
+  panel.begin(SCREEN_WIDTH, SCREEN_HEIGHT, &panelDriver);
+  lv_disp_t *panelDisplay = lv_disp_drv_register(&panelDriver);
+  lv_disp_set_default(panelDisplay);
+
+  createRunningScreen();
+  lv_scr_load(runningScreen);
+  lv_refr_now(panelDisplay);
+
+  RgbFramebufferSync &sync = panel.getSync();
+  uint32_t syncedBefore = sync.getSyncedPixels();
+  uint32_t presentsBefore = sync.getPresentCount();
+  uint32_t t0 = micros();
+  for (int i = 0; i < iterations; i++) {
+    benchRunningUpdate();
+    lv_refr_now(panelDisplay);
+    if (!panel.buffersInSync()) {
+      result.outOfSync++;
+    }
+  }
+  result.steadyUs = (micros() - t0) / iterations;
+  result.presents = sync.getPresentCount() - presentsBefore;
+  result.syncedPixels = (sync.getSyncedPixels() - syncedBefore) / iterations;
+
+  // Angezeigtes Bild mit einem vollständig neu gezeichneten Frame vergleichen
+  size_t bytes = panel.getScanoutBytes();
+  lv_color_t *incremental = (lv_color_t *)malloc(bytes);
+  memcpy(incremental, panel.getScanout(), bytes);
+  lv_obj_invalidate(runningScreen);
+  lv_refr_now(panelDisplay);
+  result.matchesFullRedraw = memcmp(incremental, panel.getScanout(), bytes) == 0 &&
+                             panel.getForeignPresents() == 0;
+  free(incremental);
+
+  lv_disp_set_default(display);
+  return result;
+}
+
+// Heap-Anforderungen (malloc, calloc, realloc und damit new) für den MQTT-Vergleich
+static uint32_t heapAllocs = 0;
+static uint64_t heapAllocBytes = 0;
+
+#if defined(__GLIBC__)
+// Die glibc-Funktionen abfangen, der Benchmark läuft in einem Thread
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+extern "C" void *malloc(size_t size) {
+  heapAllocs++;
+  heapAllocBytes += size;
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+  heapAllocs++;
+  heapAllocBytes += count * size;
+  return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) {
+  heapAllocs++;
+  heapAllocBytes += size;
+  return __libc_realloc(ptr, size);
+}
+#endif
+
+// Geräte-ID wie in der Firmware (Basis + MAC), länger als die Small-String-Optimierung
+static const std::string benchDeviceId = "desinfektion_3c71bf4a2b10";
+
+// Telemetriefelder wie in sendTelemetry()
+static void benchTelemetryFields(JsonDocument &doc, uint32_t round) {
+  static const char *tasks[] = {"control", "ui", "net"};
+  doc["state"] = 1;
+  doc["program"] = 2;
+  doc["remaining_time"] = 1209600 - round;
+  doc["progress"] = round % 100;
+  doc["tank_level_ok"] = true;
+  doc["uptime"] = 3600 + round;
+  doc["journal_wa"] = 0.25f;
+  doc["wifi_connect_ms"] = 2140;
+  doc["ui_skipped_updates"] = 1234;
+  doc["display_active_s"] = 815;
+  doc["display_idle_s"] = 2785;
+  doc["display_px_per_s"] = 1843200;
+  doc["touch_irqs"] = 42;
+  doc["touch_samples"] = 640;
+  doc["mqtt_max_bytes"] = 512;
+  char loadKey[24];
+  for (uint32_t i = 0; i < 3; i++) {
+    snprintf(loadKey, sizeof(loadKey), "load_%s", tasks[i]);
+    doc[loadKey] = 10 + i;
+  }
+}
+
+// Früherer Weg: Dokumente im Heap, jedes Paar kopiert, Ergebnis als String
+static size_t benchMqttLegacy(std::string &payload, uint32_t round) {
+  DynamicJsonDocument telemetryDoc(BENCH_MQTT_DOC_SIZE);
+  benchTelemetryFields(telemetryDoc, round);
+  JsonObject data = telemetryDoc.as<JsonObject>();
+
+  DynamicJsonDocument doc(BENCH_MQTT_DOC_SIZE);
+  doc["device_id"] = benchDeviceId;
+  doc["timestamp"] = round;
+  for (JsonPair p : data) {
+    doc[p.key().c_str()] = p.value();
+  }
+
+  std::string jsonStr;
+  serializeJson(doc, jsonStr);
+  payload = jsonStr;
+  return jsonStr.size();
+}
+
+// Neuer Weg: Dokument auf dem Stack, direkt in den Sendepuffer (wie MQTTCommunication::publish)
+static size_t benchMqttComposed(char *buffer, size_t size, uint32_t round) {
+  StaticJsonDocument<BENCH_MQTT_DOC_SIZE> telemetryDoc;
+  benchTelemetryFields(telemetryDoc, round);
+  return mqttComposePayload(buffer, size, NULL, benchDeviceId.c_str(), round,
+                            telemetryDoc.as<JsonObjectConst>());
+}
+
+// Ergebnisse des MQTT-Vergleichs
+struct MqttResult {
+  uint32_t bytes;
+  uint32_t messageNs;
+  uint32_t allocsPerMessage;
+  uint32_t allocBytesPerMessage;
+};
+
+static MqttResult benchMqtt(bool composed, std::string &lastPayload) {
+  static char buffer[1024];
+  MqttResult result = {};
+  std::string payload;
+  payload.reserve(sizeof(buffer));
+
+  uint32_t allocsBefore = heapAllocs;
+  uint64_t bytesBefore = heapAllocBytes;
+  uint32_t t0 = micros();
+  for (uint32_t round = 0; round < BENCH_MQTT_ROUNDS; round++) {
+    if (composed) {
+      result.bytes = benchMqttComposed(buffer, sizeof(buffer), round);
+    } else {
+      result.bytes = benchMqttLegacy(payload, round);
+    }
+  }
+  result.messageNs = (uint32_t)((uint64_t)(micros() - t0) * 1000 / BENCH_MQTT_ROUNDS);
+  result.allocsPerMessage = (heapAllocs - allocsBefore) / BENCH_MQTT_ROUNDS;
+  result.allocBytesPerMessage = (uint32_t)((heapAllocBytes - bytesBefore) / BENCH_MQTT_ROUNDS);
+  lastPayload = composed ? std::string(buffer, result.bytes) : payload;
+  return result;
+}
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : BENCH_DEFAULT_ITERATIONS;
+  if (iterations <= 0) {
+    iterations = BENCH_DEFAULT_ITERATIONS;
+  }
+
+  // System-Status wie in setup() initialisieren
+  systemState.state = IDLE;
+  systemState.activeProgram = 2;
+  systemState.programDuration = 14 * 24 * 60 * 60;
+  systemState.customDays = 7;
+  systemState.tankLevelOk = true;
+  systemState.motorActive = false;
+  systemState.remoteControlEnabled = true;
+  systemState.deviceId = "desinfektion_native";
+  publishSystemState();
+
+  lv_init();
+  uiStylesInit();
+  uiImagesInit();
+
+  lv_disp_draw_buf_init(&drawBuffer, buf1, buf2, LVGL_BUFFER_SIZE);
+  lv_disp_drv_init(&dispDriver);
+  dispDriver.hor_res = SCREEN_WIDTH;
+  dispDriver.ver_res = SCREEN_HEIGHT;
+  dispDriver.flush_cb = benchFlushCb;
+  dispDriver.draw_buf = &drawBuffer;
+  display = lv_disp_drv_register(&dispDriver);
+
+  const BenchScreen screens[] = {
+    {"main",      createMainScreen,      &mainScreen,      NULL},
+    {"program",   createProgramScreen,   &programScreen,   NULL},
+    {"settings",  createSettingsScreen,  &settingsScreen,  NULL},
+    {"running",   createRunningScreen,   &runningScreen,   benchRunningUpdate},
+    {"completed", createCompletedScreen, &completedScreen, NULL},
+    {"error",     createErrorScreen,     &errorScreen,     NULL},
+  };
+
+  // Laufbildschirm mit aktivem Programm messen
+  startProgram(2);
+
+  printf("LVGL-Render-Benchmark (%dx%d, Puffer %d Zeilen, %d Refreshs)\n",
+         SCREEN_WIDTH, SCREEN_HEIGHT, LVGL_BUFFER_LINES, iterations);
+  printf("%-10s %12s %14s %12s %14s %10s %12s %12s %14s\n",
+         "screen", "create_us", "first_frame_us", "steady_us", "steady_px", "heap_b",
+         "local_styles", "local_b", "shared_as_lb");
+
+  UiStyleReport styleTotal = {};
+  for (const BenchScreen &entry : screens) {
+    BenchResult r = benchScreen(entry, iterations);
+    printf("%-10s %12u %14u %12u %14u %10u %12u %12u %14u\n",
+           entry.name, r.createUs, r.firstFrameUs, r.steadyUs, r.steadyPixels, r.heapBytes,
+           r.styles.localStyles, r.styles.localBytes, r.styles.sharedAsLocalBytes);
+    styleTotal.localStyles += r.styles.localStyles;
+    styleTotal.localBytes += r.styles.localBytes;
+    styleTotal.sharedRefs += r.styles.sharedRefs;
+    styleTotal.sharedAsLocalBytes += r.styles.sharedAsLocalBytes;
+  }
+
+  // shared_as_lb: Heap, den die Registry-Referenzen als lokale Styles belegen würden
+  printf("Styles: %u lokal (%u Bytes), %u Registry-Referenzen (als lokale Styles %u Bytes)\n",
+         styleTotal.localStyles, styleTotal.localBytes,
+         styleTotal.sharedRefs, styleTotal.sharedAsLocalBytes);
+
+  printf("Widget-Updates: %u geändert, %u ohne Invalidierung übersprungen\n",
+         uiBindingStats.updated, uiBindingStats.skipped);
+
+  const struct {
+    const char *name;
+    ProgressBarType type;
+    bool lvBar;
+  } progressVariants[] = {
+    {"lv_bar", BAR_HORIZONTAL, true},
+    {"horizontal", BAR_HORIZONTAL, false},
+    {"vertikal", BAR_VERTICAL, false},
+    {"ring", BAR_CIRCULAR, false},
+    {"bogen", BAR_ARC, false},
+  };
+  bool progressOk = true;
+  printf("Fortschrittsanzeige (%d Schritte, je ein Refresh):\n", BENCH_PROGRESS_STEPS);
+  printf("%-14s %12s %12s %16s\n", "variante", "step_us", "step_px", "bild");
+  for (const auto &v : progressVariants) {
+    ProgressResult r = benchProgress(v.type, v.lvBar);
+    printf("%-14s %12u %12u %16s\n", v.name, r.stepUs, r.stepPixels,
+           r.matchesFullRedraw ? "wie Neuzeichnen" : "ABWEICHEND");
+    progressOk = progressOk && r.matchesFullRedraw;
+  }
+  printf("Fortschritts-Widgets: %u Verschiebungen (%u animiert), %u unter einem Pixel\n",
+         uiProgressStats.moved, uiProgressStats.animated, uiProgressStats.subPixel);
+
+  const struct {
+    int size;
+    const lv_font_t *font;
+  } fonts[] = {
+    {14, UI_FONT_14}, {16, UI_FONT_16}, {18, UI_FONT_18}, {20, UI_FONT_20},
+    {22, UI_FONT_22}, {28, UI_FONT_28}, {48, UI_FONT_48},
+  };
+  printf("Glyphen-Suche (%s):", UI_FONT_SUBSET ? "Teilschriften" : "Standardschriften");
+  for (const auto &f : fonts) {
+    printf(" %dpx %u ns", f.size, benchGlyphLookup(f.font));
+  }
+  printf("\n");
+
+  const struct {
+    const char *name;
+    void (*swap)(uint16_t *, uint32_t);
+  } swaps[] = {
+    {"skalar", rgb565SwapScalar},
+    {"32-Bit", rgb565Swap},
+    {"vorgetauscht", swapNone},
+  };
+  printf("RGB565-Byte-Tausch (us pro Flush, Streifen %dx%d, Vollbild %dx%d):\n",
+         SCREEN_WIDTH, LVGL_BUFFER_LINES, SCREEN_WIDTH, SCREEN_HEIGHT);
+  printf("%-14s %14s %14s\n", "variante", "streifen_us", "vollbild_us");
+  for (const auto &v : swaps) {
+    printf("%-14s %14u %14u\n", v.name,
+           benchSwap(v.swap, SCREEN_WIDTH * LVGL_BUFFER_LINES),
+           benchSwap(v.swap, SCREEN_WIDTH * SCREEN_HEIGHT));
+  }
+
+  const struct {
+    const char *name;
+    bool cached;
+  } decorVariants[] = {
+    {"styles", false},
+    {"bilder_kalt", true},  // Bilder werden beim Aufbau gerendert
+    {"bilder_warm", true},  // Bilder kommen aus dem Cache
+  };
+  printf("Button-Dekoration (Programmauswahl, %d x Drücken/Loslassen):\n", iterations);
+  printf("%-14s %12s %14s %12s %12s\n", "variante", "create_us", "first_frame_us", "press_us", "press_px");
+  for (const auto &v : decorVariants) {
+    DecorResult r = benchProgramDecor(v.cached, iterations);
+    printf("%-14s %12u %14u %12u %12u\n", v.name, r.createUs, r.firstFrameUs, r.pressUs, r.pressPixels);
+  }
+  const UiDecorCache::Stats &decor = uiDecorCache.getStats();
+  printf("Dekorationsbilder: %u gerendert (%u us), %u Treffer, %u Bytes\n",
+         decor.renders, decor.renderUs, decor.hits, decor.bytes);
+
+#if UI_IMAGE_ASSETS
+  const UiImageAsset assets[] = {UI_IMAGE_ASSET_LIST};
+  printf("Bilder (%d x Neuzeichnen, Bildcache %d Einträge):\n", iterations, LV_IMG_CACHE_DEF_SIZE);
+  printf("%-14s %10s %10s %12s %12s %14s %12s\n", "bild", "groesse", "flash_b", "ausgepackt_b",
+         "ohne_us", "ohne_decodes", "cache_us");
+  for (const UiImageAsset &asset : assets) {
+    ImageResult uncached = benchImage(asset.dsc, false, iterations);
+    ImageResult cached = benchImage(asset.dsc, true, iterations);
+    char size[16];
+    snprintf(size, sizeof(size), "%ux%u", asset.dsc->header.w, asset.dsc->header.h);
+    lv_img_header_t header;
+    lv_img_decoder_get_info(asset.dsc, &header);
+    printf("%-14s %10s %10u %12u %12u %14u %12u\n", asset.name, size, asset.dsc->data_size,
+           uiImageDecodedSize(&header), uncached.redrawUs, uncached.decodes, cached.redrawUs);
+  }
+  printf("Bild-Decoder: %u Zugriffe, %u ausgepackt (%u us, max. %u us), Trefferquote %u%%\n",
+         uiImageStats.lookups, uiImageStats.decodes, uiImageStats.decodeUs, uiImageStats.maxDecodeUs,
+         uiImageHitRate());
+#endif
+
+  std::string legacyPayload;
+  std::string composedPayload;
+  MqttResult mqttLegacy = benchMqtt(false, legacyPayload);
+  MqttResult mqttComposed = benchMqtt(true, composedPayload);
+  bool mqttOk = composedPayload == legacyPayload && mqttComposed.allocsPerMessage == 0;
+  printf("MQTT-Telemetrie (%d Nachrichten):\n", BENCH_MQTT_ROUNDS);
+  printf("%-14s %10s %12s %12s %14s\n", "variante", "bytes", "message_ns", "allocs", "alloc_b");
+  printf("%-14s %10u %12u %12u %14u\n", "dynamisch", mqttLegacy.bytes, mqttLegacy.messageNs,
+         mqttLegacy.allocsPerMessage, mqttLegacy.allocBytesPerMessage);
+  printf("%-14s %10u %12u %12u %14u\n", "sendepuffer", mqttComposed.bytes, mqttComposed.messageNs,
+         mqttComposed.allocsPerMessage, mqttComposed.allocBytesPerMessage);
+  printf("MQTT-Nachricht: %s\n", composedPayload == legacyPayload ? "gleich" : "ABWEICHEND");
+
+  RgbPanelResult rgb = benchRgbPanel(iterations);
+  printf("RGB-Panel (Direct Mode, Mock): running %u us, %u Umschaltungen, %u px/Refresh synchronisiert, "
+         "Puffer %s, Bild %s\n",
+         rgb.steadyUs, rgb.presents, rgb.syncedPixels,
+         rgb.outOfSync == 0 ? "synchron" : "ABWEICHEND",
+         rgb.matchesFullRedraw ? "wie Neuzeichnen" : "ABWEICHEND");
+
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);
+  printf("LVGL-Heap gesamt: %u / %u Bytes belegt, max. %u, Fragmentierung %u%%\n",
+         (unsigned)(mon.total_size - mon.free_size), (unsigned)mon.total_size,
+         (unsigned)mon.max_used, (unsigned)mon.frag_pct);
+
+  return (rgb.outOfSync == 0 && rgb.matchesFullRedraw && progressOk && mqttOk) ? 0 : 1;
+}
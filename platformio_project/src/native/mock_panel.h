@@ -0,0 +1,104 @@
+#ifndef MOCK_PANEL_H
+#define MOCK_PANEL_H
+
+#include <lvgl.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../rgb_framebuffer.h"
+
+/**
+ * Nachbildung eines RGB-Parallel-Panels für den nativen Build.
+ * Stellt zwei Framebuffer bereit wie der ESP-IDF-Treiber und kopiert beim
+ * Umschalten den angezeigten Puffer in ein Abbild des Bildschirms. Damit
+ * lässt sich die Pufferverwaltung aus rgb_framebuffer.h ohne Hardware prüfen.
+ */
+class MockRgbPanel {
+private:
+  lv_color_t* framebuffers[2];
+  lv_color_t* scanout;   // Was das Panel zuletzt angezeigt hat
+  size_t pixels;
+  uint32_t foreignPresents;  // Umschaltungen auf Puffer, die nicht zum Panel gehören
+
+  RgbFramebufferSync sync;
+  lv_disp_draw_buf_t drawBuf;
+
+  static MockRgbPanel* instance;
+
+  static void present(void* framebuffer) {
+    MockRgbPanel* self = instance;
+    if (framebuffer != self->framebuffers[0] && framebuffer != self->framebuffers[1]) {
+      self->foreignPresents++;
+      return;
+    }
+    memcpy(self->scanout, framebuffer, self->pixels * sizeof(lv_color_t));
+  }
+
+public:
+  MockRgbPanel() : scanout(NULL), pixels(0), foreignPresents(0) {
+    framebuffers[0] = NULL;
+    framebuffers[1] = NULL;
+  }
+
+  ~MockRgbPanel() {
+    free(framebuffers[0]);
+    free(framebuffers[1]);
+    free(scanout);
+  }
+
+  /**
+   * Legt Framebuffer und Bildschirmabbild an und bereitet den LVGL-Treiber vor.
+   *
+   * @param w Breite in Pixeln
+   * @param h Höhe in Pixeln
+   * @param drv LVGL-Displaytreiber (bereits mit lv_disp_drv_init() vorbereitet)
+   */
+  void begin(lv_coord_t w, lv_coord_t h, lv_disp_drv_t* drv) {
+    instance = this;
+    pixels = (size_t)w * h;
+    framebuffers[0] = (lv_color_t*)malloc(pixels * sizeof(lv_color_t));
+    framebuffers[1] = (lv_color_t*)malloc(pixels * sizeof(lv_color_t));
+    scanout = (lv_color_t*)calloc(pixels, sizeof(lv_color_t));
+    sync.begin(framebuffers[0], framebuffers[1], w, h, present, &drawBuf, drv);
+  }
+
+  /**
+   * Prüft, ob beide Framebuffer denselben Inhalt haben. Nach jedem
+   * abgeschlossenen Refresh muss das der Fall sein.
+   */
+  bool buffersInSync() {
+    return memcmp(framebuffers[0], framebuffers[1], pixels * sizeof(lv_color_t)) == 0;
+  }
+
+  /**
+   * Gibt das Abbild des zuletzt angezeigten Bildschirms zurück.
+   */
+  const lv_color_t* getScanout() {
+    return scanout;
+  }
+
+  /**
+   * Gibt die Größe des Bildschirmabbilds in Bytes zurück.
+   */
+  size_t getScanoutBytes() {
+    return pixels * sizeof(lv_color_t);
+  }
+
+  /**
+   * Gibt die Anzahl der Umschaltungen auf fremde Puffer zurück (muss 0 sein).
+   */
+  uint32_t getForeignPresents() {
+    return foreignPresents;
+  }
+
+  /**
+   * Gibt die Pufferverwaltung zurück (Statistik).
+   */
+  RgbFramebufferSync &getSync() {
+    return sync;
+  }
+};
+
+MockRgbPanel* MockRgbPanel::instance = NULL;
+
+#endif // MOCK_PANEL_H
@@ -0,0 +1,114 @@
+#ifndef PROGRAM_SUPERVISOR_H
+#define PROGRAM_SUPERVISOR_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+#include "command_queue.h"
+
+// Erneuter Versuch, wenn die Befehlswarteschlange beim Ablauf voll ist (in µs)
+#define PROGRAM_SUPERVISOR_RETRY_US 10000
+
+/**
+ * Überwacht das Ende des laufenden Programms mit einem einzigen einmaligen
+ * esp_timer statt einer sekündlichen Abfrage. Beim Ablauf reicht der
+ * esp_timer-Task CONTROL_PROGRAM_DEADLINE mit der aktuellen Generation in die
+ * Befehlswarteschlange ein; die Steuerung prüft dann selbst, ob das Programm
+ * laut Uhr wirklich zu Ende ist, und beendet es oder stellt den Timer neu.
+ * Jeder arm()/disarm() erhöht die Generation, verspätete Abläufe eines
+ * früheren Programms lassen sich so erkennen.
+ *
+ * arm() und disarm() nur aus dem Steuerungs-Task aufrufen.
+ */
+class ProgramSupervisor {
+private:
+  esp_timer_handle_t timer;
+  volatile uint32_t generation;
+  int64_t deadlineUs;   // esp_timer_get_time() beim Ablauf, 0 wenn nicht gestellt
+  uint32_t armCount;
+  uint32_t expiries;
+
+  static void onExpired(void* arg) {
+    ProgramSupervisor* self = (ProgramSupervisor*)arg;
+    self->expiries++;
+    if (commandQueue.submit(CONTROL_PROGRAM_DEADLINE, self->generation, COMMAND_SOURCE_TIMER) == 0) {
+      esp_timer_start_once(self->timer, PROGRAM_SUPERVISOR_RETRY_US);
+    }
+  }
+
+  void start(int64_t remainingUs) {
+    esp_timer_stop(timer);
+    generation++;
+    armCount++;
+    deadlineUs = esp_timer_get_time() + remainingUs;
+    esp_timer_start_once(timer, remainingUs > 0 ? remainingUs : 1);
+  }
+
+public:
+  ProgramSupervisor() : timer(NULL), generation(0), deadlineUs(0), armCount(0), expiries(0) {
+  }
+
+  /**
+   * Legt den esp_timer an (einmal beim Start).
+   *
+   * @return false, wenn der Timer nicht angelegt werden konnte
+   */
+  bool begin() {
+    esp_timer_create_args_t args = {};
+    args.callback = onExpired;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "program";
+    return esp_timer_create(&args, &timer) == ESP_OK;
+  }
+
+  /**
+   * Stellt die Frist für das laufende Programm (Start, Wiederaufnahme nach
+   * Neustart oder nach einer Korrektur der Uhr).
+   *
+   * @param remainingS Restlaufzeit in Sekunden
+   */
+  void arm(uint32_t remainingS) {
+    start((int64_t)remainingS * 1000000);
+  }
+
+  /**
+   * Hebt die Frist auf (Programm gestoppt, abgebrochen oder beendet).
+   */
+  void disarm() {
+    esp_timer_stop(timer);
+    generation++;
+    deadlineUs = 0;
+  }
+
+  /**
+   * Prüft, ob ein CONTROL_PROGRAM_DEADLINE-Befehl zur aktuellen Frist gehört.
+   */
+  bool isCurrent(uint32_t expiredGeneration) {
+    return deadlineUs != 0 && expiredGeneration == generation;
+  }
+
+  /**
+   * Restzeit bis zum Ablauf in ms (0, wenn keine Frist gestellt ist).
+   */
+  uint32_t getRemainingMs() {
+    if (deadlineUs == 0) {
+      return 0;
+    }
+    int64_t remaining = deadlineUs - esp_timer_get_time();
+    return remaining > 0 ? remaining / 1000 : 0;
+  }
+
+  // Gestellte Fristen und Abläufe seit dem Start (ein Ablauf je Programm, Neustellungen nach Uhrkorrektur)
+  uint32_t getArmCount() {
+    return armCount;
+  }
+
+  uint32_t getExpiries() {
+    return expiries;
+  }
+};
+
+static ProgramSupervisor programSupervisor;
+
+#endif // PROGRAM_SUPERVISOR_H
@@ -0,0 +1,276 @@
+#ifndef PROGRESS_JOURNAL_H
+#define PROGRESS_JOURNAL_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <nvs.h>
+
+#include "seqlock.h"
+
+// Plätze im Ring der Journal-Einträge (Zweierpotenz, teilt JOURNAL_SEQ_MOD)
+#ifndef JOURNAL_SLOTS
+#define JOURNAL_SLOTS 8
+#endif
+
+// Abstand der Zwischenstände eines laufenden Programms in ms
+#ifndef JOURNAL_CHECKPOINT_MS
+#define JOURNAL_CHECKPOINT_MS 600000
+#endif
+
+// Spätestens nach dieser Zeit in ms steht ein neuer Eintrag im Flash
+#ifndef JOURNAL_FLUSH_MS
+#define JOURNAL_FLUSH_MS 1000
+#endif
+
+// Bytes, die NVS für einen 64-Bit-Wert schreibt (ein Eintrag)
+#define JOURNAL_NVS_ENTRY_BYTES 32
+#define JOURNAL_SEQ_MOD 1024
+
+// Art eines Journal-Eintrags (3 Bit). Die Werte stehen im Flash, nicht umnummerieren
+enum JournalRecordType {
+  JOURNAL_EMPTY = 0,       // Platz noch nie beschrieben
+  JOURNAL_START = 1,
+  JOURNAL_CHECKPOINT = 2,  // Zwischenstand eines laufenden Programms
+  JOURNAL_RESUME = 4,      // Nach einem Neustart fortgesetzt (3 ist frei)
+  JOURNAL_COMPLETE = 5,
+  JOURNAL_STOP = 6,
+  JOURNAL_ERROR = 7,
+};
+
+/**
+ * Ein Eintrag enthält den vollständigen Fortschritt, der letzte genügt daher
+ * zum Wiederaufnehmen. Gespeichert wird er als ein 64-Bit-Wert:
+ * Art (3 Bit), Programm (3 Bit), Dauer und Laufzeit in Sekunden (je 24 Bit,
+ * bis 194 Tage), Folgenummer (10 Bit).
+ */
+struct JournalRecord {
+  uint32_t type;      // JournalRecordType
+  uint32_t program;
+  uint32_t duration;  // Programmdauer in Sekunden
+  uint32_t elapsed;   // Gelaufene Zeit in Sekunden
+  uint32_t seq;       // Folgenummer (vergibt das Journal beim Schreiben)
+};
+
+/**
+ * Zähler des Journals seit dem Start.
+ * flashBytes zählt die geschriebenen NVS-Einträge; Seitenwechsel und Aufräumen
+ * von NVS kommen hinzu, liegen aber unter einer Seite je 126 Einträge.
+ */
+struct JournalStats {
+  uint32_t appended;   // Von der Steuerung gemeldete Einträge
+  uint32_t written;    // Davon in den Flash geschrieben
+  uint32_t coalesced;  // Vor dem Schreiben durch neuere ersetzt
+  uint32_t errors;
+  uint32_t flashBytes;
+  uint32_t maxWriteUs;
+};
+
+/**
+ * Fortschrittsjournal im NVS, damit ein Neustart mitten in einem Programm
+ * nicht den ganzen Lauf kostet. Die Steuerung meldet Start, Fortsetzung nach
+ * einem Neustart, Ende und regelmäßige Zwischenstände mit append(); das Journal
+ * übergibt nur den jeweils neuesten Eintrag über eine Sequenzsperre an
+ * flush(), das der Netzwerk-Task periodisch aufruft. So blockiert der Flash
+ * nie die Steuerung, und dicht aufeinander folgende Einträge werden zu einem
+ * Schreibvorgang zusammengefasst.
+ *
+ * Die Einträge wandern reihum über JOURNAL_SLOTS Schlüssel. NVS schreibt jeden
+ * Wert als neuen Eintrag mit Prüfsumme und verteilt die Seiten selbst über
+ * die Partition; ein Stromausfall beim Schreiben hinterlässt den vorherigen
+ * Eintrag. Beim Start liest latest() alle Plätze, unabhängig davon, wie lange
+ * das Programm schon läuft.
+ */
+class ProgressJournal {
+  static_assert((JOURNAL_SLOTS & (JOURNAL_SLOTS - 1)) == 0, "JOURNAL_SLOTS muss eine Zweierpotenz sein");
+
+private:
+  Preferences prefs;
+  bool ready;
+  JournalRecord records[JOURNAL_SLOTS];  // Spiegel der Plätze im Flash
+  uint32_t nextSeq;
+  int latestSlot;
+  Seqlock<JournalRecord> pending;
+  uint32_t flushedVersion;
+  JournalStats stats;
+
+  static uint64_t pack(const JournalRecord &r) {
+    return (uint64_t)(r.type & 0x7) |
+           ((uint64_t)(r.program & 0x7) << 3) |
+           ((uint64_t)(r.duration & 0xFFFFFF) << 6) |
+           ((uint64_t)(r.elapsed & 0xFFFFFF) << 30) |
+           ((uint64_t)(r.seq & (JOURNAL_SEQ_MOD - 1)) << 54);
+  }
+
+  static JournalRecord unpack(uint64_t v) {
+    JournalRecord r;
+    r.type = v & 0x7;
+    r.program = (v >> 3) & 0x7;
+    r.duration = (v >> 6) & 0xFFFFFF;
+    r.elapsed = (v >> 30) & 0xFFFFFF;
+    r.seq = (v >> 54) & (JOURNAL_SEQ_MOD - 1);
+    return r;
+  }
+
+  static void slotKey(char* key, uint32_t slot) {
+    key[0] = 'r';
+    key[1] = '0' + slot / 10;
+    key[2] = '0' + slot % 10;
+    key[3] = '\0';
+  }
+
+public:
+  ProgressJournal() : ready(false), nextSeq(0), latestSlot(-1), flushedVersion(0) {
+    memset(records, 0, sizeof(records));
+    memset(&stats, 0, sizeof(stats));
+  }
+
+  /**
+   * Öffnet das Journal und liest die Plätze (einmal in setup()).
+   *
+   * @return false, wenn NVS nicht verfügbar ist
+   */
+  bool begin() {
+    ready = prefs.begin("journal", false);
+    if (!ready) {
+      return false;
+    }
+
+    char key[4];
+    for (uint32_t slot = 0; slot < JOURNAL_SLOTS; slot++) {
+      slotKey(key, slot);
+      records[slot] = unpack(prefs.getULong64(key, 0));
+      if (records[slot].type == JOURNAL_EMPTY) {
+        continue;
+      }
+      // Neuester Eintrag: die Folgenummern im Ring liegen dicht beieinander
+      if (latestSlot < 0 ||
+          ((records[slot].seq - records[latestSlot].seq) & (JOURNAL_SEQ_MOD - 1)) < JOURNAL_SEQ_MOD / 2) {
+        latestSlot = slot;
+      }
+    }
+    if (latestSlot >= 0) {
+      nextSeq = (records[latestSlot].seq + 1) & (JOURNAL_SEQ_MOD - 1);
+    }
+    return true;
+  }
+
+  /**
+   * Gibt den zuletzt geschriebenen Eintrag zurück.
+   *
+   * @return false, wenn das Journal leer ist
+   */
+  bool latest(JournalRecord &record) {
+    if (latestSlot < 0) {
+      return false;
+    }
+    record = records[latestSlot];
+    return true;
+  }
+
+  /**
+   * Meldet einen neuen Eintrag (nur vom Steuerungs-Task, schreibt nicht in den Flash).
+   *
+   * @param type Art des Eintrags
+   * @param program Programmindex
+   * @param duration Programmdauer in Sekunden
+   * @param elapsed Gelaufene Zeit in Sekunden
+   */
+  void append(JournalRecordType type, uint32_t program, uint32_t duration, uint32_t elapsed) {
+    JournalRecord record = {(uint32_t)type, program, duration, elapsed, 0};
+    if (pending.update(record)) {
+      stats.appended++;
+    }
+  }
+
+  /**
+   * Schreibt den neuesten gemeldeten Eintrag in den Flash (nur von einem Task,
+   * z.B. als Auftrag im Timer-Rad des Netzwerks). Ohne neuen Eintrag passiert nichts.
+   *
+   * @return true, wenn geschrieben wurde
+   */
+  bool flush() {
+    if (!ready || pending.version() == flushedVersion) {
+      return false;
+    }
+    JournalRecord record;
+    uint32_t version = pending.read(record);
+    stats.coalesced += version - flushedVersion - 1;
+    flushedVersion = version;
+
+    uint32_t slot = nextSeq & (JOURNAL_SLOTS - 1);
+    record.seq = nextSeq;
+    char key[4];
+    slotKey(key, slot);
+
+    uint32_t start = micros();
+    if (prefs.putULong64(key, pack(record)) == 0) {
+      stats.errors++;
+      return false;
+    }
+    uint32_t writeUs = micros() - start;
+    if (writeUs > stats.maxWriteUs) {
+      stats.maxWriteUs = writeUs;
+    }
+
+    records[slot] = record;
+    latestSlot = slot;
+    nextSeq = (nextSeq + 1) & (JOURNAL_SEQ_MOD - 1);
+    stats.written++;
+    stats.flashBytes += JOURNAL_NVS_ENTRY_BYTES;
+    return true;
+  }
+
+  /**
+   * Gibt den Eintrag eines Platzes zurück, 0 = neuester (für die Ausgabe der letzten Einträge).
+   */
+  const JournalRecord* get(uint32_t age) {
+    if (latestSlot < 0 || age >= JOURNAL_SLOTS) {
+      return NULL;
+    }
+    const JournalRecord &record = records[(latestSlot - age) & (JOURNAL_SLOTS - 1)];
+    return record.type != JOURNAL_EMPTY ? &record : NULL;
+  }
+
+  const JournalStats &getStats() {
+    return stats;
+  }
+
+  /**
+   * Geschriebene Flash-Bytes je gemeldetem Nutzbyte (8 Bytes je Eintrag).
+   * Unter 1, solange Zwischenstände zusammengefasst werden.
+   */
+  float getWriteAmplification() {
+    return stats.appended > 0 ? (float)stats.flashBytes / (stats.appended * sizeof(uint64_t)) : 0;
+  }
+
+  /**
+   * Belegte und freie Einträge der NVS-Partition.
+   *
+   * @return false, wenn NVS keine Statistik liefert
+   */
+  static bool getNvsUsage(uint32_t &used, uint32_t &total) {
+    nvs_stats_t nvsStats;
+    if (nvs_get_stats(NULL, &nvsStats) != ESP_OK) {
+      return false;
+    }
+    used = nvsStats.used_entries;
+    total = nvsStats.total_entries;
+    return true;
+  }
+
+  static const char* typeName(uint32_t type) {
+    switch (type) {
+      case JOURNAL_START:      return "start";
+      case JOURNAL_CHECKPOINT: return "checkpoint";
+      case JOURNAL_RESUME:     return "resume";
+      case JOURNAL_COMPLETE:   return "complete";
+      case JOURNAL_STOP:       return "stop";
+      case JOURNAL_ERROR:      return "error";
+    }
+    return "empty";
+  }
+};
+
+static ProgressJournal progressJournal;
+
+#endif // PROGRESS_JOURNAL_H
@@ -0,0 +1,216 @@
+#ifndef REFRESH_SCHEDULER_H
+#define REFRESH_SCHEDULER_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Aktiver Modus: Refresh- und Touch-Periode wie in lv_conf.h
+#ifndef REFRESH_ACTIVE_PERIOD_MS
+#define REFRESH_ACTIVE_PERIOD_MS LV_DISP_DEF_REFR_PERIOD
+#endif
+#ifndef REFRESH_ACTIVE_READ_PERIOD_MS
+#define REFRESH_ACTIVE_READ_PERIOD_MS LV_INDEV_DEF_READ_PERIOD
+#endif
+
+// Leerlauf: reduzierte Refresh- und Touch-Periode
+#ifndef REFRESH_IDLE_PERIOD_MS
+#define REFRESH_IDLE_PERIOD_MS 500
+#endif
+#ifndef REFRESH_IDLE_READ_PERIOD_MS
+#define REFRESH_IDLE_READ_PERIOD_MS 100
+#endif
+
+// Zeit ohne Invalidierung und Touch, bis in den Leerlauf gewechselt wird
+#ifndef REFRESH_IDLE_TIMEOUT_MS
+#define REFRESH_IDLE_TIMEOUT_MS 5000
+#endif
+
+// Maximale Schlafzeit der Hauptschleife, damit Netzwerk und Sensoren bedient werden
+#ifndef REFRESH_ACTIVE_MAX_SLEEP_MS
+#define REFRESH_ACTIVE_MAX_SLEEP_MS 30
+#endif
+#ifndef REFRESH_IDLE_MAX_SLEEP_MS
+#define REFRESH_IDLE_MAX_SLEEP_MS 100
+#endif
+
+/**
+ * Adaptiver Refresh-Scheduler für LVGL.
+ * Senkt Refresh- und Touch-Abfragerate, solange nichts invalidiert wird und
+ * kein Touch aktiv ist, und schaltet bei Touch oder Zustandswechsel sofort
+ * auf die volle Rate zurück. Ersetzt den Aufruf von lv_timer_handler() mit
+ * festem delay() in loop() und liefert die Zeit bis zur nächsten Timer-Deadline.
+ *
+ * Läuft im UI-Task. Die Zeiten je Modus darf jeder Task lesen: Die 64-Bit-Summen
+ * werden auf dem 32-Bit-Kern nicht in einem Zug geschrieben, Schreiber und Leser
+ * sperren sich deshalb gegenseitig.
+ */
+class RefreshScheduler {
+public:
+  enum Mode {
+    MODE_ACTIVE,
+    MODE_IDLE
+  };
+
+private:
+  lv_disp_t* disp;
+  lv_indev_t* indev;
+
+  Mode mode;
+  uint32_t lastActivity;
+  uint32_t lastModeSwitch;
+
+  // Aufsummierte Zeit je Modus (ohne das laufende Intervall)
+  uint64_t activeMs;
+  uint64_t idleMs;
+  uint32_t modeSwitches;
+  portMUX_TYPE lock;  // Schützt mode, lastModeSwitch und die Summen für andere Tasks
+
+  /**
+   * Prüft, ob LVGL noch etwas zu zeichnen hat.
+   */
+  bool hasPendingWork() {
+    return disp->inv_p > 0 || lv_anim_count_running() > 0;
+  }
+
+  /**
+   * Wechselt den Modus und passt die LVGL-Timerperioden an.
+   */
+  void setMode(Mode newMode) {
+    if (newMode == mode) {
+      return;
+    }
+
+    uint32_t now = millis();
+    portENTER_CRITICAL(&lock);
+    if (mode == MODE_ACTIVE) {
+      activeMs += now - lastModeSwitch;
+    } else {
+      idleMs += now - lastModeSwitch;
+    }
+    lastModeSwitch = now;
+    mode = newMode;
+    modeSwitches++;
+    portEXIT_CRITICAL(&lock);
+
+    if (mode == MODE_ACTIVE) {
+      lv_timer_set_period(disp->refr_timer, REFRESH_ACTIVE_PERIOD_MS);
+      if (indev != NULL) {
+        lv_timer_set_period(indev->driver->read_timer, REFRESH_ACTIVE_READ_PERIOD_MS);
+      }
+      // Anstehende Änderungen sofort zeichnen statt auf die lange Periode zu warten
+      lv_timer_ready(disp->refr_timer);
+    } else {
+      lv_timer_set_period(disp->refr_timer, REFRESH_IDLE_PERIOD_MS);
+      if (indev != NULL) {
+        lv_timer_set_period(indev->driver->read_timer, REFRESH_IDLE_READ_PERIOD_MS);
+      }
+    }
+  }
+
+public:
+  RefreshScheduler()
+    : disp(NULL), indev(NULL), mode(MODE_ACTIVE), lastActivity(0), lastModeSwitch(0),
+      activeMs(0), idleMs(0), modeSwitches(0) {
+    portMUX_INITIALIZE(&lock);
+  }
+
+  /**
+   * Verbindet den Scheduler mit Display und Eingabegerät.
+   *
+   * @param display Das registrierte LVGL-Display
+   * @param input Das registrierte Touch-Eingabegerät (oder NULL)
+   */
+  void begin(lv_disp_t* display, lv_indev_t* input) {
+    disp = display;
+    indev = input;
+    mode = MODE_ACTIVE;
+    lastActivity = millis();
+    lastModeSwitch = lastActivity;
+  }
+
+  /**
+   * Meldet Aktivität (Touch, Zustandswechsel) und schaltet auf volle Rate.
+   */
+  void notifyActivity() {
+    lastActivity = millis();
+    if (disp != NULL) {
+      setMode(MODE_ACTIVE);
+    }
+  }
+
+  /**
+   * Meldet eine neue Eingabe und lässt LVGL das Eingabegerät sofort lesen,
+   * statt auf die nächste (im Leerlauf lange) Leseperiode zu warten.
+   */
+  void notifyInput() {
+    notifyActivity();
+    if (indev != NULL) {
+      lv_timer_ready(indev->driver->read_timer);
+    }
+  }
+
+  /**
+   * Führt die LVGL-Timer aus und wählt den passenden Modus.
+   *
+   * @return Zeit in ms, die die Hauptschleife bis zur nächsten Deadline schlafen darf
+   */
+  uint32_t handle() {
+    if (hasPendingWork()) {
+      notifyActivity();
+    }
+
+    uint32_t next = lv_timer_handler();
+
+    if (hasPendingWork()) {
+      notifyActivity();
+    } else if (mode == MODE_ACTIVE && millis() - lastActivity >= REFRESH_IDLE_TIMEOUT_MS) {
+      setMode(MODE_IDLE);
+    }
+
+    uint32_t maxSleep = (mode == MODE_ACTIVE) ? REFRESH_ACTIVE_MAX_SLEEP_MS : REFRESH_IDLE_MAX_SLEEP_MS;
+    return next < maxSleep ? next : maxSleep;
+  }
+
+  /**
+   * Gibt den aktuellen Modus zurück.
+   */
+  Mode getMode() {
+    return mode;
+  }
+
+  /**
+   * Gibt die gesamte Zeit im aktiven Modus zurück (ms, aus jedem Task).
+   */
+  uint64_t getActiveMs() {
+    return modeMs(MODE_ACTIVE);
+  }
+
+  /**
+   * Gibt die gesamte Zeit im Leerlauf zurück (ms, aus jedem Task).
+   */
+  uint64_t getIdleMs() {
+    return modeMs(MODE_IDLE);
+  }
+
+  /**
+   * Gibt die gesamte Zeit in einem Modus einschließlich des laufenden Intervalls zurück (ms).
+   */
+  uint64_t modeMs(Mode which) {
+    portENTER_CRITICAL(&lock);
+    uint64_t total = which == MODE_ACTIVE ? activeMs : idleMs;
+    if (mode == which) {
+      total += millis() - lastModeSwitch;
+    }
+    portEXIT_CRITICAL(&lock);
+    return total;
+  }
+
+  /**
+   * Gibt die Anzahl der Moduswechsel zurück.
+   */
+  uint32_t getModeSwitches() {
+    return modeSwitches;
+  }
+};
+
+#endif // REFRESH_SCHEDULER_H
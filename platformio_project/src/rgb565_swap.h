@@ -0,0 +1,88 @@
+#ifndef RGB565_SWAP_H
+#define RGB565_SWAP_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Byte-Tausch für RGB565-Pixel (Host-Reihenfolge <-> SPI-Reihenfolge).
+ * Wird nur benötigt, wenn LVGL nicht mit LV_COLOR_16_SWAP=1 direkt in
+ * SPI-Reihenfolge rendert.
+ */
+
+/**
+ * Tauscht die Bytes Pixel für Pixel (Referenz, entspricht der Schleife in TFT_eSPI).
+ *
+ * @param pixels Pixelpuffer, wird in-place getauscht
+ * @param count Anzahl der Pixel
+ */
+static inline void rgb565SwapScalar(uint16_t* pixels, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    pixels[i] = (uint16_t)((pixels[i] << 8) | (pixels[i] >> 8));
+  }
+}
+
+/**
+ * Tauscht die Bytes von zwei Pixeln pro 32-Bit-Operation.
+ * Die Schleife ist vierfach entrollt (acht Pixel pro Durchlauf) und wird
+ * auf dem Host vom Compiler vektorisiert.
+ *
+ * @param pixels Pixelpuffer, wird in-place getauscht
+ * @param count Anzahl der Pixel
+ */
+static inline void rgb565Swap(uint16_t* pixels, uint32_t count) {
+  // Einzelnes Pixel bis zur 4-Byte-Ausrichtung
+  if (((uintptr_t)pixels & 2) && count > 0) {
+    rgb565SwapScalar(pixels, 1);
+    pixels++;
+    count--;
+  }
+
+  uint8_t* bytes = (uint8_t*)pixels;
+  uint32_t words = count / 2;
+  uint32_t i = 0;
+
+  for (; i + 4 <= words; i += 4) {
+    uint32_t w[4];
+    memcpy(w, bytes + i * 4, sizeof(w));
+    w[0] = ((w[0] & 0x00FF00FF) << 8) | ((w[0] >> 8) & 0x00FF00FF);
+    w[1] = ((w[1] & 0x00FF00FF) << 8) | ((w[1] >> 8) & 0x00FF00FF);
+    w[2] = ((w[2] & 0x00FF00FF) << 8) | ((w[2] >> 8) & 0x00FF00FF);
+    w[3] = ((w[3] & 0x00FF00FF) << 8) | ((w[3] >> 8) & 0x00FF00FF);
+    memcpy(bytes + i * 4, w, sizeof(w));
+  }
+  for (; i < words; i++) {
+    uint32_t w;
+    memcpy(&w, bytes + i * 4, sizeof(w));
+    w = ((w & 0x00FF00FF) << 8) | ((w >> 8) & 0x00FF00FF);
+    memcpy(bytes + i * 4, &w, sizeof(w));
+  }
+
+  // Verbleibendes Pixel bei ungerader Anzahl
+  if (count & 1) {
+    rgb565SwapScalar(pixels + count - 1, 1);
+  }
+}
+
+/**
+ * Wandelt RGB565-Pixel in SPI-Reihenfolge in RGB666 (3 Bytes je Pixel, Farbwerte
+ * linksbündig), wie es der ILI9488 am SPI erwartet. Entspricht tft_Write_16()
+ * von TFT_eSPI für diesen Controller.
+ *
+ * @param pixels Pixelpuffer in SPI-Reihenfolge (höherwertiges Byte zuerst)
+ * @param out Zielpuffer mit Platz für 3 * count Bytes
+ * @param count Anzahl der Pixel
+ */
+static inline void rgb565ToRgb666(const uint16_t* pixels, uint8_t* out, uint32_t count) {
+  const uint8_t* bytes = (const uint8_t*)pixels;
+  for (uint32_t i = 0; i < count; i++) {
+    uint8_t hi = bytes[i * 2];
+    uint8_t lo = bytes[i * 2 + 1];
+    out[0] = hi & 0xF8;
+    out[1] = (uint8_t)(((hi & 0x07) << 5) | ((lo & 0xE0) >> 3));
+    out[2] = (uint8_t)((lo & 0x1F) << 3);
+    out += 3;
+  }
+}
+
+#endif // RGB565_SWAP_H
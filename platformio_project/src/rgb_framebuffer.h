@@ -0,0 +1,135 @@
+#ifndef RGB_FRAMEBUFFER_H
+#define RGB_FRAMEBUFFER_H
+
+#include <lvgl.h>
+#include <string.h>
+
+/**
+ * Pufferverwaltung für Panels mit zwei vollständigen Framebuffern.
+ * LVGL zeichnet im Direct Mode abwechselnd in beide Framebuffer und nur die
+ * geänderten Bereiche. Nach dem Umschalten zeigt das Panel den gerade
+ * gezeichneten Puffer, der andere Puffer ist um genau diese Bereiche
+ * veraltet. Sie werden deshalb nach dem Umschalten in den anderen Puffer
+ * kopiert, bevor LVGL dort weiterzeichnet.
+ *
+ * Enthält keinen Hardwarezugriff: das Umschalten übernimmt eine Callback-
+ * Funktion des Panels (ESP-IDF RGB-Treiber oder Mock im nativen Build).
+ */
+class RgbFramebufferSync {
+public:
+  // Zeigt den Framebuffer an und kehrt zurück, sobald das Panel ihn ausliest (VSYNC)
+  typedef void (*PanelPresentFn)(void* framebuffer);
+
+private:
+  lv_color_t* framebuffers[2];
+  lv_coord_t width;
+  lv_coord_t height;
+  PanelPresentFn presentFn;
+
+  // Statistik
+  uint32_t presents;
+  uint32_t syncedPixels;
+
+  /**
+   * Kopiert einen Bereich von einem Framebuffer in den anderen.
+   */
+  void copyArea(const lv_color_t* src, lv_color_t* dst, const lv_area_t* area) {
+    lv_coord_t w = lv_area_get_width(area);
+    size_t offset = (size_t)area->y1 * width + area->x1;
+    for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+      memcpy(dst + offset, src + offset, w * sizeof(lv_color_t));
+      offset += width;
+    }
+    syncedPixels += lv_area_get_size(area);
+  }
+
+public:
+  RgbFramebufferSync() : width(0), height(0), presentFn(NULL), presents(0), syncedPixels(0) {
+    framebuffers[0] = NULL;
+    framebuffers[1] = NULL;
+  }
+
+  /**
+   * Initialisiert die Verwaltung und den LVGL-Treiber (Direct Mode, zwei Framebuffer).
+   *
+   * @param fb0 Erster Framebuffer (width * height Pixel)
+   * @param fb1 Zweiter Framebuffer
+   * @param w Breite in Pixeln
+   * @param h Höhe in Pixeln
+   * @param present Funktion zum Umschalten des Panels
+   * @param drawBuf LVGL-Zeichenpuffer, wird auf die Framebuffer gesetzt
+   * @param drv LVGL-Displaytreiber (bereits mit lv_disp_drv_init() vorbereitet)
+   */
+  void begin(lv_color_t* fb0, lv_color_t* fb1, lv_coord_t w, lv_coord_t h, PanelPresentFn present,
+             lv_disp_draw_buf_t* drawBuf, lv_disp_drv_t* drv) {
+    framebuffers[0] = fb0;
+    framebuffers[1] = fb1;
+    width = w;
+    height = h;
+    presentFn = present;
+
+    // Beide Puffer mit identischem Inhalt starten
+    memset(fb0, 0, (size_t)w * h * sizeof(lv_color_t));
+    memset(fb1, 0, (size_t)w * h * sizeof(lv_color_t));
+
+    lv_disp_draw_buf_init(drawBuf, fb0, fb1, (uint32_t)w * h);
+    drv->hor_res = w;
+    drv->ver_res = h;
+    drv->draw_buf = drawBuf;
+    drv->direct_mode = 1;
+    drv->flush_cb = flushCb;
+    drv->user_data = this;
+  }
+
+  /**
+   * Flush-Callback für LVGL. Im Direct Mode ist color_map der gesamte Framebuffer.
+   * Erst beim letzten Bereich eines Refreshs wird umgeschaltet und synchronisiert.
+   */
+  static void flushCb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_map) {
+    RgbFramebufferSync* self = (RgbFramebufferSync*)drv->user_data;
+    if (lv_disp_flush_is_last(drv)) {
+      self->present(color_map);
+    }
+    lv_disp_flush_ready(drv);
+  }
+
+  /**
+   * Schaltet auf den gezeichneten Puffer um und übernimmt die geänderten
+   * Bereiche in den anderen Puffer.
+   */
+  void present(lv_color_t* drawn) {
+    presentFn(drawn);
+    presents++;
+
+    lv_color_t* other = (drawn == framebuffers[0]) ? framebuffers[1] : framebuffers[0];
+    lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+      if (!disp->inv_area_joined[i]) {
+        copyArea(drawn, other, &disp->inv_areas[i]);
+      }
+    }
+  }
+
+  /**
+   * Gibt einen der beiden Framebuffer zurück.
+   */
+  lv_color_t* getFramebuffer(int index) {
+    return framebuffers[index];
+  }
+
+  /**
+   * Gibt die Anzahl der Umschaltungen zurück.
+   */
+  uint32_t getPresentCount() {
+    return presents;
+  }
+
+  /**
+   * Gibt die Anzahl der zwischen den Puffern kopierten Pixel zurück.
+   */
+  uint32_t getSyncedPixels() {
+    return syncedPixels;
+  }
+};
+
+#endif // RGB_FRAMEBUFFER_H
@@ -0,0 +1,217 @@
+#ifndef RGB_PANEL_H
+#define RGB_PANEL_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <lvgl.h>
+#include <esp_idf_version.h>
+#include <esp_lcd_panel_ops.h>
+#include <esp_lcd_panel_rgb.h>
+
+#include "rgb_framebuffer.h"
+
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 1, 0)
+#error "Das RGB-Panel-Backend benötigt ESP-IDF 5.1 oder neuer (Arduino-ESP32 3.x)"
+#endif
+
+#if LV_COLOR_16_SWAP
+#error "Das RGB-Panel erwartet RGB565 in Host-Reihenfolge: LV_COLOR_16_SWAP=0 setzen"
+#endif
+
+/*
+ * Standardwerte für das Waveshare ESP32-S3-Touch-LCD-4.3B (800x480).
+ * Für andere Panels per Build-Flag überschreiben.
+ */
+#ifndef RGB_PANEL_PCLK_HZ
+#define RGB_PANEL_PCLK_HZ (16 * 1000 * 1000)
+#endif
+
+// SRAM-Bounce-Buffer in Zeilen: der Treiber kopiert den PSRAM-Framebuffer
+// blockweise in internen RAM, damit PSRAM-Zugriffe das Bild nicht stören
+#ifndef RGB_PANEL_BOUNCE_LINES
+#define RGB_PANEL_BOUNCE_LINES 10
+#endif
+
+// Steuerleitungen
+#define RGB_PANEL_PIN_DE     5
+#define RGB_PANEL_PIN_VSYNC  3
+#define RGB_PANEL_PIN_HSYNC  46
+#define RGB_PANEL_PIN_PCLK   7
+
+// Datenleitungen D0..D15 (B3..B7, G2..G7, R3..R7)
+#define RGB_PANEL_DATA_PINS {14, 38, 18, 17, 10, 39, 0, 45, 48, 47, 21, 1, 2, 42, 41, 40}
+
+// I2C für IO-Expander und Touch-Controller
+#define RGB_PANEL_I2C_SDA 8
+#define RGB_PANEL_I2C_SCL 9
+
+// CH422G-IO-Expander: Reset-Leitungen und Hintergrundbeleuchtung
+#define CH422G_ADDR_MODE   0x24
+#define CH422G_ADDR_OUTPUT 0x38
+#define CH422G_MODE_OUTPUT 0x01
+#define CH422G_TP_RST      (1 << 1)
+#define CH422G_LCD_BL      (1 << 2)
+#define CH422G_LCD_RST     (1 << 3)
+
+// Alle GPIOs des Panels (Steuer-, I2C- und Datenleitungen)
+static constexpr int rgbPanelPins[] = {
+  RGB_PANEL_PIN_DE, RGB_PANEL_PIN_VSYNC, RGB_PANEL_PIN_HSYNC, RGB_PANEL_PIN_PCLK,
+  RGB_PANEL_I2C_SDA, RGB_PANEL_I2C_SCL,
+};
+static constexpr int rgbPanelDataPins[] = RGB_PANEL_DATA_PINS;
+
+constexpr bool rgbPanelPinIn(const int* pins, unsigned count, int pin) {
+  return count > 0 && (pins[0] == pin || rgbPanelPinIn(pins + 1, count - 1, pin));
+}
+
+/**
+ * Prüft zur Übersetzungszeit, ob das Panel eine GPIO belegt (für static_assert
+ * gegen die übrigen Pins der Anwendung).
+ */
+constexpr bool rgbPanelUsesPin(int pin) {
+  return rgbPanelPinIn(rgbPanelPins, sizeof(rgbPanelPins) / sizeof(rgbPanelPins[0]), pin) ||
+         rgbPanelPinIn(rgbPanelDataPins, sizeof(rgbPanelDataPins) / sizeof(rgbPanelDataPins[0]), pin);
+}
+
+// Maximale Wartezeit auf VSYNC
+#define RGB_PANEL_VSYNC_TIMEOUT_MS 100
+
+/**
+ * Display-Backend für RGB-Parallel-Panels über den ESP-IDF-RGB-LCD-Treiber.
+ * Zwei vollständige Framebuffer liegen im PSRAM, LVGL zeichnet im Direct
+ * Mode direkt hinein (siehe RgbFramebufferSync). Umgeschaltet wird
+ * synchron zu VSYNC, damit kein Tearing entsteht.
+ */
+class RgbPanel {
+private:
+  esp_lcd_panel_handle_t panel;
+  SemaphoreHandle_t vsyncSem;
+  RgbFramebufferSync sync;
+  lv_disp_draw_buf_t drawBuf;
+  uint16_t width;
+  uint16_t height;
+  uint32_t vsyncTimeouts;
+
+  static RgbPanel* instance;
+
+  static bool IRAM_ATTR onVsync(esp_lcd_panel_handle_t handle, const esp_lcd_rgb_panel_event_data_t* edata, void* ctx) {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(((RgbPanel*)ctx)->vsyncSem, &woken);
+    return woken == pdTRUE;
+  }
+
+  /**
+   * Schaltet den Framebuffer um und wartet, bis das Panel ihn ausliest.
+   */
+  static void present(void* framebuffer) {
+    RgbPanel* self = instance;
+    xSemaphoreTake(self->vsyncSem, 0);
+    esp_lcd_panel_draw_bitmap(self->panel, 0, 0, self->width, self->height, framebuffer);
+    if (xSemaphoreTake(self->vsyncSem, pdMS_TO_TICKS(RGB_PANEL_VSYNC_TIMEOUT_MS)) != pdTRUE) {
+      self->vsyncTimeouts++;
+    }
+  }
+
+  /**
+   * Gibt Panel und Touch-Controller über den IO-Expander frei und schaltet die Beleuchtung ein.
+   */
+  void initExpander() {
+    Wire.beginTransmission(CH422G_ADDR_MODE);
+    Wire.write(CH422G_MODE_OUTPUT);
+    Wire.endTransmission();
+
+    Wire.beginTransmission(CH422G_ADDR_OUTPUT);
+    Wire.write(CH422G_TP_RST | CH422G_LCD_BL | CH422G_LCD_RST);
+    Wire.endTransmission();
+    delay(100); // Touch-Controller nach dem Reset starten lassen
+  }
+
+public:
+  RgbPanel() : panel(NULL), vsyncSem(NULL), width(0), height(0), vsyncTimeouts(0) {
+  }
+
+  /**
+   * Initialisiert Panel und LVGL-Treiber.
+   *
+   * @param w Breite in Pixeln
+   * @param h Höhe in Pixeln
+   * @param drv LVGL-Displaytreiber (bereits mit lv_disp_drv_init() vorbereitet)
+   * @return false, wenn der Treiber oder die Framebuffer nicht angelegt werden konnten
+   */
+  bool begin(uint16_t w, uint16_t h, lv_disp_drv_t* drv) {
+    instance = this;
+    width = w;
+    height = h;
+
+    Wire.begin(RGB_PANEL_I2C_SDA, RGB_PANEL_I2C_SCL);
+    initExpander();
+
+    vsyncSem = xSemaphoreCreateBinary();
+
+    esp_lcd_rgb_panel_config_t config = {};
+    config.clk_src = LCD_CLK_SRC_DEFAULT;
+    config.timings.pclk_hz = RGB_PANEL_PCLK_HZ;
+    config.timings.h_res = w;
+    config.timings.v_res = h;
+    config.timings.hsync_pulse_width = 4;
+    config.timings.hsync_back_porch = 8;
+    config.timings.hsync_front_porch = 8;
+    config.timings.vsync_pulse_width = 4;
+    config.timings.vsync_back_porch = 8;
+    config.timings.vsync_front_porch = 8;
+    config.timings.flags.pclk_active_neg = 1;
+    config.data_width = 16;
+    config.bits_per_pixel = 16;
+    config.num_fbs = 2;
+    config.bounce_buffer_size_px = w * RGB_PANEL_BOUNCE_LINES;
+    config.psram_trans_align = 64;
+    config.hsync_gpio_num = RGB_PANEL_PIN_HSYNC;
+    config.vsync_gpio_num = RGB_PANEL_PIN_VSYNC;
+    config.de_gpio_num = RGB_PANEL_PIN_DE;
+    config.pclk_gpio_num = RGB_PANEL_PIN_PCLK;
+    config.disp_gpio_num = -1;
+    const int dataPins[16] = RGB_PANEL_DATA_PINS;
+    for (int i = 0; i < 16; i++) {
+      config.data_gpio_nums[i] = dataPins[i];
+    }
+    config.flags.fb_in_psram = 1;
+
+    if (esp_lcd_new_rgb_panel(&config, &panel) != ESP_OK) {
+      return false;
+    }
+
+    esp_lcd_rgb_panel_event_callbacks_t callbacks = {};
+    callbacks.on_vsync = onVsync;
+    esp_lcd_rgb_panel_register_event_callbacks(panel, &callbacks, this);
+
+    esp_lcd_panel_reset(panel);
+    esp_lcd_panel_init(panel);
+
+    void* fb0 = NULL;
+    void* fb1 = NULL;
+    if (esp_lcd_rgb_panel_get_frame_buffer(panel, 2, &fb0, &fb1) != ESP_OK) {
+      return false;
+    }
+
+    sync.begin((lv_color_t*)fb0, (lv_color_t*)fb1, w, h, present, &drawBuf, drv);
+    return true;
+  }
+
+  /**
+   * Gibt die Pufferverwaltung zurück (Statistik).
+   */
+  RgbFramebufferSync &getSync() {
+    return sync;
+  }
+
+  /**
+   * Gibt die Anzahl der verpassten VSYNC-Signale zurück.
+   */
+  uint32_t getVsyncTimeouts() {
+    return vsyncTimeouts;
+  }
+};
+
+RgbPanel* RgbPanel::instance = NULL;
+
+#endif // RGB_PANEL_H
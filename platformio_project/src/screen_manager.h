@@ -0,0 +1,210 @@
+#ifndef SCREEN_MANAGER_H
+#define SCREEN_MANAGER_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+// Nicht angezeigte Bildschirme nach dieser Zeit freigeben (0 = nie)
+#ifndef SCREEN_EVICT_AFTER_MS
+#define SCREEN_EVICT_AFTER_MS 60000
+#endif
+
+// Maximale Anzahl gleichzeitig aufgebauter Bildschirme (inkl. des aktiven)
+#ifndef SCREEN_MAX_RESIDENT
+#define SCREEN_MAX_RESIDENT 3
+#endif
+
+// Bekannte Bildschirme
+enum ScreenId {
+  SCREEN_MAIN,
+  SCREEN_PROGRAM,
+  SCREEN_SETTINGS,
+  SCREEN_RUNNING,
+  SCREEN_COMPLETED,
+  SCREEN_ERROR,
+  SCREEN_COUNT
+};
+
+/**
+ * Verwaltet den Lebenszyklus der LVGL-Bildschirme.
+ * Ein Bildschirm wird erst beim ersten Aufruf aufgebaut und, wenn er länger
+ * nicht angezeigt wurde oder zu viele Bildschirme aufgebaut sind, wieder
+ * freigegeben. Der aktive Bildschirm und als resident markierte Bildschirme
+ * werden nie freigegeben.
+ */
+class ScreenManager {
+public:
+  typedef void (*ScreenCreateFn)();
+  typedef void (*ScreenRebindFn)();
+
+private:
+  struct ScreenEntry {
+    lv_obj_t** slot;         // Globaler Zeiger auf den Bildschirm (z.B. &mainScreen)
+    ScreenCreateFn create;   // Baut den Bildschirm auf und setzt *slot
+    ScreenRebindFn rebind;   // Füllt gemeinsame Widgets nach dem Aufbau (oder NULL)
+    bool resident;           // Nie freigeben
+    uint32_t lastShown;      // Zeitpunkt der letzten Anzeige (millis)
+    uint32_t generation;     // Wird bei jedem Aufbau erhöht
+  };
+
+  ScreenEntry screens[SCREEN_COUNT];
+  ScreenId activeScreen;
+
+  // Statistik
+  uint32_t builds;
+  uint32_t evictions;
+
+  /**
+   * Gibt den Widget-Baum eines Bildschirms frei.
+   */
+  void evict(ScreenId id) {
+    ScreenEntry &entry = screens[id];
+    if (entry.slot == NULL || *entry.slot == NULL) {
+      return;
+    }
+
+    lv_obj_del(*entry.slot);
+    *entry.slot = NULL;
+    evictions++;
+  }
+
+public:
+  ScreenManager() : activeScreen(SCREEN_COUNT), builds(0), evictions(0) {
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+      screens[i].slot = NULL;
+      screens[i].create = NULL;
+      screens[i].rebind = NULL;
+      screens[i].resident = false;
+      screens[i].lastShown = 0;
+      screens[i].generation = 0;
+    }
+  }
+
+  /**
+   * Registriert einen Bildschirm.
+   *
+   * @param id Bildschirm-ID
+   * @param slot Adresse des globalen Bildschirmzeigers
+   * @param create Funktion zum Aufbau des Bildschirms
+   * @param rebind Funktion, die gemeinsame Widgets nach dem Aufbau aktualisiert (oder NULL)
+   * @param resident true, wenn der Bildschirm nach dem Aufbau nie freigegeben werden soll
+   */
+  void registerScreen(ScreenId id, lv_obj_t** slot, ScreenCreateFn create, ScreenRebindFn rebind, bool resident) {
+    screens[id].slot = slot;
+    screens[id].create = create;
+    screens[id].rebind = rebind;
+    screens[id].resident = resident;
+  }
+
+  /**
+   * Gibt einen Bildschirm zurück und baut ihn bei Bedarf auf.
+   *
+   * @param id Bildschirm-ID
+   * @return Das Bildschirmobjekt
+   */
+  lv_obj_t* get(ScreenId id) {
+    ScreenEntry &entry = screens[id];
+    if (*entry.slot == NULL) {
+      entry.create();
+      entry.generation++;
+      builds++;
+      if (entry.rebind) {
+        entry.rebind();
+      }
+    }
+    return *entry.slot;
+  }
+
+  /**
+   * Zeigt einen Bildschirm an und wendet anschließend die Freigaberegeln an.
+   *
+   * @param id Bildschirm-ID
+   */
+  void show(ScreenId id) {
+    lv_scr_load(get(id));
+    activeScreen = id;
+    screens[id].lastShown = millis();
+    collect();
+  }
+
+  /**
+   * Gibt Bildschirme frei, die laut Konfiguration nicht mehr benötigt werden.
+   * Sollte regelmäßig aus der Hauptschleife aufgerufen werden.
+   */
+  void collect() {
+    uint32_t now = millis();
+
+    // Nach Alter freigeben
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+      ScreenEntry &entry = screens[i];
+      if (i == activeScreen || entry.resident || entry.slot == NULL || *entry.slot == NULL) {
+        continue;
+      }
+      if (SCREEN_EVICT_AFTER_MS > 0 && now - entry.lastShown >= SCREEN_EVICT_AFTER_MS) {
+        evict((ScreenId)i);
+      }
+    }
+
+    // Zu viele aufgebaute Bildschirme: den am längsten nicht angezeigten freigeben
+    while (getResidentCount() > SCREEN_MAX_RESIDENT) {
+      int oldest = -1;
+      for (int i = 0; i < SCREEN_COUNT; i++) {
+        ScreenEntry &entry = screens[i];
+        if (i == activeScreen || entry.resident || entry.slot == NULL || *entry.slot == NULL) {
+          continue;
+        }
+        if (oldest < 0 || now - entry.lastShown > now - screens[oldest].lastShown) {
+          oldest = i;
+        }
+      }
+      if (oldest < 0) {
+        break;
+      }
+      evict((ScreenId)oldest);
+    }
+  }
+
+  /**
+   * Gibt die Generation eines Bildschirms zurück.
+   * Ändert sich bei jedem Neuaufbau, z.B. um abgeleitete Caches zu verwerfen.
+   */
+  uint32_t getGeneration(ScreenId id) {
+    return screens[id].generation;
+  }
+
+  /**
+   * Gibt die ID des aktiven Bildschirms zurück (SCREEN_COUNT, wenn keiner angezeigt wird).
+   */
+  ScreenId getActive() {
+    return activeScreen;
+  }
+
+  /**
+   * Gibt die Anzahl der aktuell aufgebauten Bildschirme zurück.
+   */
+  int getResidentCount() {
+    int count = 0;
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+      if (screens[i].slot != NULL && *screens[i].slot != NULL) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Gibt die Anzahl der Bildschirmaufbauten zurück.
+   */
+  uint32_t getBuildCount() {
+    return builds;
+  }
+
+  /**
+   * Gibt die Anzahl der freigegebenen Bildschirme zurück.
+   */
+  uint32_t getEvictionCount() {
+    return evictions;
+  }
+};
+
+#endif // SCREEN_MANAGER_H
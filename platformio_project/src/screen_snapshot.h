@@ -0,0 +1,175 @@
+#ifndef SCREEN_SNAPSHOT_H
+#define SCREEN_SNAPSHOT_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <stdlib.h>
+
+#include "screen_manager.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+// Snapshots im PSRAM ablegen, der interne RAM bleibt für LVGL und DMA frei
+#define SNAPSHOT_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#else
+#define SNAPSHOT_ALLOC(size) malloc(size)
+#endif
+
+/**
+ * Cache mit vorgerenderten Bildern statischer Bildschirme.
+ * Beim Wechsel auf einen gecachten Bildschirm wird das Bild direkt an das
+ * Display übertragen, statt den kompletten Objektbaum neu zu rendern.
+ * Der Objektbaum wird trotzdem geladen und übernimmt ab der nächsten
+ * Invalidierung wieder das Zeichnen.
+ *
+ * Ein Snapshot gilt nur für die Generation des Bildschirms und die Version
+ * des Systemzustands, aus denen er erzeugt wurde, und wird bei
+ * Inhaltsänderungen über invalidate() verworfen. Ändert sich der Zustand
+ * von außen (REST, MQTT), wird er so beim nächsten Anzeigen neu aufgenommen.
+ * Liegt etwas auf der obersten Ebene (z.B. das Messwert-Overlay), zeichnet
+ * LVGL den Bildschirm normal, da das Bild diese Ebene nicht enthält.
+ */
+class ScreenSnapshotCache {
+public:
+  // Überträgt ein Vollbild an das Display (von der Anwendung bereitgestellt)
+  typedef void (*SnapshotBlitFn)(const lv_color_t* pixels, uint16_t width, uint16_t height);
+
+private:
+  struct Snapshot {
+    bool cacheable;        // Bildschirm darf gecacht werden
+    bool valid;            // Bild entspricht dem aktuellen Inhalt
+    uint32_t generation;   // Generation des Bildschirms beim Aufnehmen
+    uint32_t stateVersion; // Version des Systemzustands beim Aufnehmen
+    lv_img_dsc_t dsc;      // Bildbeschreibung
+    void* buf;             // Pixeldaten im PSRAM
+    uint32_t bufSize;
+  };
+
+  Snapshot snapshots[SCREEN_COUNT];
+  SnapshotBlitFn blitFn;
+
+  // Statistik
+  uint32_t hits;
+  uint32_t misses;
+
+public:
+  ScreenSnapshotCache() : blitFn(NULL), hits(0), misses(0) {
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+      snapshots[i].cacheable = false;
+      snapshots[i].valid = false;
+      snapshots[i].generation = 0;
+      snapshots[i].stateVersion = 0;
+      snapshots[i].buf = NULL;
+      snapshots[i].bufSize = 0;
+    }
+  }
+
+  /**
+   * Setzt die Funktion, mit der Snapshots an das Display übertragen werden.
+   * Ohne Blit-Funktion bleibt der Cache wirkungslos.
+   */
+  void setBlitCallback(SnapshotBlitFn fn) {
+    blitFn = fn;
+  }
+
+  /**
+   * Legt fest, ob ein Bildschirm gecacht werden darf.
+   */
+  void setCacheable(ScreenId id, bool cacheable) {
+    snapshots[id].cacheable = cacheable;
+  }
+
+  /**
+   * Prüft, ob ein Bildschirm gecacht werden darf.
+   */
+  bool isCacheable(ScreenId id) {
+    return blitFn != NULL && snapshots[id].cacheable;
+  }
+
+  /**
+   * Verwirft den Snapshot eines Bildschirms (z.B. nach einer Inhaltsänderung).
+   */
+  void invalidate(ScreenId id) {
+    snapshots[id].valid = false;
+  }
+
+  /**
+   * Zeigt einen Bildschirm über den Cache an.
+   * Fehlt ein gültiger Snapshot, wird er zuerst aus dem Objektbaum gerendert.
+   *
+   * @param id Bildschirm-ID
+   * @param screen Der bereits aufgebaute und geladene Bildschirm
+   * @param generation Aktuelle Generation des Bildschirms (siehe ScreenManager)
+   * @param stateVersion Aktuelle Version des Systemzustands (siehe system_state.h)
+   * @return true, wenn das Bild übertragen und die Invalidierung verworfen wurde
+   */
+  bool present(ScreenId id, lv_obj_t* screen, uint32_t generation, uint32_t stateVersion) {
+    Snapshot &snap = snapshots[id];
+    if (!isCacheable(id)) {
+      return false;
+    }
+
+    // Das Bild enthält nur den Bildschirm, nicht die oberste Ebene
+    lv_disp_t* disp = lv_obj_get_disp(screen);
+    if (lv_obj_get_child_cnt(lv_disp_get_layer_top(disp)) > 0) {
+      return false;
+    }
+
+    if (!snap.valid || snap.generation != generation || snap.stateVersion != stateVersion) {
+      misses++;
+      if (!capture(snap, screen)) {
+        return false;
+      }
+      snap.generation = generation;
+      snap.stateVersion = stateVersion;
+    } else {
+      hits++;
+    }
+
+    // Vollständige Invalidierung durch lv_scr_load() verwerfen, das Bild ist bereits aktuell
+    disp->inv_p = 0;
+
+    blitFn((const lv_color_t*)snap.dsc.data, snap.dsc.header.w, snap.dsc.header.h);
+    return true;
+  }
+
+  /**
+   * Gibt die Anzahl der Cache-Treffer zurück.
+   */
+  uint32_t getHits() {
+    return hits;
+  }
+
+  /**
+   * Gibt die Anzahl der Cache-Fehlschläge (Neuaufnahmen) zurück.
+   */
+  uint32_t getMisses() {
+    return misses;
+  }
+
+private:
+  /**
+   * Rendert den Bildschirm in den Snapshot-Puffer.
+   */
+  bool capture(Snapshot &snap, lv_obj_t* screen) {
+    uint32_t size = lv_snapshot_buf_size_needed(screen, LV_IMG_CF_TRUE_COLOR);
+    if (size == 0) {
+      return false;
+    }
+
+    if (snap.buf == NULL || snap.bufSize < size) {
+      free(snap.buf);
+      snap.buf = SNAPSHOT_ALLOC(size);
+      snap.bufSize = snap.buf != NULL ? size : 0;
+      if (snap.buf == NULL) {
+        snap.valid = false;
+        return false;
+      }
+    }
+
+    snap.valid = lv_snapshot_take_to_buf(screen, LV_IMG_CF_TRUE_COLOR, &snap.dsc, snap.buf, snap.bufSize) == LV_RES_OK;
+    return snap.valid;
+  }
+};
+
+#endif // SCREEN_SNAPSHOT_H
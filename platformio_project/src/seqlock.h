@@ -0,0 +1,108 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Sequenzsperre für kleine, kopierbare Strukturen mit genau einem Schreiber
+ * und beliebig vielen Lesern. Der Schreiber macht die Sequenznummer vor dem
+ * Kopieren ungerade und danach wieder gerade; ein Leser kopiert die Daten und
+ * wiederholt, falls sich die Nummer dabei geändert hat oder ungerade war.
+ * Leser sperren nie und halten den Schreiber nicht auf. Die Daten liegen als
+ * atomare Worte vor, damit auch ein abgebrochener Lesevorgang definiert bleibt.
+ *
+ * Die halbe Sequenznummer ist die Version: Sie steigt nur, wenn update()
+ * tatsächlich neue Daten ablegt, und taugt so als billige Änderungsprüfung.
+ * Der Schreiber sollte nicht von Lesern mit höherer Priorität auf demselben
+ * Kern unterbrochen werden können, sonst drehen diese bis zum nächsten Tick.
+ */
+template <typename T>
+class Seqlock {
+  static_assert(sizeof(T) % sizeof(uint32_t) == 0, "T muss ein Vielfaches von 4 Bytes groß sein");
+
+private:
+  static const uint32_t WORDS = sizeof(T) / sizeof(uint32_t);
+
+  std::atomic<uint32_t> seq;
+  std::atomic<uint32_t> words[WORDS];
+  std::atomic<uint32_t> retries;  // Wiederholte Lesevorgänge (Statistik)
+
+public:
+  Seqlock() : seq(0), retries(0) {
+    for (uint32_t i = 0; i < WORDS; i++) {
+      words[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Legt neue Daten ab (nur vom Schreiber).
+   * Füllbytes von T sollten genullt sein (memset), sonst gelten gleiche Daten als geändert.
+   *
+   * @param value Neue Daten
+   * @return false, wenn die Daten unverändert waren (Version bleibt gleich)
+   */
+  bool update(const T &value) {
+    uint32_t next[WORDS];
+    memcpy(next, &value, sizeof(T));
+
+    // Nur der Schreiber ändert die Worte, er darf sie ohne Sequenz vergleichen
+    bool changed = false;
+    for (uint32_t i = 0; i < WORDS && !changed; i++) {
+      changed = words[i].load(std::memory_order_relaxed) != next[i];
+    }
+    if (!changed) {
+      return false;
+    }
+
+    uint32_t s = seq.load(std::memory_order_relaxed);
+    seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (uint32_t i = 0; i < WORDS; i++) {
+      words[i].store(next[i], std::memory_order_relaxed);
+    }
+    seq.store(s + 2, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Liest eine in sich stimmige Kopie (aus jedem Task, nicht aus ISRs).
+   *
+   * @param out Ziel der Kopie
+   * @return Version der gelesenen Daten
+   */
+  uint32_t read(T &out) {
+    uint32_t copy[WORDS];
+    for (;;) {
+      uint32_t before = seq.load(std::memory_order_acquire);
+      if ((before & 1) == 0) {
+        for (uint32_t i = 0; i < WORDS; i++) {
+          copy[i] = words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == before) {
+          memcpy(&out, copy, sizeof(T));
+          return before >> 1;
+        }
+      }
+      retries.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Gibt die aktuelle Version zurück, ohne die Daten zu kopieren.
+   */
+  uint32_t version() const {
+    return seq.load(std::memory_order_acquire) >> 1;
+  }
+
+  /**
+   * Gibt die Anzahl der wiederholten Lesevorgänge zurück.
+   */
+  uint32_t getRetries() const {
+    return retries.load(std::memory_order_relaxed);
+  }
+};
+
+#endif // SEQLOCK_H
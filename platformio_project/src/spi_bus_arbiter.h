@@ -0,0 +1,164 @@
+#ifndef SPI_BUS_ARBITER_H
+#define SPI_BUS_ARBITER_H
+
+#include <Arduino.h>
+
+// Plätze für wartende Transaktionen (höchstens eine je Client)
+#define SPI_ARBITER_QUEUE_SIZE 4
+
+// Teilnehmer am gemeinsamen SPI-Bus
+enum SpiClient {
+  SPI_CLIENT_DISPLAY,
+  SPI_CLIENT_TOUCH,
+  SPI_CLIENT_COUNT,
+  SPI_CLIENT_NONE = SPI_CLIENT_COUNT
+};
+
+/**
+ * Vergibt den gemeinsamen SPI-Bus von Display und Touch-Controller.
+ * Das Display belegt den Bus in Blöcken (Teile eines Flushs). Kurze
+ * Transaktionen anderer Clients (z.B. Touch-Abfragen) werden mit submit()
+ * eingereiht und beim nächsten freien Bus ausgeführt, also spätestens
+ * zwischen zwei Display-Blöcken statt erst nach dem ganzen Refresh.
+ *
+ * Alle Aufrufe erfolgen aus der Hauptschleife bzw. aus LVGL-Callbacks,
+ * die Warteschlange ist daher nicht gegen Interrupts abgesichert.
+ */
+class SpiBusArbiter {
+public:
+  typedef void (*BusTransactionFn)();
+
+  struct ClientStats {
+    uint64_t busyUs;        // Gesamte Belegungszeit
+    uint64_t waitUs;        // Gesamte Wartezeit bis zur Zuteilung
+    uint32_t maxWaitUs;     // Längste Wartezeit
+    uint32_t transactions;  // Anzahl der Zuteilungen
+  };
+
+private:
+  struct Transaction {
+    SpiClient client;
+    BusTransactionFn fn;
+    uint32_t requestedAt;
+  };
+
+  Transaction queue[SPI_ARBITER_QUEUE_SIZE];
+  uint8_t queueHead;
+  uint8_t queueCount;
+  bool queued[SPI_CLIENT_COUNT];
+
+  SpiClient owner;
+  uint32_t acquiredAt;
+  uint32_t startedAtMs;
+  ClientStats stats[SPI_CLIENT_COUNT];
+
+public:
+  SpiBusArbiter() : queueHead(0), queueCount(0), owner(SPI_CLIENT_NONE), acquiredAt(0), startedAtMs(0) {
+    memset(queued, 0, sizeof(queued));
+    memset(stats, 0, sizeof(stats));
+  }
+
+  /**
+   * Startet die Statistik (Bezugszeit für die Belegung).
+   */
+  void begin() {
+    startedAtMs = millis();
+  }
+
+  /**
+   * Prüft, ob der Bus gerade belegt ist.
+   */
+  bool isBusy() {
+    return owner != SPI_CLIENT_NONE;
+  }
+
+  /**
+   * Belegt den Bus. Der Aufrufer muss sicherstellen, dass er frei ist.
+   *
+   * @param client Der belegende Client
+   * @param requestedAt Zeitpunkt (micros), ab dem der Client auf den Bus gewartet hat
+   */
+  void acquire(SpiClient client, uint32_t requestedAt) {
+    uint32_t now = micros();
+    uint32_t wait = now - requestedAt;
+
+    ClientStats &s = stats[client];
+    s.waitUs += wait;
+    if (wait > s.maxWaitUs) {
+      s.maxWaitUs = wait;
+    }
+    s.transactions++;
+
+    owner = client;
+    acquiredAt = now;
+  }
+
+  /**
+   * Gibt den Bus frei.
+   */
+  void release() {
+    if (owner == SPI_CLIENT_NONE) {
+      return;
+    }
+    stats[owner].busyUs += micros() - acquiredAt;
+    owner = SPI_CLIENT_NONE;
+  }
+
+  /**
+   * Reiht eine kurze Transaktion ein. Ist der Bus frei, wird sie sofort ausgeführt.
+   * Pro Client wartet höchstens eine Transaktion, weitere Anfragen werden zusammengefasst.
+   *
+   * @param client Der anfragende Client
+   * @param fn Die Transaktion (greift selbst auf den Bus zu)
+   */
+  void submit(SpiClient client, BusTransactionFn fn) {
+    if (queued[client] || queueCount >= SPI_ARBITER_QUEUE_SIZE) {
+      return;
+    }
+
+    Transaction &t = queue[(queueHead + queueCount) % SPI_ARBITER_QUEUE_SIZE];
+    t.client = client;
+    t.fn = fn;
+    t.requestedAt = micros();
+    queueCount++;
+    queued[client] = true;
+
+    if (!isBusy()) {
+      runPending();
+    }
+  }
+
+  /**
+   * Führt alle wartenden Transaktionen aus, solange der Bus frei ist.
+   * Wird zwischen Display-Blöcken und aus der Hauptschleife aufgerufen.
+   */
+  void runPending() {
+    while (queueCount > 0 && !isBusy()) {
+      Transaction t = queue[queueHead];
+      queueHead = (queueHead + 1) % SPI_ARBITER_QUEUE_SIZE;
+      queueCount--;
+      queued[t.client] = false;
+
+      acquire(t.client, t.requestedAt);
+      t.fn();
+      release();
+    }
+  }
+
+  /**
+   * Gibt die Statistik eines Clients zurück.
+   */
+  const ClientStats &getStats(SpiClient client) {
+    return stats[client];
+  }
+
+  /**
+   * Belegung des Busses durch einen Client in Promille seit begin().
+   */
+  uint32_t getOccupancyPermille(SpiClient client) {
+    uint32_t elapsedMs = millis() - startedAtMs;
+    return elapsedMs > 0 ? (uint32_t)(stats[client].busyUs / elapsedMs) : 0;
+  }
+};
+
+#endif // SPI_BUS_ARBITER_H
@@ -0,0 +1,65 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * Lock-freie Warteschlange für genau einen Produzenten und einen Konsumenten.
+ * Produzent und Konsument dürfen in verschiedenen Tasks (oder Task und ISR)
+ * laufen, ohne dass Sperren nötig sind. Die Kapazität muss eine Zweierpotenz
+ * sein, ein Platz bleibt zur Unterscheidung von voll und leer frei.
+ */
+template <typename T, uint16_t Capacity>
+class SpscQueue {
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity muss eine Zweierpotenz sein");
+
+private:
+  T items[Capacity];
+  std::atomic<uint16_t> head;  // Nächster Schreibplatz (nur Produzent)
+  std::atomic<uint16_t> tail;  // Nächster Leseplatz (nur Konsument)
+
+public:
+  SpscQueue() : head(0), tail(0) {
+  }
+
+  /**
+   * Legt ein Element ab (nur vom Produzenten aufrufen).
+   *
+   * @return false, wenn die Warteschlange voll ist
+   */
+  bool push(const T &item) {
+    uint16_t h = head.load(std::memory_order_relaxed);
+    uint16_t next = (h + 1) & (Capacity - 1);
+    if (next == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    items[h] = item;
+    head.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Entnimmt ein Element (nur vom Konsumenten aufrufen).
+   *
+   * @return false, wenn die Warteschlange leer ist
+   */
+  bool pop(T &item) {
+    uint16_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = items[t];
+    tail.store((t + 1) & (Capacity - 1), std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Prüft, ob die Warteschlange leer ist (Momentaufnahme).
+   */
+  bool empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+  }
+};
+
+#endif // SPSC_QUEUE_H
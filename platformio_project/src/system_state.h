@@ -0,0 +1,98 @@
+#ifndef SYSTEM_STATE_H
+#define SYSTEM_STATE_H
+
+#include <Arduino.h>
+
+#include "seqlock.h"
+
+// Globale Variablen für Programmsteuerung
+enum ProgramState {
+  IDLE,
+  RUNNING,
+  COMPLETED,
+  ERROR
+};
+
+struct SystemState {
+  ProgramState state;
+  int activeProgram;      // 1, 2, 3, oder 4 (individuell)
+  uint32_t programDuration;  // Programmdauer in Sekunden
+  uint32_t startTime;     // Zeitpunkt des Programmstarts
+  uint32_t customDays;    // Für individuelles Programm
+  bool tankLevelOk;       // Tankfüllstand OK?
+  bool motorActive;       // Motor läuft?
+  bool remoteControlEnabled; // Fernsteuerung aktiviert?
+  String deviceId;        // Eindeutige Geräte-ID
+};
+
+// Wird in main.cpp (bzw. im nativen Benchmark) definiert
+extern SystemState systemState;
+
+/**
+ * In sich stimmige Kopie des Programmzustands für Leser außerhalb der Steuerung
+ * (REST, MQTT, Telemetrie, Oberfläche). Die Geräte-ID fehlt, sie ändert sich nach
+ * setup() nicht mehr und wird direkt aus systemState gelesen.
+ */
+struct SystemStateSnapshot {
+  ProgramState state;
+  int32_t activeProgram;
+  uint32_t programDuration;
+  uint32_t startTime;
+  uint32_t customDays;
+  uint8_t tankLevelOk;
+  uint8_t motorActive;
+  uint8_t remoteControlEnabled;
+  uint8_t reserved;
+  uint32_t version;  // Steigt mit jeder Änderung, gleiche Version = gleicher Inhalt
+  uint32_t now;      // Uhrzeit (Epoch) beim Lesen, Basis der abgeleiteten Werte
+
+  /**
+   * Verbleibende Programmzeit in Sekunden zum Zeitpunkt now.
+   */
+  uint32_t remainingTime() const {
+    if (state != RUNNING) {
+      return 0;
+    }
+    uint32_t elapsed = now - startTime;
+    return elapsed >= programDuration ? 0 : programDuration - elapsed;
+  }
+
+  /**
+   * Fortschritt in Prozent zum Zeitpunkt now.
+   */
+  int progressPercent() const {
+    if (state != RUNNING || programDuration == 0) {
+      return 0;
+    }
+    uint32_t elapsed = now - startTime;
+    return elapsed >= programDuration ? 100 : (uint64_t)elapsed * 100 / programDuration;
+  }
+};
+
+// Zuletzt veröffentlichter Programmzustand (Schreiber: Steuerungs-Task)
+static Seqlock<SystemStateSnapshot> systemStateSeqlock;
+
+/**
+ * Veröffentlicht systemState für die Leser (nur vom Schreiber des Zustands,
+ * nach jeder Änderung). Ohne Änderung bleibt die Version gleich.
+ *
+ * @return true, wenn sich der Zustand geändert hat
+ */
+inline bool publishSystemState() {
+  SystemStateSnapshot snap;
+  memset(&snap, 0, sizeof(snap));
+  snap.state = systemState.state;
+  snap.activeProgram = systemState.activeProgram;
+  snap.programDuration = systemState.programDuration;
+  snap.startTime = systemState.startTime;
+  snap.customDays = systemState.customDays;
+  snap.tankLevelOk = systemState.tankLevelOk;
+  snap.motorActive = systemState.motorActive;
+  snap.remoteControlEnabled = systemState.remoteControlEnabled;
+  return systemStateSeqlock.update(snap);
+}
+
+// Liest den veröffentlichten Zustand und setzt version und now (main.cpp bzw. nativer Benchmark)
+SystemStateSnapshot getSystemSnapshot();
+
+#endif // SYSTEM_STATE_H
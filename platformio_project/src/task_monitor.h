@@ -0,0 +1,128 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+
+// Anzahl der überwachten Tasks
+#ifndef TASK_MONITOR_SLOTS
+#define TASK_MONITOR_SLOTS 4
+#endif
+
+// Zeitfenster für die CPU-Last in ms
+#ifndef TASK_MONITOR_WINDOW_MS
+#define TASK_MONITOR_WINDOW_MS 1000
+#endif
+
+/**
+ * Misst die CPU-Zeit der Firmware-Tasks.
+ * Jeder Task klammert seine Arbeit zwischen zwei Wartepunkten mit begin()
+ * und end(). Gezählt wird die Zeit, in der der Task rechnet (einschließlich
+ * Unterbrechungen durch höher priorisierte Tasks). Das funktioniert ohne
+ * configGENERATE_RUN_TIME_STATS, das im Arduino-Core nicht aktiviert ist.
+ */
+class TaskMonitor {
+public:
+  struct Stats {
+    const char* name;
+    TaskHandle_t handle;
+    uint32_t loops;         // Durchläufe (begin/end-Paare)
+    uint64_t busyUs;        // Gesamte Rechenzeit
+    uint32_t maxBusyUs;     // Längster Durchlauf
+    uint16_t loadPermille;  // Anteil am letzten Zeitfenster (0-1000)
+    uint32_t stackFree;     // Minimal freier Stack in Bytes
+  };
+
+private:
+  Stats slots[TASK_MONITOR_SLOTS];
+  uint32_t startUs[TASK_MONITOR_SLOTS];
+  uint32_t windowStartUs[TASK_MONITOR_SLOTS];
+  uint32_t windowBusyUs[TASK_MONITOR_SLOTS];
+  uint8_t count;
+
+public:
+  TaskMonitor() : count(0) {
+    memset(slots, 0, sizeof(slots));
+  }
+
+  /**
+   * Meldet einen Task an.
+   *
+   * @param name Anzeigename (Literal)
+   * @param handle FreeRTOS-Task (NULL, wenn er erst noch angelegt wird, siehe setHandle())
+   * @return Platznummer für begin()/end(), -1 wenn alle Plätze belegt sind
+   */
+  int add(const char* name, TaskHandle_t handle) {
+    if (count >= TASK_MONITOR_SLOTS) {
+      return -1;
+    }
+    int slot = count++;
+    slots[slot].name = name;
+    slots[slot].handle = handle;
+    windowStartUs[slot] = micros();
+    windowBusyUs[slot] = 0;
+    return slot;
+  }
+
+  /**
+   * Trägt den FreeRTOS-Task eines vorab angemeldeten Platzes nach.
+   */
+  void setHandle(int slot, TaskHandle_t handle) {
+    if (slot >= 0) {
+      slots[slot].handle = handle;
+    }
+  }
+
+  /**
+   * Markiert den Beginn eines Durchlaufs (nach dem Aufwachen).
+   */
+  void begin(int slot) {
+    if (slot < 0) {
+      return;
+    }
+    startUs[slot] = micros();
+  }
+
+  /**
+   * Markiert das Ende eines Durchlaufs (vor dem Warten).
+   */
+  void end(int slot) {
+    if (slot < 0) {
+      return;
+    }
+    uint32_t now = micros();
+    uint32_t busy = now - startUs[slot];
+    Stats &s = slots[slot];
+    s.loops++;
+    s.busyUs += busy;
+    if (busy > s.maxBusyUs) {
+      s.maxBusyUs = busy;
+    }
+
+    windowBusyUs[slot] += busy;
+    uint32_t window = now - windowStartUs[slot];
+    if (window >= TASK_MONITOR_WINDOW_MS * 1000UL) {
+      s.loadPermille = (uint64_t)windowBusyUs[slot] * 1000 / window;
+      s.stackFree = uxTaskGetStackHighWaterMark(NULL);
+      windowBusyUs[slot] = 0;
+      windowStartUs[slot] = now;
+    }
+  }
+
+  /**
+   * Gibt die Anzahl der angemeldeten Tasks zurück.
+   */
+  uint8_t getCount() {
+    return count;
+  }
+
+  /**
+   * Gibt die Messwerte eines Tasks zurück.
+   */
+  const Stats &get(int slot) {
+    return slots[slot];
+  }
+};
+
+static TaskMonitor taskMonitor;
+
+#endif // TASK_MONITOR_H
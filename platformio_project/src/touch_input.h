@@ -0,0 +1,219 @@
+#ifndef TOUCH_INPUT_H
+#define TOUCH_INPUT_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <atomic>
+
+#include "spsc_queue.h"
+
+// Abtastperiode, solange der Touch gedrückt ist
+#ifndef TOUCH_SAMPLE_PERIOD_MS
+#define TOUCH_SAMPLE_PERIOD_MS 10
+#endif
+
+// Plätze für Druck-/Loslass-Ereignisse (Zweierpotenz)
+#ifndef TOUCH_EVENT_QUEUE_SIZE
+#define TOUCH_EVENT_QUEUE_SIZE 8
+#endif
+
+/**
+ * Interrupt-gesteuerte Touch-Eingabe.
+ * Die PENIRQ-Leitung des Touch-Controllers weckt die Hauptschleife. Erst dann
+ * wird der Controller über SPI abgefragt, und zwar nur so lange, bis der
+ * Touch losgelassen wird. Ohne Berührung findet kein Buszugriff statt.
+ *
+ * Druck- und Loslass-Ereignisse landen in einer lock-freien Warteschlange und
+ * gehen nicht verloren. Bewegungen werden zur jeweils letzten Position
+ * zusammengefasst. Der LVGL-Lese-Callback liest nur noch die Warteschlange.
+ */
+class TouchInput {
+public:
+  // Liest den Controller aus, true bei Berührung (von der Anwendung bereitgestellt)
+  typedef bool (*TouchReadFn)(uint16_t* x, uint16_t* y);
+
+private:
+  struct TouchEvent {
+    uint16_t x;
+    uint16_t y;
+    bool pressed;
+  };
+
+  SpscQueue<TouchEvent, TOUCH_EVENT_QUEUE_SIZE> events;
+  std::atomic<uint32_t> latestPoint;   // x | (y << 16) der letzten Abtastung
+
+  TouchReadFn readFn;
+  uint8_t irqPin;
+  bool pressed;            // Zustand der letzten Abtastung (nur Leser)
+  uint32_t lastSample;
+
+  // Zustand des LVGL-Lese-Callbacks (nur Konsument)
+  bool reportedPressed;
+
+  // Statistik
+  volatile uint32_t interrupts;
+  uint32_t samples;
+  uint32_t dropped;
+
+  static TouchInput* instance;
+  static volatile bool irqPending;
+  static TaskHandle_t volatile waitingTask;
+
+  static void IRAM_ATTR onIrq() {
+    irqPending = true;
+    if (instance != NULL) {
+      instance->interrupts++;
+    }
+
+    // Schlafende Hauptschleife sofort wecken
+    if (waitingTask != NULL) {
+      BaseType_t woken = pdFALSE;
+      vTaskNotifyGiveFromISR(waitingTask, &woken);
+      if (woken) {
+        portYIELD_FROM_ISR();
+      }
+    }
+  }
+
+  static uint32_t packPoint(uint16_t x, uint16_t y) {
+    return (uint32_t)x | ((uint32_t)y << 16);
+  }
+
+public:
+  TouchInput()
+    : latestPoint(0), readFn(NULL), irqPin(0), pressed(false), lastSample(0),
+      reportedPressed(false), interrupts(0), samples(0), dropped(0) {
+  }
+
+  /**
+   * Richtet den Interrupt auf der PENIRQ-Leitung ein (aktiv low).
+   *
+   * @param pin GPIO der PENIRQ-Leitung
+   * @param read Funktion zum Auslesen des Controllers
+   */
+  void begin(uint8_t pin, TouchReadFn read) {
+    irqPin = pin;
+    readFn = read;
+    instance = this;
+    pinMode(irqPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(irqPin), onIrq, FALLING);
+  }
+
+  /**
+   * Prüft, ob eine Abfrage des Controllers fällig ist.
+   */
+  bool needsSample() {
+    return irqPending || (pressed && millis() - lastSample >= TOUCH_SAMPLE_PERIOD_MS);
+  }
+
+  /**
+   * Fragt den Controller ab, wenn ein Interrupt anliegt oder der Touch gedrückt ist.
+   * Nur aufrufen, wenn der SPI-Bus frei ist.
+   *
+   * @return true, wenn ein neues Druck- oder Loslass-Ereignis vorliegt
+   */
+  bool poll() {
+    if (!irqPending && !pressed) {
+      return false;
+    }
+
+    uint32_t now = millis();
+    if (!irqPending && now - lastSample < TOUCH_SAMPLE_PERIOD_MS) {
+      return false;
+    }
+    irqPending = false;
+    lastSample = now;
+
+    uint16_t x = 0, y = 0;
+    bool touched = readFn(&x, &y);
+    samples++;
+
+    if (touched) {
+      latestPoint.store(packPoint(x, y), std::memory_order_release);
+    }
+
+    // Nur Zustandswechsel in die Warteschlange, Bewegungen über latestPoint
+    if (touched == pressed) {
+      return false;
+    }
+    pressed = touched;
+
+    uint32_t point = latestPoint.load(std::memory_order_relaxed);
+    TouchEvent event = {(uint16_t)(point & 0xFFFF), (uint16_t)(point >> 16), touched};
+    if (!events.push(event)) {
+      dropped++;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Liefert den nächsten Zustand an LVGL (aus dem Lese-Callback aufrufen).
+   * Liegen weitere Ereignisse vor, wird LVGL per continue_reading erneut gerufen.
+   */
+  void read(lv_indev_data_t* data) {
+    TouchEvent event;
+    if (events.pop(event)) {
+      reportedPressed = event.pressed;
+      data->point.x = event.x;
+      data->point.y = event.y;
+      data->continue_reading = !events.empty();
+    } else {
+      uint32_t point = latestPoint.load(std::memory_order_acquire);
+      data->point.x = point & 0xFFFF;
+      data->point.y = point >> 16;
+    }
+    data->state = reportedPressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+  }
+
+  /**
+   * Schläft bis zum Timeout oder bis ein Touch-Interrupt auftritt (ersetzt delay()).
+   *
+   * @param ms Maximale Schlafzeit
+   */
+  void sleep(uint32_t ms) {
+    if (ms == 0) {
+      return;
+    }
+    // Erst registrieren, dann prüfen: ein Interrupt dazwischen hinterlässt eine Benachrichtigung
+    waitingTask = xTaskGetCurrentTaskHandle();
+    if (!irqPending) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+    }
+    waitingTask = NULL;
+  }
+
+  /**
+   * Gibt zurück, ob der Touch laut letzter Abtastung gedrückt ist.
+   */
+  bool isPressed() {
+    return pressed;
+  }
+
+  /**
+   * Gibt die Anzahl der Touch-Interrupts zurück.
+   */
+  uint32_t getInterruptCount() {
+    return interrupts;
+  }
+
+  /**
+   * Gibt die Anzahl der SPI-Abfragen des Controllers zurück.
+   */
+  uint32_t getSampleCount() {
+    return samples;
+  }
+
+  /**
+   * Gibt die Anzahl der wegen voller Warteschlange verworfenen Ereignisse zurück.
+   */
+  uint32_t getDroppedCount() {
+    return dropped;
+  }
+};
+
+TouchInput* TouchInput::instance = NULL;
+volatile bool TouchInput::irqPending = false;
+TaskHandle_t volatile TouchInput::waitingTask = NULL;
+
+#endif // TOUCH_INPUT_H
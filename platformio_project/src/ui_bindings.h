@@ -0,0 +1,125 @@
+#ifndef UI_BINDINGS_H
+#define UI_BINDINGS_H
+
+#include <lvgl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ui_progress.h"
+
+// Maximale Länge eines formatierten Label-Textes
+#define UI_BINDING_TEXT_SIZE 96
+
+/**
+ * Zähler der Bindungsschicht für periodisch aktualisierte Widgets.
+ * updated: Aufrufe, die den Widget-Inhalt geändert (und invalidiert) haben
+ * skipped: Aufrufe ohne sichtbare Änderung, bei denen nichts invalidiert wurde
+ */
+struct UiBindingStats {
+  uint32_t updated;
+  uint32_t skipped;
+};
+
+static UiBindingStats uiBindingStats = {0, 0};
+
+/**
+ * Setzt den Text eines Labels nur, wenn er sich vom angezeigten Text unterscheidet.
+ * Als Cache dient der im Label gespeicherte Text selbst, daher bleibt die Bindung
+ * auch gültig, wenn ein Bildschirm neu aufgebaut wird.
+ *
+ * @param label Das zu aktualisierende Label (NULL wird ignoriert)
+ * @param text Der neue Text
+ * @return true, wenn das Label geändert und invalidiert wurde
+ */
+bool uiBindLabelText(lv_obj_t* label, const char* text) {
+    if (label == NULL) {
+        return false;
+    }
+
+    const char* current = lv_label_get_text(label);
+    if (current != NULL && strcmp(current, text) == 0) {
+        uiBindingStats.skipped++;
+        return false;
+    }
+
+    lv_label_set_text(label, text);
+    uiBindingStats.updated++;
+    return true;
+}
+
+/**
+ * Formatiert einen Text wie printf und setzt ihn nur bei Änderung.
+ *
+ * @param label Das zu aktualisierende Label
+ * @param fmt Formatstring
+ * @return true, wenn das Label geändert und invalidiert wurde
+ */
+bool uiBindLabelFmt(lv_obj_t* label, const char* fmt, ...) {
+    char text[UI_BINDING_TEXT_SIZE];
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+
+    return uiBindLabelText(label, text);
+}
+
+/**
+ * Setzt den Wert eines Fortschrittsbalkens nur, wenn er sich ändert.
+ * Verglichen wird mit dem Zielwert des Balkens (auch während einer Animation).
+ *
+ * @param bar Der zu aktualisierende Balken (NULL wird ignoriert)
+ * @param value Neuer Wert
+ * @param anim LV_ANIM_ON für animierten Übergang
+ * @return true, wenn der Balken geändert und invalidiert wurde
+ */
+bool uiBindBarValue(lv_obj_t* bar, int32_t value, lv_anim_enable_t anim) {
+    if (bar == NULL) {
+        return false;
+    }
+
+    if (lv_bar_get_value(bar) == value) {
+        uiBindingStats.skipped++;
+        return false;
+    }
+
+    lv_bar_set_value(bar, value, anim);
+    uiBindingStats.updated++;
+    return true;
+}
+
+/**
+ * Setzt den Wert eines Fortschritts-Widgets (ui_progress.h). Als übersprungen
+ * zählt jede Änderung, die die gezeichnete Position nicht verschiebt.
+ *
+ * @param progress Das zu aktualisierende Widget (NULL wird ignoriert)
+ * @param value Neuer Wert
+ * @param anim LV_ANIM_ON für animierten Übergang (nur bei größeren Sprüngen)
+ * @return true, wenn die Position geändert und die Differenz invalidiert wurde
+ */
+bool uiBindProgressValue(lv_obj_t* progress, int32_t value, lv_anim_enable_t anim) {
+    if (progress == NULL) {
+        return false;
+    }
+
+    if (!uiProgressSetValue(progress, value, anim)) {
+        uiBindingStats.skipped++;
+        return false;
+    }
+
+    uiBindingStats.updated++;
+    return true;
+}
+
+/**
+ * Gibt die Anzahl der übersprungenen Invalidierungen zurück.
+ *
+ * @return Anzahl der Aktualisierungen ohne sichtbare Änderung
+ */
+uint32_t uiBindingSkippedCount() {
+    return uiBindingStats.skipped;
+}
+
+#endif // UI_BINDINGS_H
@@ -0,0 +1,359 @@
+#ifndef UI_DECOR_H
+#define UI_DECOR_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <stdlib.h>
+
+#include "ui_styles.h"
+
+// 1: Verlauf, Rahmen und Schatten von Buttons und Menüs als vorgerenderte Bilder zeichnen
+#ifndef UI_DECOR_CACHE
+#define UI_DECOR_CACHE 0
+#endif
+
+// Anzahl der Bilder (je Art, Größe, Zustand und Hintergrundfarbe eines)
+#ifndef UI_DECOR_CACHE_SLOTS
+#define UI_DECOR_CACHE_SLOTS 16
+#endif
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+// Bilder im PSRAM ablegen, der interne RAM bleibt für LVGL und DMA frei
+#define UI_DECOR_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#else
+#define UI_DECOR_ALLOC(size) malloc(size)
+#endif
+
+// Arten der Dekoration
+enum UiDecorKind {
+  UI_DECOR_BUTTON,  // uiStyles.btn / btnPressed auf einem lv_btn
+  UI_DECOR_MENU,    // uiStyles.menuContainer auf einem Objekt ohne Theme-Styles
+};
+
+/**
+ * Fügt einem Objekt die Styles seiner Dekorationsart hinzu.
+ */
+void uiDecorAddStyles(lv_obj_t* obj, UiDecorKind kind) {
+  if (kind == UI_DECOR_BUTTON) {
+    lv_obj_add_style(obj, &uiStyles.btn, LV_PART_MAIN);
+    lv_obj_add_style(obj, &uiStyles.btnPressed, LV_PART_MAIN | LV_STATE_PRESSED);
+  } else {
+    lv_obj_add_style(obj, &uiStyles.menuContainer, LV_PART_MAIN);
+  }
+}
+
+/**
+ * Cache vorgerenderter Dekorationen (Verlauf, Rahmen, Schatten, Deckkraft).
+ * LVGL zeichnet Schatten und Verläufe mit LV_DRAW_COMPLEX bei jeder
+ * Invalidierung neu, auch bei jedem Drücken eines Buttons. Stattdessen wird
+ * die Dekoration je Art, Größe, Zustand und Hintergrundfarbe einmal in ein
+ * deckendes Bild gerendert und danach nur noch kopiert.
+ *
+ * Das Bild enthält den Hintergrund des Elternobjekts. Dekoriert werden daher
+ * nur Objekte auf einfarbigen, deckenden Eltern; liegt unter einem Menü
+ * weiterer Inhalt, verdeckt ihn das Bild.
+ */
+class UiDecorCache {
+public:
+  struct Stats {
+    uint32_t hits;      // Bild aus dem Cache verwendet
+    uint32_t renders;   // Bild neu gerendert
+    uint32_t evictions; // Unbenutzte Bilder verdrängt
+    uint32_t failures;  // Cache voll oder kein Speicher, Objekt zeichnet selbst
+    uint32_t bytes;     // Belegter Speicher aller Bilder
+    uint32_t renderUs;  // Gesamte Renderzeit der Bilder
+  };
+
+private:
+  struct Entry {
+    bool used;
+    uint16_t refs;       // Anzahl der lv_img-Objekte, die das Bild anzeigen
+    uint32_t lastUse;
+    UiDecorKind kind;
+    bool pressed;
+    lv_coord_t width;
+    lv_coord_t height;
+    lv_color_t background;
+    lv_img_dsc_t dsc;
+  };
+
+  Entry entries[UI_DECOR_CACHE_SLOTS];
+  bool enabled;
+  uint32_t useCounter;
+  Stats stats;
+
+  /**
+   * Ermittelt den Eintrag zu einem Bild aus diesem Cache.
+   */
+  Entry* entryOf(const void* src) {
+    for (int i = 0; i < UI_DECOR_CACHE_SLOTS; i++) {
+      if (entries[i].used && src == &entries[i].dsc) {
+        return &entries[i];
+      }
+    }
+    return NULL;
+  }
+
+  /**
+   * Gibt einen Platz frei: zuerst einen unbenutzten, sonst das am längsten
+   * nicht verwendete Bild, das kein Objekt mehr anzeigt.
+   */
+  Entry* findSlot() {
+    Entry* victim = NULL;
+    for (int i = 0; i < UI_DECOR_CACHE_SLOTS; i++) {
+      Entry &e = entries[i];
+      if (!e.used) {
+        return &e;
+      }
+      if (e.refs == 0 && (victim == NULL || e.lastUse < victim->lastUse)) {
+        victim = &e;
+      }
+    }
+    if (victim != NULL) {
+      // Der LVGL-Bildcache hält das Bild sonst unter derselben Adresse geöffnet
+      lv_img_cache_invalidate_src(&victim->dsc);
+      free((void*)victim->dsc.data);
+      stats.bytes -= victim->dsc.data_size;
+      stats.evictions++;
+      victim->used = false;
+    }
+    return victim;
+  }
+
+  /**
+   * Rendert eine Dekoration über eine unsichtbare Vorlage in ein Bild.
+   * Die Vorlage erhält dieselben Styles (inkl. Theme) wie das echte Objekt.
+   */
+  bool render(Entry &entry) {
+    uint32_t t0 = micros();
+
+    // Temporärer, nie geladener Bildschirm als Halter
+    lv_obj_t* holder = lv_obj_create(NULL);
+    lv_obj_t* canvas = lv_obj_create(holder);
+    lv_obj_remove_style_all(canvas);
+    lv_obj_set_style_bg_color(canvas, entry.background, 0);
+    lv_obj_set_style_bg_opa(canvas, LV_OPA_COVER, 0);
+
+    lv_obj_t* tpl;
+    if (entry.kind == UI_DECOR_BUTTON) {
+      tpl = lv_btn_create(canvas);
+    } else {
+      tpl = lv_obj_create(canvas);
+      lv_obj_remove_style_all(tpl);
+    }
+    uiDecorAddStyles(tpl, entry.kind);
+    lv_obj_set_size(tpl, entry.width, entry.height);
+    if (entry.pressed) {
+      // Zustand direkt setzen: lv_obj_add_state() startet eine Transition und
+      // das Bild zeigte deren Anfangswerte
+      tpl->state = LV_STATE_PRESSED;
+      lv_obj_refresh_style(tpl, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    }
+
+    // Rand für Schatten und Vergrößerung beim Drücken
+    lv_obj_refresh_ext_draw_size(tpl);
+    lv_coord_t margin = _lv_obj_get_ext_draw_size(tpl);
+    lv_obj_set_size(canvas, entry.width + 2 * margin, entry.height + 2 * margin);
+    lv_obj_set_pos(tpl, margin, margin);
+    lv_obj_update_layout(holder);
+
+    bool ok = false;
+    uint32_t size = lv_snapshot_buf_size_needed(canvas, LV_IMG_CF_TRUE_COLOR);
+    void* buf = size > 0 ? UI_DECOR_ALLOC(size) : NULL;
+    if (buf != NULL) {
+      ok = lv_snapshot_take_to_buf(canvas, LV_IMG_CF_TRUE_COLOR, &entry.dsc, buf, size) == LV_RES_OK;
+      if (ok) {
+        stats.bytes += entry.dsc.data_size;
+      } else {
+        free(buf);
+      }
+    }
+    lv_obj_del(holder);
+
+    stats.renderUs += micros() - t0;
+    return ok;
+  }
+
+public:
+  UiDecorCache() : enabled(UI_DECOR_CACHE), useCounter(0) {
+    memset(entries, 0, sizeof(entries));
+    memset(&stats, 0, sizeof(stats));
+  }
+
+  /**
+   * Schaltet die Dekoration über Bilder ein oder aus.
+   * Wirkt nur auf danach dekorierte Objekte.
+   */
+  void setEnabled(bool enable) {
+    enabled = enable;
+  }
+
+  /**
+   * Gibt zurück, ob neue Objekte über Bilder dekoriert werden.
+   */
+  bool isEnabled() {
+    return enabled;
+  }
+
+  /**
+   * Liefert das Bild einer Dekoration und rendert es beim ersten Zugriff.
+   *
+   * @param kind Art der Dekoration
+   * @param width Breite des Objekts
+   * @param height Höhe des Objekts
+   * @param pressed Gedrückter Zustand
+   * @param background Hintergrundfarbe des Elternobjekts
+   * @return Bild mit Rand für den Schatten oder NULL, wenn alle Plätze belegt sind
+   */
+  const lv_img_dsc_t* get(UiDecorKind kind, lv_coord_t width, lv_coord_t height, bool pressed,
+                          lv_color_t background) {
+    useCounter++;
+    for (int i = 0; i < UI_DECOR_CACHE_SLOTS; i++) {
+      Entry &e = entries[i];
+      if (e.used && e.kind == kind && e.width == width && e.height == height &&
+          e.pressed == pressed && e.background.full == background.full) {
+        e.lastUse = useCounter;
+        stats.hits++;
+        return &e.dsc;
+      }
+    }
+
+    // Angezeigte Bilder werden nie verdrängt
+    Entry* slot = findSlot();
+    if (slot == NULL) {
+      stats.failures++;
+      return NULL;
+    }
+
+    slot->kind = kind;
+    slot->width = width;
+    slot->height = height;
+    slot->pressed = pressed;
+    slot->background = background;
+    if (!render(*slot)) {
+      stats.failures++;
+      return NULL;
+    }
+    slot->used = true;
+    slot->refs = 0;
+    slot->lastUse = useCounter;
+    stats.renders++;
+    return &slot->dsc;
+  }
+
+  /**
+   * Meldet, dass ein lv_img-Objekt das Bild anzeigt bzw. nicht mehr anzeigt.
+   * Nur Bilder ohne Anzeige dürfen verdrängt werden.
+   */
+  void retain(const void* src) {
+    Entry* e = entryOf(src);
+    if (e != NULL) {
+      e->refs++;
+    }
+  }
+
+  void release(const void* src) {
+    Entry* e = entryOf(src);
+    if (e != NULL && e->refs > 0) {
+      e->refs--;
+    }
+  }
+
+  /**
+   * Gibt die Statistik zurück.
+   */
+  const Stats &getStats() {
+    return stats;
+  }
+};
+
+static UiDecorCache uiDecorCache;
+
+/**
+ * Prüft, ob ein Elternobjekt einfarbig und deckend ist und damit in das Bild eingerechnet werden kann.
+ */
+bool uiDecorSolidBackground(lv_obj_t* parent) {
+  return parent != NULL &&
+         lv_obj_get_style_bg_opa(parent, LV_PART_MAIN) == LV_OPA_COVER &&
+         lv_obj_get_style_bg_grad_dir(parent, LV_PART_MAIN) == LV_GRAD_DIR_NONE &&
+         lv_obj_get_style_bg_img_src(parent, LV_PART_MAIN) == NULL;
+}
+
+/**
+ * Wählt das passende Bild für Größe und Zustand des Objekts.
+ * Liefert der Cache kein Bild, zeichnet das Objekt seine Dekoration wieder selbst.
+ */
+void uiDecorUpdate(lv_obj_t* obj, lv_obj_t* img) {
+  if (lv_obj_has_flag(img, LV_OBJ_FLAG_HIDDEN)) {
+    return;
+  }
+  lv_coord_t w = lv_obj_get_width(obj);
+  lv_coord_t h = lv_obj_get_height(obj);
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+
+  UiDecorKind kind = (UiDecorKind)(uintptr_t)lv_obj_get_user_data(img);
+  bool pressed = kind == UI_DECOR_BUTTON && lv_obj_has_state(obj, LV_STATE_PRESSED);
+  lv_color_t bg = lv_obj_get_style_bg_color(lv_obj_get_parent(obj), LV_PART_MAIN);
+
+  const lv_img_dsc_t* dsc = uiDecorCache.get(kind, w, h, pressed, bg);
+  if (dsc == NULL) {
+    lv_obj_add_flag(img, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_remove_style(obj, &uiStyles.decorFlat, LV_PART_MAIN);
+    lv_obj_remove_style(obj, &uiStyles.decorFlat, LV_PART_MAIN | LV_STATE_PRESSED);
+    return;
+  }
+  const void* current = lv_img_get_src(img);
+  if (current != dsc) {
+    uiDecorCache.retain(dsc);
+    lv_img_set_src(img, dsc);
+    uiDecorCache.release(current);
+  }
+}
+
+/**
+ * Dekoriert ein Objekt mit den Styles seiner Art. Ist der Cache aktiv und der
+ * Hintergrund des Elternobjekts einfarbig, übernimmt ein vorgerendertes Bild
+ * Hintergrund, Rahmen und Schatten; das Objekt selbst wird transparent.
+ * Vor dem Anlegen der Kindobjekte aufrufen, das Bild muss das erste Kind sein.
+ *
+ * @param obj Das Objekt (Button oder Menü-Container)
+ * @param kind Art der Dekoration
+ */
+void uiDecorate(lv_obj_t* obj, UiDecorKind kind) {
+  uiDecorAddStyles(obj, kind);
+  if (!uiDecorCache.isEnabled() || !uiDecorSolidBackground(lv_obj_get_parent(obj))) {
+    return;
+  }
+
+  lv_obj_add_style(obj, &uiStyles.decorFlat, LV_PART_MAIN);
+  lv_obj_add_style(obj, &uiStyles.decorFlat, LV_PART_MAIN | LV_STATE_PRESSED);
+  // Der Schatten im Bild ragt über das Objekt hinaus
+  lv_obj_add_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+
+  lv_obj_t* img = lv_img_create(obj);
+  lv_obj_move_to_index(img, 0);
+  lv_obj_add_flag(img, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_FLOATING);
+  lv_obj_clear_flag(img, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_align(img, LV_ALIGN_CENTER, 0, 0);
+  lv_obj_set_user_data(img, (void*)(uintptr_t)kind);
+  lv_obj_add_event_cb(img, [](lv_event_t* e) {
+    uiDecorCache.release(lv_img_get_src(lv_event_get_target(e)));
+  }, LV_EVENT_DELETE, NULL);
+
+  lv_obj_add_event_cb(obj, [](lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_SIZE_CHANGED || code == LV_EVENT_PRESSED ||
+        code == LV_EVENT_RELEASED || code == LV_EVENT_PRESS_LOST) {
+      uiDecorUpdate(lv_event_get_current_target(e), (lv_obj_t*)lv_event_get_user_data(e));
+    }
+  }, LV_EVENT_ALL, img);
+
+  // Größe steht erst nach dem Layout fest
+  lv_obj_update_layout(obj);
+  uiDecorUpdate(obj, img);
+}
+
+#endif // UI_DECOR_H
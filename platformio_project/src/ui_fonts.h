@@ -0,0 +1,44 @@
+#ifndef UI_FONTS_H
+#define UI_FONTS_H
+
+#include <lvgl.h>
+
+/**
+ * Schriften der Bedienoberfläche.
+ * Mit UI_FONT_SUBSET=1 werden die von tools/font_subset.py erzeugten
+ * Teilschriften verwendet. Sie enthalten nur die Zeichen der UI-Texte
+ * (inkl. Umlaute) und die genutzten Symbole. Ohne erzeugte Schriften wird
+ * auf die Montserrat-Schriften von LVGL zurückgegriffen.
+ */
+
+#ifndef UI_FONT_SUBSET
+#define UI_FONT_SUBSET 0
+#endif
+
+#if UI_FONT_SUBSET
+LV_FONT_DECLARE(ui_font_14)
+LV_FONT_DECLARE(ui_font_16)
+LV_FONT_DECLARE(ui_font_18)
+LV_FONT_DECLARE(ui_font_20)
+LV_FONT_DECLARE(ui_font_22)
+LV_FONT_DECLARE(ui_font_28)
+LV_FONT_DECLARE(ui_font_48)
+
+#define UI_FONT_14 (&ui_font_14)
+#define UI_FONT_16 (&ui_font_16)
+#define UI_FONT_18 (&ui_font_18)
+#define UI_FONT_20 (&ui_font_20)
+#define UI_FONT_22 (&ui_font_22)
+#define UI_FONT_28 (&ui_font_28)
+#define UI_FONT_48 (&ui_font_48)
+#else
+#define UI_FONT_14 (&lv_font_montserrat_14)
+#define UI_FONT_16 (&lv_font_montserrat_16)
+#define UI_FONT_18 (&lv_font_montserrat_18)
+#define UI_FONT_20 (&lv_font_montserrat_20)
+#define UI_FONT_22 (&lv_font_montserrat_22)
+#define UI_FONT_28 (&lv_font_montserrat_28)
+#define UI_FONT_48 (&lv_font_montserrat_48)
+#endif
+
+#endif // UI_FONTS_H
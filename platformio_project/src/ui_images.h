@@ -0,0 +1,282 @@
+#ifndef UI_IMAGES_H
+#define UI_IMAGES_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Bilder der Bedienoberfläche.
+ * Mit UI_IMAGE_ASSETS=1 stehen die von tools/image_assets.py erzeugten
+ * Bilder als UI_IMG_<NAME> zur Verfügung. Sie liegen lauflängenkodiert
+ * (RGB565) oder mit Farbpalette im Flash und werden beim ersten Zeichnen
+ * einmal in RGB565 ausgepackt. Der LVGL-Bildcache (LV_IMG_CACHE_DEF_SIZE in
+ * lv_conf.h) hält das Ergebnis, weitere Refreshs kopieren nur noch.
+ */
+
+#ifndef UI_IMAGE_ASSETS
+#define UI_IMAGE_ASSETS 0
+#endif
+
+#if UI_IMAGE_ASSETS
+#include "ui_image_assets.h"
+#endif
+
+#if LV_COLOR_DEPTH != 16
+#error "ui_images.h packt Bilder nach RGB565 aus: LV_COLOR_DEPTH 16 erforderlich"
+#endif
+
+// Farbformate der lauflängenkodierten Bilder (muss zu tools/image_assets.py passen)
+#define UI_IMG_CF_RLE       LV_IMG_CF_USER_ENCODED_0  // RGB565
+#define UI_IMG_CF_RLE_ALPHA LV_IMG_CF_USER_ENCODED_1  // RGB565 + Alpha
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+// Ausgepackte Bilder im PSRAM ablegen, der interne RAM bleibt für LVGL und DMA frei
+#define UI_IMAGE_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#else
+#define UI_IMAGE_ALLOC(size) malloc(size)
+#endif
+
+// Eintrag der Bilderliste (UI_IMAGE_ASSET_LIST aus ui_image_assets.h)
+struct UiImageAsset {
+  const char* name;
+  const lv_img_dsc_t* dsc;
+};
+
+/**
+ * Zähler des Bild-Decoders.
+ * lookups: Zeichenvorgänge von Bildern aus uiImageCreate() (je Bildausschnitt einer)
+ * decodes: Auspackvorgänge; was nicht ausgepackt werden musste, kam aus dem Bildcache
+ * decodeUs / maxDecodeUs: Summe und Maximum der Auspackzeit
+ * bytes: aktuell vom Bildcache gehaltene ausgepackte Bilder
+ */
+struct UiImageStats {
+  uint32_t lookups;
+  uint32_t decodes;
+  uint32_t decodeUs;
+  uint32_t maxDecodeUs;
+  uint32_t failures;
+  uint32_t bytes;
+};
+
+static UiImageStats uiImageStats = {0, 0, 0, 0, 0, 0};
+
+static bool uiImageIsRle(lv_img_cf_t cf) {
+  return cf == UI_IMG_CF_RLE || cf == UI_IMG_CF_RLE_ALPHA;
+}
+
+static bool uiImageIsIndexed(lv_img_cf_t cf) {
+  return cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT;
+}
+
+/**
+ * Prüft, ob ein Bild Transparenz enthält (bei Paletten: ein Eintrag mit Alpha < 255).
+ */
+static bool uiImageHasAlpha(const lv_img_dsc_t* img) {
+  if (img->header.cf == UI_IMG_CF_RLE_ALPHA) {
+    return true;
+  }
+  if (uiImageIsIndexed((lv_img_cf_t)img->header.cf)) {
+    uint32_t colors = 1 << lv_img_cf_get_px_size(img->header.cf);
+    const lv_color32_t* palette = (const lv_color32_t*)img->data;
+    for (uint32_t i = 0; i < colors; i++) {
+      if (palette[i].ch.alpha != LV_OPA_COVER) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Schreibt ein Pixel im Format von LV_IMG_CF_TRUE_COLOR(_ALPHA).
+ */
+static inline uint8_t* uiImagePutPixel(uint8_t* out, lv_color_t color, uint8_t opa, bool alpha) {
+  memcpy(out, &color, sizeof(color));
+  out += sizeof(color);
+  if (alpha) {
+    *out++ = opa;
+  }
+  return out;
+}
+
+/**
+ * Packt ein lauflängenkodiertes Bild aus. Steuerbyte < 0x80: das folgende
+ * Pixel n-mal, sonst (Steuerbyte & 0x7F) einzelne Pixel.
+ *
+ * @return false bei beschädigten Daten
+ */
+static bool uiImageDecodeRle(const lv_img_dsc_t* img, uint8_t* out, bool alpha) {
+  const uint8_t* in = img->data;
+  const uint8_t* end = in + img->data_size;
+  uint32_t remaining = (uint32_t)img->header.w * img->header.h;
+  uint32_t unit = alpha ? 3 : 2;
+
+  while (remaining > 0 && in < end) {
+    uint8_t ctrl = *in++;
+    uint32_t count = ctrl & 0x7F;
+    uint32_t literals = (ctrl & 0x80) ? count : 1;
+    if (count == 0 || count > remaining || (uint32_t)(end - in) < literals * unit) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      const uint8_t* px = (ctrl & 0x80) ? in + i * unit : in;
+      uint16_t rgb565 = px[0] | (px[1] << 8);
+      lv_color_t color;
+#if LV_COLOR_16_SWAP
+      color.full = (uint16_t)((rgb565 >> 8) | (rgb565 << 8));
+#else
+      color.full = rgb565;
+#endif
+      out = uiImagePutPixel(out, color, alpha ? px[2] : LV_OPA_COVER, alpha);
+    }
+    in += literals * unit;
+    remaining -= count;
+  }
+  return remaining == 0;
+}
+
+/**
+ * Packt ein Palettenbild im LVGL-Layout aus (Palette, dann Indizes MSB zuerst).
+ */
+static bool uiImageDecodeIndexed(const lv_img_dsc_t* img, uint8_t* out, bool alpha) {
+  uint8_t bpp = lv_img_cf_get_px_size(img->header.cf);
+  uint32_t colors = 1 << bpp;
+  uint32_t w = img->header.w;
+  uint32_t stride = (w * bpp + 7) / 8;
+  if (img->data_size < colors * sizeof(lv_color32_t) + stride * img->header.h) {
+    return false;
+  }
+
+  const lv_color32_t* palette = (const lv_color32_t*)img->data;
+  lv_color_t colorTable[256];
+  for (uint32_t i = 0; i < colors; i++) {
+    colorTable[i] = lv_color_make(palette[i].ch.red, palette[i].ch.green, palette[i].ch.blue);
+  }
+
+  const uint8_t* rows = img->data + colors * sizeof(lv_color32_t);
+  uint8_t mask = colors - 1;
+  for (uint32_t y = 0; y < img->header.h; y++) {
+    const uint8_t* row = rows + y * stride;
+    for (uint32_t x = 0; x < w; x++) {
+      uint32_t bit = x * bpp;
+      uint8_t index = (row[bit / 8] >> (8 - bpp - bit % 8)) & mask;
+      out = uiImagePutPixel(out, colorTable[index], palette[index].ch.alpha, alpha);
+    }
+  }
+  return true;
+}
+
+static uint32_t uiImageDecodedSize(const lv_img_header_t* header) {
+  uint32_t pxSize = header->cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+  return (uint32_t)header->w * header->h * pxSize;
+}
+
+/**
+ * Übernimmt lauflängenkodierte und Palettenbilder aus dem Flash und meldet
+ * sie als RGB565 (mit Alpha, falls nötig). Alle anderen Bilder (Snapshots,
+ * Dekorationen) bleiben beim eingebauten Decoder.
+ */
+static lv_res_t uiImageInfoCb(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header) {
+  if (lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) {
+    return LV_RES_INV;
+  }
+  const lv_img_dsc_t* img = (const lv_img_dsc_t*)src;
+  lv_img_cf_t cf = (lv_img_cf_t)img->header.cf;
+  if (img->data == NULL || (!uiImageIsRle(cf) && !uiImageIsIndexed(cf))) {
+    return LV_RES_INV;
+  }
+
+  *header = img->header;
+  header->cf = uiImageHasAlpha(img) ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+  return LV_RES_OK;
+}
+
+/**
+ * Packt das Bild vollständig aus. Das Ergebnis bleibt geöffnet, solange es
+ * im Bildcache liegt; ohne Cache wird bei jedem Zeichnen neu ausgepackt.
+ */
+static lv_res_t uiImageOpenCb(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+  if (dsc->src_type != LV_IMG_SRC_VARIABLE) {
+    return LV_RES_INV;
+  }
+  const lv_img_dsc_t* img = (const lv_img_dsc_t*)dsc->src;
+  bool alpha = dsc->header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+  uint32_t size = uiImageDecodedSize(&dsc->header);
+
+  uint32_t t0 = micros();
+  uint8_t* buf = (uint8_t*)UI_IMAGE_ALLOC(size);
+  if (buf == NULL) {
+    uiImageStats.failures++;
+    return LV_RES_INV;
+  }
+  bool ok = uiImageIsRle((lv_img_cf_t)img->header.cf) ? uiImageDecodeRle(img, buf, alpha)
+                                                       : uiImageDecodeIndexed(img, buf, alpha);
+  if (!ok) {
+    free(buf);
+    uiImageStats.failures++;
+    return LV_RES_INV;
+  }
+  uint32_t us = micros() - t0;
+
+  dsc->img_data = buf;
+  uiImageStats.decodes++;
+  uiImageStats.decodeUs += us;
+  uiImageStats.maxDecodeUs = LV_MAX(uiImageStats.maxDecodeUs, us);
+  uiImageStats.bytes += size;
+  return LV_RES_OK;
+}
+
+static void uiImageCloseCb(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+  if (dsc->img_data != NULL) {
+    uiImageStats.bytes -= uiImageDecodedSize(&dsc->header);
+    free((void*)dsc->img_data);
+    dsc->img_data = NULL;
+  }
+}
+
+/**
+ * Registriert den Decoder. Nach lv_init() einmal aufrufen; neue Decoder
+ * stehen in LVGL vor dem eingebauten und werden daher zuerst gefragt.
+ */
+void uiImagesInit() {
+  static bool registered = false;
+  if (registered) {
+    return;
+  }
+  lv_img_decoder_t* decoder = lv_img_decoder_create();
+  lv_img_decoder_set_info_cb(decoder, uiImageInfoCb);
+  lv_img_decoder_set_open_cb(decoder, uiImageOpenCb);
+  lv_img_decoder_set_close_cb(decoder, uiImageCloseCb);
+  registered = true;
+}
+
+/**
+ * Erstellt ein Bildobjekt und zählt seine Zeichenvorgänge für die Trefferquote.
+ *
+ * @param parent Elternobjekt
+ * @param src Bild (z.B. UI_IMG_LOGO)
+ * @return Das Bildobjekt
+ */
+lv_obj_t* uiImageCreate(lv_obj_t* parent, const lv_img_dsc_t* src) {
+  lv_obj_t* img = lv_img_create(parent);
+  lv_img_set_src(img, src);
+  lv_obj_add_event_cb(img, [](lv_event_t* e) {
+    uiImageStats.lookups++;
+  }, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+  return img;
+}
+
+/**
+ * Anteil der Zeichenvorgänge in Prozent, die ohne Auspacken auskamen.
+ */
+uint32_t uiImageHitRate() {
+  if (uiImageStats.lookups == 0 || uiImageStats.decodes >= uiImageStats.lookups) {
+    return 0;
+  }
+  return (uiImageStats.lookups - uiImageStats.decodes) * 100 / uiImageStats.lookups;
+}
+
+#endif // UI_IMAGES_H
@@ -0,0 +1,433 @@
+#ifndef UI_PROGRESS_H
+#define UI_PROGRESS_H
+
+#include <lvgl.h>
+
+#include "ui_styles.h"
+
+// Fortschrittsbalken-Typen
+enum ProgressBarType {
+  BAR_HORIZONTAL,
+  BAR_VERTICAL,
+  BAR_CIRCULAR,   // Geschlossener Ring, beginnt oben
+  BAR_ARC         // Offener Bogen über 270°, wie ein Zeigerinstrument
+};
+
+// Animiert wird erst ab dieser Verschiebung in Pixeln, kleinere Schritte springen
+#ifndef UI_PROGRESS_ANIM_MIN_PX
+#define UI_PROGRESS_ANIM_MIN_PX 8
+#endif
+
+// Dauer der Animation in ms
+#ifndef UI_PROGRESS_ANIM_MS
+#define UI_PROGRESS_ANIM_MS 300
+#endif
+
+/**
+ * Zustand eines Fortschritts-Widgets (im user_data des Objekts, LVGL-Heap).
+ * Neben dem Wert wird seine Position gespeichert: bei Balken die Anzahl
+ * gefüllter Pixel, bei Bogen und Ring der Winkel in Grad. Ein neuer Wert,
+ * der auf dieselbe Position fällt, ändert daher nichts am Bildschirm.
+ */
+struct UiProgress {
+  ProgressBarType type;
+  int32_t min;
+  int32_t max;
+  int32_t value;
+  int32_t target;   // Position des aktuellen Werts
+  int32_t shown;    // Gezeichnete Position (weicht während einer Animation ab)
+};
+
+/**
+ * Zähler aller Fortschritts-Widgets.
+ * moved: Positionsänderungen (mit Invalidierung)
+ * subPixel: Wertänderungen ohne sichtbare Verschiebung
+ * animated: davon animiert
+ * invalidatedPixels: Summe der invalidierten Flächen
+ */
+struct UiProgressStats {
+  uint32_t moved;
+  uint32_t subPixel;
+  uint32_t animated;
+  uint32_t invalidatedPixels;
+};
+
+static UiProgressStats uiProgressStats = {0, 0, 0, 0};
+
+static UiProgress* uiProgressGet(lv_obj_t* obj) {
+  return obj != NULL ? (UiProgress*)lv_obj_get_user_data(obj) : NULL;
+}
+
+/**
+ * Fläche, in der der Balken gefüllt wird (Objekt abzüglich Innenabstand).
+ */
+static void uiProgressTrack(lv_obj_t* obj, lv_area_t* track) {
+  lv_obj_get_coords(obj, track);
+  track->x1 += lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
+  track->x2 -= lv_obj_get_style_pad_right(obj, LV_PART_MAIN);
+  track->y1 += lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
+  track->y2 -= lv_obj_get_style_pad_bottom(obj, LV_PART_MAIN);
+}
+
+/**
+ * Startwinkel und Umfang des Bogens in Grad (0° = rechts, im Uhrzeigersinn).
+ */
+static void uiProgressArcAngles(const UiProgress* p, int32_t* start, int32_t* span) {
+  if (p->type == BAR_CIRCULAR) {
+    *start = 270;
+    *span = 360;
+  } else {
+    *start = 135;
+    *span = 270;
+  }
+}
+
+/**
+ * Außenradius des Bogens: halbe kürzere Seite.
+ */
+static lv_coord_t uiProgressArcRadius(lv_obj_t* obj) {
+  return LV_MIN(lv_obj_get_width(obj), lv_obj_get_height(obj)) / 2;
+}
+
+static lv_coord_t uiProgressArcWidth(lv_obj_t* obj) {
+  return LV_MAX(lv_obj_get_style_arc_width(obj, LV_PART_MAIN),
+                lv_obj_get_style_arc_width(obj, LV_PART_INDICATOR));
+}
+
+/**
+ * Umfang der Position: Pixel der Füllstrecke bzw. Grad des Bogens.
+ */
+static int32_t uiProgressSpan(lv_obj_t* obj, const UiProgress* p) {
+  if (p->type == BAR_HORIZONTAL || p->type == BAR_VERTICAL) {
+    lv_area_t track;
+    uiProgressTrack(obj, &track);
+    int32_t len = p->type == BAR_HORIZONTAL ? lv_area_get_width(&track) : lv_area_get_height(&track);
+    return LV_MAX(len, 0);
+  }
+  int32_t start, span;
+  uiProgressArcAngles(p, &start, &span);
+  return span;
+}
+
+/**
+ * Rechnet einen Wert in eine Position um (abgerundet).
+ */
+static int32_t uiProgressPosition(lv_obj_t* obj, const UiProgress* p, int32_t value) {
+  if (p->max <= p->min || value <= p->min) {
+    return 0;
+  }
+  int32_t span = uiProgressSpan(obj, p);
+  if (value >= p->max) {
+    return span;
+  }
+  return (int32_t)(((int64_t)(value - p->min) * span) / (p->max - p->min));
+}
+
+/**
+ * Länge einer Positionsänderung in Pixeln. Beim Bogen zählt der Außenumfang,
+ * ein Grad entspricht dort r * π / 180 Pixeln.
+ */
+static int32_t uiProgressDeltaPixels(lv_obj_t* obj, const UiProgress* p, int32_t delta) {
+  if (delta < 0) {
+    delta = -delta;
+  }
+  if (p->type == BAR_HORIZONTAL || p->type == BAR_VERTICAL) {
+    return delta;
+  }
+  return (delta * uiProgressArcRadius(obj) * 355) / (180 * 113);
+}
+
+/**
+ * Erweitert eine Fläche um den Punkt im Abstand r unter dem Winkel angle.
+ */
+static void uiProgressAreaAddPolar(lv_area_t* area, const lv_point_t* center, int32_t r, int32_t angle) {
+  lv_coord_t x = center->x + ((r * lv_trigo_sin(angle + 90)) >> LV_TRIGO_SHIFT);
+  lv_coord_t y = center->y + ((r * lv_trigo_sin(angle)) >> LV_TRIGO_SHIFT);
+  area->x1 = LV_MIN(area->x1, x);
+  area->x2 = LV_MAX(area->x2, x);
+  area->y1 = LV_MIN(area->y1, y);
+  area->y2 = LV_MAX(area->y2, y);
+}
+
+/**
+ * Invalidiert nur den Teil, der sich zwischen zwei Positionen ändert:
+ * bei Balken die Pixelspalten (bzw. -zeilen) dazwischen, beim Bogen das
+ * umschließende Rechteck des Bogensegments samt abgerundeter Enden.
+ */
+static void uiProgressInvalidate(lv_obj_t* obj, const UiProgress* p, int32_t from, int32_t to) {
+  if (from == to) {
+    return;
+  }
+  int32_t lo = LV_MIN(from, to);
+  int32_t hi = LV_MAX(from, to);
+
+  lv_area_t area;
+  if (p->type == BAR_HORIZONTAL || p->type == BAR_VERTICAL) {
+    uiProgressTrack(obj, &area);
+    if (p->type == BAR_HORIZONTAL) {
+      lv_coord_t x0 = area.x1;
+      area.x1 = x0 + lo;
+      area.x2 = x0 + hi - 1;
+    } else {
+      // Gefüllt wird von unten nach oben
+      lv_coord_t y0 = area.y2;
+      area.y1 = y0 - hi + 1;
+      area.y2 = y0 - lo;
+    }
+  } else {
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_point_t center;
+    center.x = coords.x1 + lv_obj_get_width(obj) / 2;
+    center.y = coords.y1 + lv_obj_get_height(obj) / 2;
+    int32_t outer = uiProgressArcRadius(obj);
+    int32_t inner = LV_MAX(outer - uiProgressArcWidth(obj), 0);
+
+    int32_t start, span;
+    uiProgressArcAngles(p, &start, &span);
+    int32_t a0 = start + lo;
+    int32_t a1 = start + hi;
+
+    area.x1 = LV_COORD_MAX;
+    area.y1 = LV_COORD_MAX;
+    area.x2 = LV_COORD_MIN;
+    area.y2 = LV_COORD_MIN;
+    uiProgressAreaAddPolar(&area, &center, outer, a0);
+    uiProgressAreaAddPolar(&area, &center, inner, a0);
+    uiProgressAreaAddPolar(&area, &center, outer, a1);
+    uiProgressAreaAddPolar(&area, &center, inner, a1);
+    // Achsenpunkte innerhalb des Segments begrenzen den Bogen nach außen
+    for (int32_t a = (a0 / 90 + 1) * 90; a < a1; a += 90) {
+      uiProgressAreaAddPolar(&area, &center, outer, a);
+    }
+
+    // Abgerundete Enden und Kantenglättung
+    lv_area_increase(&area, uiProgressArcWidth(obj) / 2 + 2, uiProgressArcWidth(obj) / 2 + 2);
+  }
+
+  uiProgressStats.invalidatedPixels += lv_area_get_size(&area);
+  lv_obj_invalidate_area(obj, &area);
+}
+
+/**
+ * Setzt die gezeichnete Position und invalidiert nur die Differenz.
+ */
+static void uiProgressShow(lv_obj_t* obj, int32_t pos) {
+  UiProgress* p = uiProgressGet(obj);
+  if (p == NULL || p->shown == pos) {
+    return;
+  }
+  uiProgressInvalidate(obj, p, p->shown, pos);
+  p->shown = pos;
+}
+
+static void uiProgressAnimCb(void* var, int32_t pos) {
+  uiProgressShow((lv_obj_t*)var, pos);
+}
+
+/**
+ * Zeichnet die Füllung. Den Balkenhintergrund zeichnet bereits lv_obj selbst.
+ * Der Indikator wird immer über die volle Füllstrecke gezeichnet und nur auf
+ * den gefüllten Teil beschnitten. So bleibt ein Farbverlauf an der Strecke
+ * fest und ein wachsender Balken ändert wirklich nur die neuen Spalten.
+ */
+static void uiProgressDraw(lv_event_t* e) {
+  lv_obj_t* obj = lv_event_get_target(e);
+  UiProgress* p = uiProgressGet(obj);
+  if (p == NULL) {
+    return;
+  }
+  lv_draw_ctx_t* drawCtx = lv_event_get_draw_ctx(e);
+
+  if (p->type == BAR_HORIZONTAL || p->type == BAR_VERTICAL) {
+    if (p->shown <= 0) {
+      return;
+    }
+    lv_area_t track;
+    uiProgressTrack(obj, &track);
+    lv_area_t fill = track;
+    if (p->type == BAR_HORIZONTAL) {
+      fill.x2 = fill.x1 + p->shown - 1;
+    } else {
+      fill.y1 = fill.y2 - p->shown + 1;
+    }
+
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, &fill, drawCtx->clip_area)) {
+      return;
+    }
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_INDICATOR, &dsc);
+
+    const lv_area_t* clipOrig = drawCtx->clip_area;
+    drawCtx->clip_area = &clip;
+    lv_draw_rect(drawCtx, &dsc, &track);
+    drawCtx->clip_area = clipOrig;
+    return;
+  }
+
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  lv_point_t center;
+  center.x = coords.x1 + lv_obj_get_width(obj) / 2;
+  center.y = coords.y1 + lv_obj_get_height(obj) / 2;
+  uint16_t radius = uiProgressArcRadius(obj);
+
+  int32_t start, span;
+  uiProgressArcAngles(p, &start, &span);
+
+  lv_draw_arc_dsc_t dsc;
+  lv_draw_arc_dsc_init(&dsc);
+  lv_obj_init_draw_arc_dsc(obj, LV_PART_MAIN, &dsc);
+  if (span >= 360) {
+    lv_draw_arc(drawCtx, &dsc, &center, radius, 0, 360);
+  } else {
+    lv_draw_arc(drawCtx, &dsc, &center, radius, start, (start + span) % 360);
+  }
+
+  if (p->shown <= 0) {
+    return;
+  }
+  lv_draw_arc_dsc_init(&dsc);
+  lv_obj_init_draw_arc_dsc(obj, LV_PART_INDICATOR, &dsc);
+  if (p->shown >= 360) {
+    lv_draw_arc(drawCtx, &dsc, &center, radius, 0, 360);
+  } else {
+    lv_draw_arc(drawCtx, &dsc, &center, radius, start % 360, (start + p->shown) % 360);
+  }
+}
+
+static void uiProgressEventCb(lv_event_t* e) {
+  lv_obj_t* obj = lv_event_get_target(e);
+  lv_event_code_t code = lv_event_get_code(e);
+
+  if (code == LV_EVENT_DRAW_MAIN) {
+    uiProgressDraw(e);
+  } else if (code == LV_EVENT_SIZE_CHANGED || code == LV_EVENT_STYLE_CHANGED) {
+    // Geometrie geändert: LVGL zeichnet das Objekt ohnehin neu
+    UiProgress* p = uiProgressGet(obj);
+    if (p != NULL) {
+      lv_anim_del(obj, uiProgressAnimCb);
+      p->target = uiProgressPosition(obj, p, p->value);
+      p->shown = p->target;
+    }
+  } else if (code == LV_EVENT_DELETE) {
+    lv_anim_del(obj, uiProgressAnimCb);
+    lv_mem_free(uiProgressGet(obj));
+    lv_obj_set_user_data(obj, NULL);
+  }
+}
+
+/**
+ * Erstellt ein Fortschritts-Widget. Anders als lv_bar zeichnet es bei einer
+ * Wertänderung nur den Teil neu, der sich tatsächlich ändert, und gar nichts,
+ * solange die Änderung unter einem Pixel (bzw. einem Grad) bleibt.
+ * Balken verwenden barBg/barIndicator, Bogen und Ring arcBg/arcIndicator.
+ *
+ * @param parent Elternobjekt
+ * @param type Darstellung (Balken, Ring oder Bogen)
+ * @return Das Widget (Wertebereich 0-100), NULL bei fehlendem Speicher
+ */
+lv_obj_t* uiProgressCreate(lv_obj_t* parent, ProgressBarType type) {
+  UiProgress* p = (UiProgress*)lv_mem_alloc(sizeof(UiProgress));
+  if (p == NULL) {
+    return NULL;
+  }
+  p->type = type;
+  p->min = 0;
+  p->max = 100;
+  p->value = 0;
+  p->target = 0;
+  p->shown = 0;
+
+  lv_obj_t* obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+  if (type == BAR_HORIZONTAL || type == BAR_VERTICAL) {
+    lv_obj_add_style(obj, &uiStyles.barBg, LV_PART_MAIN);
+    lv_obj_add_style(obj, &uiStyles.barIndicator, LV_PART_INDICATOR);
+  } else {
+    lv_obj_add_style(obj, &uiStyles.arcBg, LV_PART_MAIN);
+    lv_obj_add_style(obj, &uiStyles.arcIndicator, LV_PART_INDICATOR);
+  }
+
+  lv_obj_set_user_data(obj, p);
+  lv_obj_add_event_cb(obj, uiProgressEventCb, LV_EVENT_ALL, NULL);
+  return obj;
+}
+
+/**
+ * Setzt den Wertebereich. Die Position wird neu berechnet und nur die
+ * Differenz invalidiert.
+ *
+ * @param obj Fortschritts-Widget
+ * @param min Untergrenze
+ * @param max Obergrenze
+ */
+void uiProgressSetRange(lv_obj_t* obj, int32_t min, int32_t max) {
+  UiProgress* p = uiProgressGet(obj);
+  if (p == NULL || (p->min == min && p->max == max)) {
+    return;
+  }
+  p->min = min;
+  p->max = max;
+  lv_anim_del(obj, uiProgressAnimCb);
+  p->target = uiProgressPosition(obj, p, p->value);
+  uiProgressShow(obj, p->target);
+}
+
+/**
+ * Setzt den Wert. Bleibt die Position gleich (Änderung unter einem Pixel bzw.
+ * einem Grad), wird weder invalidiert noch animiert. Kleine Schritte unter
+ * UI_PROGRESS_ANIM_MIN_PX springen direkt, da eine Animation dort nur
+ * zusätzliche Refreshs kostet. Jeder Animationsschritt invalidiert ebenfalls
+ * nur die Differenz zum vorigen.
+ *
+ * @param obj Fortschritts-Widget
+ * @param value Neuer Wert
+ * @param anim LV_ANIM_ON für animierten Übergang
+ * @return true, wenn sich die Position geändert hat
+ */
+bool uiProgressSetValue(lv_obj_t* obj, int32_t value, lv_anim_enable_t anim) {
+  UiProgress* p = uiProgressGet(obj);
+  if (p == NULL) {
+    return false;
+  }
+  p->value = value;
+
+  int32_t target = uiProgressPosition(obj, p, value);
+  if (target == p->target) {
+    uiProgressStats.subPixel++;
+    return false;
+  }
+  p->target = target;
+  uiProgressStats.moved++;
+
+  lv_anim_del(obj, uiProgressAnimCb);
+  if (anim == LV_ANIM_OFF || uiProgressDeltaPixels(obj, p, target - p->shown) < UI_PROGRESS_ANIM_MIN_PX) {
+    uiProgressShow(obj, target);
+    return true;
+  }
+
+  lv_anim_t a;
+  lv_anim_init(&a);
+  lv_anim_set_var(&a, obj);
+  lv_anim_set_exec_cb(&a, uiProgressAnimCb);
+  lv_anim_set_values(&a, p->shown, target);
+  lv_anim_set_time(&a, UI_PROGRESS_ANIM_MS);
+  lv_anim_start(&a);
+  uiProgressStats.animated++;
+  return true;
+}
+
+/**
+ * Gibt den zuletzt gesetzten Wert zurück.
+ */
+int32_t uiProgressGetValue(lv_obj_t* obj) {
+  UiProgress* p = uiProgressGet(obj);
+  return p != NULL ? p->value : 0;
+}
+
+#endif // UI_PROGRESS_H
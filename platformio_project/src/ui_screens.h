@@ -0,0 +1,626 @@
+#ifndef UI_SCREENS_H
+#define UI_SCREENS_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+#include "system_state.h"
+#include "ui_bindings.h"
+#include "ui_decor.h"
+#include "ui_images.h"
+#include "ui_styles.h"
+#include "screen_manager.h"
+
+// 1: Statische Bildschirme als vorgerenderte Bilder zwischenspeichern (PSRAM)
+#ifndef UI_SNAPSHOT_CACHE
+#define UI_SNAPSHOT_CACHE 0
+#endif
+
+#if UI_SNAPSHOT_CACHE
+#include "screen_snapshot.h"
+#endif
+
+/**
+ * Bildschirme der Bedienoberfläche.
+ * Enthält nur LVGL-Code ohne Hardwarezugriffe, damit dieselben Bildschirme
+ * auch im nativen Benchmark (env:native) gebaut werden können.
+ */
+
+// LVGL-Sprites und Widgets
+static lv_obj_t *mainScreen;
+static lv_obj_t *programScreen;
+static lv_obj_t *settingsScreen;
+static lv_obj_t *runningScreen;
+static lv_obj_t *completedScreen;
+static lv_obj_t *errorScreen;
+
+// Anzeigen für den aktuellen Programm-Status
+static lv_obj_t *programLabel;
+static lv_obj_t *timeLabel;
+static lv_obj_t *progressBar;
+static lv_obj_t *statusLabel;
+
+// Zuletzt gesetzter Statustext, wird beim Neuaufbau des Hauptbildschirms übernommen
+static const char *statusText = "Bereit für Desinfektion"; // UI-Text
+
+// Baut Bildschirme bei Bedarf auf und gibt ungenutzte wieder frei
+static ScreenManager screenManager;
+
+#if UI_SNAPSHOT_CACHE
+// Vorgerenderte Bilder der statischen Bildschirme
+static ScreenSnapshotCache snapshotCache;
+#endif
+
+// Von der Anwendung bereitgestellt (main.cpp bzw. nativer Benchmark)
+void startProgram(int programIndex);
+void stopProgram();
+void setCustomDays(int days);
+void setRemoteControl(bool enabled);
+void resetWiFiConfig();
+
+/**
+ * Setzt den globalen Zeiger eines gemeinsam genutzten Widgets auf NULL,
+ * sobald das Widget mit seinem Bildschirm freigegeben wird.
+ *
+ * @param slot Adresse des globalen Widget-Zeigers
+ */
+void uiTrackWidget(lv_obj_t **slot) {
+  lv_obj_add_event_cb(*slot, [](lv_event_t *e) {
+    lv_obj_t **target = (lv_obj_t **)lv_event_get_user_data(e);
+    *target = NULL;
+  }, LV_EVENT_DELETE, slot);
+}
+
+/**
+ * Verwirft das vorgerenderte Bild eines Bildschirms nach einer Inhaltsänderung.
+ *
+ * @param id Bildschirm-ID
+ */
+void uiInvalidateSnapshot(ScreenId id) {
+#if UI_SNAPSHOT_CACHE
+  snapshotCache.invalidate(id);
+#endif
+}
+
+/**
+ * Verwirft das Bild des Bildschirms, dessen Widget seinen Wert geändert hat.
+ * Für Eingabe-Widgets (Spinbox, Slider, Switch) auf gecachten Bildschirmen.
+ *
+ * @param obj Das Eingabe-Widget
+ * @param id Bildschirm, zu dem das Widget gehört
+ */
+void uiTrackValueChanges(lv_obj_t *obj, ScreenId id) {
+  lv_obj_add_event_cb(obj, [](lv_event_t *e) {
+    uiInvalidateSnapshot((ScreenId)(uintptr_t)lv_event_get_user_data(e));
+  }, LV_EVENT_VALUE_CHANGED, (void *)(uintptr_t)id);
+}
+
+/**
+ * Setzt den Statustext auf dem Hauptbildschirm.
+ * Der Text wird auch gemerkt, wenn der Hauptbildschirm gerade nicht aufgebaut ist.
+ *
+ * @param text Statustext (muss dauerhaft gültig sein, z.B. ein Literal)
+ */
+void setStatusText(const char *text) {
+  statusText = text;
+  if (uiBindLabelText(statusLabel, text)) {
+    uiInvalidateSnapshot(SCREEN_MAIN);
+  }
+}
+
+/**
+ * Zeigt einen Bildschirm an und baut ihn bei Bedarf auf.
+ * Gecachte Bildschirme werden als vorgerendertes Bild übertragen.
+ *
+ * @param id Bildschirm-ID
+ */
+void uiShowScreen(ScreenId id) {
+  screenManager.show(id);
+#if UI_SNAPSHOT_CACHE
+  snapshotCache.present(id, screenManager.get(id), screenManager.getGeneration(id), systemStateSeqlock.version());
+#endif
+}
+
+// Formatiert Zeit in Tage, Stunden, Minuten
+String formatTime(uint32_t seconds) {
+  uint32_t days = seconds / (24 * 60 * 60);
+  seconds %= (24 * 60 * 60);
+  uint32_t hours = seconds / (60 * 60);
+  seconds %= (60 * 60);
+  uint32_t minutes = seconds / 60;
+  
+  return String(days) + " Tage " + String(hours) + " Std " + String(minutes) + " Min"; // UI-Text
+}
+
+// Erstellt den Hauptbildschirm
+void createMainScreen() {
+  mainScreen = lv_obj_create(NULL);
+  lv_obj_add_style(mainScreen, &uiStyles.screen, 0);
+  
+  // Titel
+  lv_obj_t *title = lv_label_create(mainScreen);
+  lv_label_set_text(title, "Desinfektionseinheit");
+  lv_obj_add_style(title, &uiStyles.title, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+  
+#ifdef UI_IMG_LOGO
+  // Logo (aus generated-icon.png, siehe tools/image_assets.py)
+  lv_obj_t *logo = uiImageCreate(mainScreen, UI_IMG_LOGO);
+  lv_obj_align(logo, LV_ALIGN_TOP_LEFT, 20, 10);
+#endif
+  
+  // Programmauswahl-Button
+  lv_obj_t *programBtn = lv_btn_create(mainScreen);
+  lv_obj_set_size(programBtn, 300, 80);
+  lv_obj_align(programBtn, LV_ALIGN_CENTER, 0, -80);
+  lv_obj_add_event_cb(programBtn, [](lv_event_t *e) {
+    uiShowScreen(SCREEN_PROGRAM);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *programLabel = lv_label_create(programBtn);
+  lv_label_set_text(programLabel, "Programme");
+  lv_obj_center(programLabel);
+  
+  // Einstellungen-Button
+  lv_obj_t *settingsBtn = lv_btn_create(mainScreen);
+  lv_obj_set_size(settingsBtn, 300, 80);
+  lv_obj_align(settingsBtn, LV_ALIGN_CENTER, 0, 20);
+  lv_obj_add_event_cb(settingsBtn, [](lv_event_t *e) {
+    uiShowScreen(SCREEN_SETTINGS);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *settingsLabel = lv_label_create(settingsBtn);
+  lv_label_set_text(settingsLabel, "Einstellungen");
+  lv_obj_center(settingsLabel);
+  
+  // Status-Anzeige
+  statusLabel = lv_label_create(mainScreen);
+  lv_label_set_text(statusLabel, statusText);
+  uiTrackWidget(&statusLabel);
+  lv_obj_add_style(statusLabel, &uiStyles.text, 0);
+  lv_obj_align(statusLabel, LV_ALIGN_BOTTOM_MID, 0, -30);
+}
+
+// Erstellt den Programm-Auswahlbildschirm
+void createProgramScreen() {
+  programScreen = lv_obj_create(NULL);
+  lv_obj_add_style(programScreen, &uiStyles.screen, 0);
+  
+  // Titel
+  lv_obj_t *title = lv_label_create(programScreen);
+  lv_label_set_text(title, "Programmauswahl");
+  lv_obj_add_style(title, &uiStyles.title, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+  
+  // Programm 1 Button (7 Tage)
+  lv_obj_t *prog1Btn = lv_btn_create(programScreen);
+  lv_obj_set_size(prog1Btn, 700, 60);
+  uiDecorate(prog1Btn, UI_DECOR_BUTTON);
+  lv_obj_align(prog1Btn, LV_ALIGN_TOP_MID, 0, 80);
+  lv_obj_add_event_cb(prog1Btn, [](lv_event_t *e) {
+    startProgram(1);
+    uiShowScreen(SCREEN_RUNNING);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *prog1Label = lv_label_create(prog1Btn);
+  lv_label_set_text(prog1Label, "Programm 1: 7 Tage Desinfektion");
+  lv_obj_center(prog1Label);
+  
+  // Programm 2 Button (14 Tage)
+  lv_obj_t *prog2Btn = lv_btn_create(programScreen);
+  lv_obj_set_size(prog2Btn, 700, 60);
+  uiDecorate(prog2Btn, UI_DECOR_BUTTON);
+  lv_obj_align(prog2Btn, LV_ALIGN_TOP_MID, 0, 150);
+  lv_obj_add_event_cb(prog2Btn, [](lv_event_t *e) {
+    startProgram(2);
+    uiShowScreen(SCREEN_RUNNING);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *prog2Label = lv_label_create(prog2Btn);
+  lv_label_set_text(prog2Label, "Programm 2: 14 Tage Desinfektion");
+  lv_obj_center(prog2Label);
+  
+  // Programm 3 Button (21 Tage)
+  lv_obj_t *prog3Btn = lv_btn_create(programScreen);
+  lv_obj_set_size(prog3Btn, 700, 60);
+  uiDecorate(prog3Btn, UI_DECOR_BUTTON);
+  lv_obj_align(prog3Btn, LV_ALIGN_TOP_MID, 0, 220);
+  lv_obj_add_event_cb(prog3Btn, [](lv_event_t *e) {
+    startProgram(3);
+    uiShowScreen(SCREEN_RUNNING);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *prog3Label = lv_label_create(prog3Btn);
+  lv_label_set_text(prog3Label, "Programm 3: 21 Tage Desinfektion");
+  lv_obj_center(prog3Label);
+  
+  // Individuelles Programm Button
+  lv_obj_t *prog4Btn = lv_btn_create(programScreen);
+  lv_obj_set_size(prog4Btn, 700, 60);
+  uiDecorate(prog4Btn, UI_DECOR_BUTTON);
+  lv_obj_align(prog4Btn, LV_ALIGN_TOP_MID, 0, 290);
+  
+  // Individuelles Programm mit Eingabe
+  static lv_obj_t *daysSpinbox;
+  daysSpinbox = lv_spinbox_create(programScreen);
+  uiTrackWidget(&daysSpinbox);
+  uiTrackValueChanges(daysSpinbox, SCREEN_PROGRAM);
+  lv_spinbox_set_range(daysSpinbox, 1, 99);
+  lv_spinbox_set_value(daysSpinbox, getSystemSnapshot().customDays);
+  lv_obj_set_size(daysSpinbox, 150, 50);
+  lv_obj_align(daysSpinbox, LV_ALIGN_TOP_MID, 0, 360);
+  
+  lv_obj_t *daysLabel = lv_label_create(programScreen);
+  lv_label_set_text(daysLabel, "Individuelle Tage:");
+  lv_obj_add_style(daysLabel, &uiStyles.text, 0);
+  lv_obj_align(daysLabel, LV_ALIGN_TOP_MID, -120, 370);
+  
+  // Minus Button für Spinbox
+  lv_obj_t *minusBtn = lv_btn_create(programScreen);
+  lv_obj_set_size(minusBtn, 50, 50);
+  uiDecorate(minusBtn, UI_DECOR_BUTTON);
+  lv_obj_align(minusBtn, LV_ALIGN_TOP_MID, -100, 360);
+  lv_obj_add_event_cb(minusBtn, [](lv_event_t *e) {
+    lv_spinbox_decrement((lv_obj_t*)daysSpinbox);
+    setCustomDays(lv_spinbox_get_value(daysSpinbox));
+    uiInvalidateSnapshot(SCREEN_PROGRAM);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *minusLabel = lv_label_create(minusBtn);
+  lv_label_set_text(minusLabel, "-");
+  lv_obj_center(minusLabel);
+  
+  // Plus Button für Spinbox
+  lv_obj_t *plusBtn = lv_btn_create(programScreen);
+  lv_obj_set_size(plusBtn, 50, 50);
+  uiDecorate(plusBtn, UI_DECOR_BUTTON);
+  lv_obj_align(plusBtn, LV_ALIGN_TOP_MID, 100, 360);
+  lv_obj_add_event_cb(plusBtn, [](lv_event_t *e) {
+    lv_spinbox_increment((lv_obj_t*)daysSpinbox);
+    setCustomDays(lv_spinbox_get_value(daysSpinbox));
+    uiInvalidateSnapshot(SCREEN_PROGRAM);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *plusLabel = lv_label_create(plusBtn);
+  lv_label_set_text(plusLabel, "+");
+  lv_obj_center(plusLabel);
+  
+  // Start individuelles Programm Button
+  lv_obj_t *startCustomBtn = lv_btn_create(programScreen);
+  lv_obj_set_size(startCustomBtn, 300, 60);
+  uiDecorate(startCustomBtn, UI_DECOR_BUTTON);
+  lv_obj_align(startCustomBtn, LV_ALIGN_BOTTOM_MID, 0, -60);
+  lv_obj_add_event_cb(startCustomBtn, [](lv_event_t *e) {
+    // Beide Befehle laufen in dieser Reihenfolge durch die Befehlswarteschlange
+    setCustomDays(lv_spinbox_get_value((lv_obj_t*)daysSpinbox));
+    startProgram(4);
+    uiShowScreen(SCREEN_RUNNING);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *startCustomLabel = lv_label_create(startCustomBtn);
+  lv_label_set_text(startCustomLabel, "Individuelles Programm starten");
+  lv_obj_center(startCustomLabel);
+  
+  // Zurück Button
+  lv_obj_t *backBtn = lv_btn_create(programScreen);
+  lv_obj_set_size(backBtn, 150, 60);
+  uiDecorate(backBtn, UI_DECOR_BUTTON);
+  lv_obj_align(backBtn, LV_ALIGN_BOTTOM_LEFT, 20, -20);
+  lv_obj_add_event_cb(backBtn, [](lv_event_t *e) {
+    uiShowScreen(SCREEN_MAIN);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *backLabel = lv_label_create(backBtn);
+  lv_label_set_text(backLabel, "Zurück");
+  lv_obj_center(backLabel);
+}
+
+// Erstellt den Einstellungsbildschirm
+void createSettingsScreen() {
+  settingsScreen = lv_obj_create(NULL);
+  lv_obj_add_style(settingsScreen, &uiStyles.screen, 0);
+  
+  // Titel
+  lv_obj_t *title = lv_label_create(settingsScreen);
+  lv_label_set_text(title, "Einstellungen");
+  lv_obj_add_style(title, &uiStyles.title, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+  
+  // Helligkeit-Schieberegler
+  lv_obj_t *brightnessLabel = lv_label_create(settingsScreen);
+  lv_label_set_text(brightnessLabel, "Display-Helligkeit");
+  lv_obj_add_style(brightnessLabel, &uiStyles.text, 0);
+  lv_obj_align(brightnessLabel, LV_ALIGN_TOP_MID, 0, 80);
+  
+  lv_obj_t *brightnessSlider = lv_slider_create(settingsScreen);
+  lv_obj_set_size(brightnessSlider, 400, 20);
+  lv_obj_align(brightnessSlider, LV_ALIGN_TOP_MID, 0, 120);
+  lv_slider_set_range(brightnessSlider, 10, 100);
+  lv_slider_set_value(brightnessSlider, 80, LV_ANIM_OFF);
+  uiTrackValueChanges(brightnessSlider, SCREEN_SETTINGS);
+  
+  // Datum und Uhrzeit einstellen
+  lv_obj_t *dateTimeLabel = lv_label_create(settingsScreen);
+  lv_label_set_text(dateTimeLabel, "Datum und Uhrzeit");
+  lv_obj_add_style(dateTimeLabel, &uiStyles.text, 0);
+  lv_obj_align(dateTimeLabel, LV_ALIGN_TOP_MID, -180, 160);
+  
+  lv_obj_t *dateTimeBtn = lv_btn_create(settingsScreen);
+  lv_obj_set_size(dateTimeBtn, 250, 60);
+  lv_obj_align(dateTimeBtn, LV_ALIGN_TOP_MID, -180, 200);
+  
+  lv_obj_t *dateTimeBtnLabel = lv_label_create(dateTimeBtn);
+  lv_label_set_text(dateTimeBtnLabel, "Datum/Uhrzeit einstellen");
+  lv_obj_center(dateTimeBtnLabel);
+  
+  // Tank-Niveau-Kalibrierung
+  lv_obj_t *tankCalibLabel = lv_label_create(settingsScreen);
+  lv_label_set_text(tankCalibLabel, "Tank-Sensor kalibrieren");
+  lv_obj_add_style(tankCalibLabel, &uiStyles.text, 0);
+  lv_obj_align(tankCalibLabel, LV_ALIGN_TOP_MID, 180, 160);
+  
+  lv_obj_t *tankCalibBtn = lv_btn_create(settingsScreen);
+  lv_obj_set_size(tankCalibBtn, 250, 60);
+  lv_obj_align(tankCalibBtn, LV_ALIGN_TOP_MID, 180, 200);
+  
+  lv_obj_t *tankCalibBtnLabel = lv_label_create(tankCalibBtn);
+  lv_label_set_text(tankCalibBtnLabel, "Kalibrieren");
+  lv_obj_center(tankCalibBtnLabel);
+  
+  // WiFi-Einstellungen
+  lv_obj_t *wifiLabel = lv_label_create(settingsScreen);
+  lv_label_set_text(wifiLabel, "WLAN-Verbindung");
+  lv_obj_add_style(wifiLabel, &uiStyles.text, 0);
+  lv_obj_align(wifiLabel, LV_ALIGN_TOP_MID, -180, 280);
+  
+  lv_obj_t *wifiBtn = lv_btn_create(settingsScreen);
+  lv_obj_set_size(wifiBtn, 250, 60);
+  lv_obj_align(wifiBtn, LV_ALIGN_TOP_MID, -180, 320);
+  lv_obj_add_event_cb(wifiBtn, [](lv_event_t *e) {
+    // WLAN zurücksetzen und Access Point starten
+    resetWiFiConfig();
+    setStatusText("WLAN-Konfiguration gestartet");
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *wifiBtnLabel = lv_label_create(wifiBtn);
+  lv_label_set_text(wifiBtnLabel, "WLAN konfigurieren");
+  lv_obj_center(wifiBtnLabel);
+  
+  // Remote-Steuerung aktivieren/deaktivieren
+  lv_obj_t *remoteLabel = lv_label_create(settingsScreen);
+  lv_label_set_text(remoteLabel, "Fernsteuerung");
+  lv_obj_add_style(remoteLabel, &uiStyles.text, 0);
+  lv_obj_align(remoteLabel, LV_ALIGN_TOP_MID, 180, 280);
+  
+  static lv_obj_t *remoteSwitch;
+  remoteSwitch = lv_switch_create(settingsScreen);
+  uiTrackWidget(&remoteSwitch);
+  uiTrackValueChanges(remoteSwitch, SCREEN_SETTINGS);
+  lv_obj_align(remoteSwitch, LV_ALIGN_TOP_MID, 180, 320);
+  if (getSystemSnapshot().remoteControlEnabled) {
+    lv_obj_add_state(remoteSwitch, LV_STATE_CHECKED);
+  }
+  lv_obj_add_event_cb(remoteSwitch, [](lv_event_t *e) {
+    bool enabled = lv_obj_has_state(remoteSwitch, LV_STATE_CHECKED);
+    setRemoteControl(enabled);
+    if (enabled) {
+      setStatusText("Fernsteuerung aktiviert");
+    } else {
+      setStatusText("Fernsteuerung deaktiviert");
+    }
+  }, LV_EVENT_VALUE_CHANGED, NULL);
+  
+  // Geräte-ID anzeigen
+  lv_obj_t *deviceIdLabel = lv_label_create(settingsScreen);
+  lv_label_set_text(deviceIdLabel, "Geräte-ID:");
+  lv_obj_add_style(deviceIdLabel, &uiStyles.text, 0);
+  lv_obj_align(deviceIdLabel, LV_ALIGN_BOTTOM_MID, 0, -80);
+  
+  lv_obj_t *deviceIdValue = lv_label_create(settingsScreen);
+  lv_label_set_text(deviceIdValue, systemState.deviceId.c_str());
+  lv_obj_add_style(deviceIdValue, &uiStyles.textAccent, 0);
+  lv_obj_align(deviceIdValue, LV_ALIGN_BOTTOM_MID, 0, -60);
+  
+  // Zurück Button
+  lv_obj_t *backBtn = lv_btn_create(settingsScreen);
+  lv_obj_set_size(backBtn, 150, 60);
+  lv_obj_align(backBtn, LV_ALIGN_BOTTOM_LEFT, 20, -20);
+  lv_obj_add_event_cb(backBtn, [](lv_event_t *e) {
+    uiShowScreen(SCREEN_MAIN);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *backLabel = lv_label_create(backBtn);
+  lv_label_set_text(backLabel, "Zurück");
+  lv_obj_center(backLabel);
+}
+
+// Erstellt den Bildschirm für laufende Programme
+void createRunningScreen() {
+  runningScreen = lv_obj_create(NULL);
+  lv_obj_add_style(runningScreen, &uiStyles.screen, 0);
+  
+  // Titel
+  lv_obj_t *title = lv_label_create(runningScreen);
+  lv_label_set_text(title, "Programm aktiv");
+  lv_obj_add_style(title, &uiStyles.title, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+  
+  // Programm-Name
+  programLabel = lv_label_create(runningScreen);
+  uiTrackWidget(&programLabel);
+  lv_label_set_text(programLabel, "Programm 2: 14 Tage Desinfektion");
+  lv_obj_add_style(programLabel, &uiStyles.heading, 0);
+  lv_obj_align(programLabel, LV_ALIGN_TOP_MID, 0, 80);
+  
+  // Fortschrittsbalken (zeichnet nur die neu gefüllten Pixelspalten)
+  progressBar = uiProgressCreate(runningScreen, BAR_HORIZONTAL);
+  uiTrackWidget(&progressBar);
+  lv_obj_set_size(progressBar, 700, 30);
+  lv_obj_align(progressBar, LV_ALIGN_TOP_MID, 0, 130);
+  
+  // Zeit-Anzeige
+  timeLabel = lv_label_create(runningScreen);
+  uiTrackWidget(&timeLabel);
+  lv_label_set_text(timeLabel, "Verbleibende Zeit: 14 Tage 0 Std 0 Min");
+  lv_obj_add_style(timeLabel, &uiStyles.textLarge, 0);
+  lv_obj_align(timeLabel, LV_ALIGN_TOP_MID, 0, 180);
+  
+  // Tank-Status Anzeige
+  lv_obj_t *tankStatusLabel = lv_label_create(runningScreen);
+  lv_label_set_text(tankStatusLabel, "Tank-Status:");
+  lv_obj_add_style(tankStatusLabel, &uiStyles.text, 0);
+  lv_obj_align(tankStatusLabel, LV_ALIGN_TOP_MID, -80, 240);
+  
+  lv_obj_t *tankStatusIcon = lv_label_create(runningScreen);
+  lv_label_set_text(tankStatusIcon, LV_SYMBOL_OK);
+  lv_obj_add_style(tankStatusIcon, &uiStyles.iconOk, 0);
+  lv_obj_align(tankStatusIcon, LV_ALIGN_TOP_MID, 20, 240);
+  
+  // Stop-Button
+  lv_obj_t *stopBtn = lv_btn_create(runningScreen);
+  lv_obj_set_size(stopBtn, 250, 60);
+  lv_obj_align(stopBtn, LV_ALIGN_BOTTOM_MID, 0, -60);
+  lv_obj_add_style(stopBtn, &uiStyles.btnDanger, 0);
+  lv_obj_add_event_cb(stopBtn, [](lv_event_t *e) {
+    stopProgram();
+    uiShowScreen(SCREEN_MAIN);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *stopLabel = lv_label_create(stopBtn);
+  lv_label_set_text(stopLabel, "Programm stoppen");
+  lv_obj_center(stopLabel);
+}
+
+// Erstellt den Bildschirm für abgeschlossene Programme
+void createCompletedScreen() {
+  completedScreen = lv_obj_create(NULL);
+  lv_obj_add_style(completedScreen, &uiStyles.screenSuccess, 0);
+  
+  // Titel
+  lv_obj_t *title = lv_label_create(completedScreen);
+  lv_label_set_text(title, "Programm abgeschlossen");
+  lv_obj_add_style(title, &uiStyles.title, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+  
+  // Erfolgssymbol
+  lv_obj_t *successIcon = lv_label_create(completedScreen);
+  lv_label_set_text(successIcon, LV_SYMBOL_OK);
+  lv_obj_add_style(successIcon, &uiStyles.iconSuccess, 0);
+  lv_obj_align(successIcon, LV_ALIGN_CENTER, 0, -60);
+  
+  // Erfolgsmeldung
+  lv_obj_t *successMessage = lv_label_create(completedScreen);
+  lv_label_set_text(successMessage, "Desinfektion erfolgreich abgeschlossen!");
+  lv_obj_add_style(successMessage, &uiStyles.heading, 0);
+  lv_obj_align(successMessage, LV_ALIGN_CENTER, 0, 20);
+  
+  // Zurück zum Hauptmenü Button
+  lv_obj_t *homeBtn = lv_btn_create(completedScreen);
+  lv_obj_set_size(homeBtn, 300, 60);
+  lv_obj_align(homeBtn, LV_ALIGN_BOTTOM_MID, 0, -60);
+  lv_obj_add_event_cb(homeBtn, [](lv_event_t *e) {
+    uiShowScreen(SCREEN_MAIN);
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *homeLabel = lv_label_create(homeBtn);
+  lv_label_set_text(homeLabel, "Zum Hauptmenü");
+  lv_obj_center(homeLabel);
+}
+
+// Erstellt den Fehlerbildschirm
+void createErrorScreen() {
+  errorScreen = lv_obj_create(NULL);
+  lv_obj_add_style(errorScreen, &uiStyles.screenError, 0);
+  
+  // Titel
+  lv_obj_t *title = lv_label_create(errorScreen);
+  lv_label_set_text(title, "Fehler");
+  lv_obj_add_style(title, &uiStyles.title, 0);
+  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 20);
+  
+  // Fehlersymbol
+  lv_obj_t *errorIcon = lv_label_create(errorScreen);
+  lv_label_set_text(errorIcon, LV_SYMBOL_WARNING);
+  lv_obj_add_style(errorIcon, &uiStyles.iconWarning, 0);
+  lv_obj_align(errorIcon, LV_ALIGN_CENTER, 0, -60);
+  
+  // Fehlermeldung
+  lv_obj_t *errorMessage = lv_label_create(errorScreen);
+  lv_label_set_text(errorMessage, "Tankfüllstand zu niedrig!");
+  lv_obj_add_style(errorMessage, &uiStyles.heading, 0);
+  lv_obj_align(errorMessage, LV_ALIGN_CENTER, 0, 0);
+  
+  // Anweisungen
+  lv_obj_t *instructions = lv_label_create(errorScreen);
+  lv_label_set_text(instructions, "Bitte Tank auffüllen und neu starten.");
+  lv_obj_add_style(instructions, &uiStyles.text, 0);
+  lv_obj_align(instructions, LV_ALIGN_CENTER, 0, 40);
+  
+  // OK-Button
+  lv_obj_t *okBtn = lv_btn_create(errorScreen);
+  lv_obj_set_size(okBtn, 200, 60);
+  lv_obj_align(okBtn, LV_ALIGN_BOTTOM_MID, 0, -60);
+  lv_obj_add_event_cb(okBtn, [](lv_event_t *e) {
+    if (getSystemSnapshot().tankLevelOk) {
+      uiShowScreen(SCREEN_MAIN);
+    }
+  }, LV_EVENT_CLICKED, NULL);
+  
+  lv_obj_t *okLabel = lv_label_create(okBtn);
+  lv_label_set_text(okLabel, "OK");
+  lv_obj_center(okLabel);
+}
+
+// Aktualisiert die Anzeige im laufenden Programm
+void updateRunningScreen() {
+  // Eine Momentaufnahme für alle Werte, Name, Balken und Zeit passen so immer zusammen
+  SystemStateSnapshot snap = getSystemSnapshot();
+  if (snap.state != RUNNING) return;
+  
+  // Programm-Label aktualisieren (ändert sich nur beim Programmwechsel)
+  const char* programNames[] = {"Programm 1: 7 Tage", "Programm 2: 14 Tage", "Programm 3: 21 Tage", "Individuell"}; // UI-Text
+  uiBindLabelFmt(programLabel, "%s Desinfektion", programNames[snap.activeProgram - 1]);
+  
+  // Fortschrittsbalken aktualisieren: Sekundenauflösung statt Prozent, der
+  // Balken wächst damit pixelgenau und invalidiert nur bei einer neuen Spalte
+  uint32_t remaining = snap.remainingTime();
+  uint32_t elapsed = snap.programDuration > remaining ? snap.programDuration - remaining : 0;
+  uiProgressSetRange(progressBar, 0, snap.programDuration);
+  uiBindProgressValue(progressBar, elapsed, LV_ANIM_ON);
+  
+  // Zeitanzeige aktualisieren (Minutenauflösung, ändert sich nur jede 60. Sekunde)
+  if (snap.activeProgram == 4 && snap.programDuration == 0) {
+    // Für individuelles Programm ohne Zeitbegrenzung
+    uiBindLabelText(timeLabel, "Individuelles Programm läuft");
+  } else {
+    // Für Programme mit Zeitbegrenzung
+    uiBindLabelFmt(timeLabel, "Verbleibende Zeit: %s", formatTime(remaining).c_str());
+  }
+}
+
+/**
+ * Registriert alle Bildschirme beim Screen-Manager.
+ * Aufgebaut wird erst beim ersten Aufruf von uiShowScreen().
+ */
+void uiInitScreens() {
+  uiStylesInit();
+  uiImagesInit();
+
+  screenManager.registerScreen(SCREEN_MAIN, &mainScreen, createMainScreen, NULL, true);
+  screenManager.registerScreen(SCREEN_PROGRAM, &programScreen, createProgramScreen, NULL, false);
+  screenManager.registerScreen(SCREEN_SETTINGS, &settingsScreen, createSettingsScreen, NULL, false);
+  screenManager.registerScreen(SCREEN_RUNNING, &runningScreen, createRunningScreen, updateRunningScreen, false);
+  screenManager.registerScreen(SCREEN_COMPLETED, &completedScreen, createCompletedScreen, NULL, false);
+  screenManager.registerScreen(SCREEN_ERROR, &errorScreen, createErrorScreen, NULL, false);
+
+#if UI_SNAPSHOT_CACHE
+  // Statische Bildschirme cachen, der Laufbildschirm ändert sich ständig
+  snapshotCache.setCacheable(SCREEN_MAIN, true);
+  snapshotCache.setCacheable(SCREEN_PROGRAM, true);
+  snapshotCache.setCacheable(SCREEN_SETTINGS, true);
+  snapshotCache.setCacheable(SCREEN_COMPLETED, true);
+  snapshotCache.setCacheable(SCREEN_ERROR, true);
+#endif
+}
+
+#endif // UI_SCREENS_H
@@ -0,0 +1,295 @@
+#ifndef UI_STYLES_H
+#define UI_STYLES_H
+
+#include <lvgl.h>
+
+#include "ui_fonts.h"
+
+/**
+ * Zentrale Style-Registry der Bedienoberfläche.
+ * Alle Styles werden einmal beim Start mit uiStylesInit() aufgebaut und danach
+ * nur noch per lv_obj_add_style() referenziert. Das ersetzt lokale Styles
+ * (lv_obj_set_style_*), die LVGL pro Objekt im Heap anlegt, und die
+ * funktionslokalen Styles, die bei jedem Aufruf neu initialisiert wurden.
+ */
+struct UiStyles {
+  // Bildschirmhintergründe
+  lv_style_t screen;          // Standard (Dunkelblau)
+  lv_style_t screenSuccess;   // Programm abgeschlossen (Grün)
+  lv_style_t screenError;     // Fehler (Rot)
+
+  // Texte
+  lv_style_t text;            // Weiß, Standardschrift
+  lv_style_t textMuted;       // Grau, Beschriftungen
+  lv_style_t textAccent;      // Türkis, hervorgehobene Werte
+  lv_style_t textLarge;       // Weiß, 20 pt
+  lv_style_t textClock;       // Weiß, 18 pt
+  lv_style_t heading;         // Weiß, 22 pt
+  lv_style_t title;           // Weiß, 28 pt
+  lv_style_t subtitle;        // Grau, 16 pt
+
+  // Symbole
+  lv_style_t iconOk;          // Grün
+  lv_style_t iconSuccess;     // Weiß, 48 pt
+  lv_style_t iconWarning;     // Gelb, 48 pt
+
+  // Buttons
+  lv_style_t btn;
+  lv_style_t btnPressed;
+  lv_style_t btnDanger;
+
+  // Fortschrittsbalken
+  lv_style_t barBg;
+  lv_style_t barIndicator;
+  lv_style_t arcBg;           // Bogen/Ring: Hintergrund
+  lv_style_t arcIndicator;    // Bogen/Ring: Füllung
+
+  // Trennlinien
+  lv_style_t divider;
+  lv_style_t menuDivider;
+
+  // Statusindikator
+  lv_style_t statusDot;
+  lv_style_t statusError;
+  lv_style_t statusOk;
+  lv_style_t statusWarning;
+
+  // Menüsystem
+  lv_style_t menuItem;
+  lv_style_t menuItemSelected;
+  lv_style_t menuContainer;
+  lv_style_t menuTitle;
+
+  // Overlay mit Display-Messwerten
+  lv_style_t overlay;
+
+  // Objekte mit vorgerenderter Dekoration (siehe ui_decor.h): Hintergrund,
+  // Rahmen und Schatten zeichnet das Bild, nicht mehr das Objekt selbst
+  lv_style_t decorFlat;
+};
+
+static UiStyles uiStyles;
+static bool uiStylesReady = false;
+
+/**
+ * Initialisiert einen Text-Style mit Farbe und optionaler Schrift.
+ */
+static void uiInitTextStyle(lv_style_t* style, uint32_t color, const lv_font_t* font) {
+  lv_style_init(style);
+  lv_style_set_text_color(style, lv_color_hex(color));
+  if (font != NULL) {
+    lv_style_set_text_font(style, font);
+  }
+}
+
+/**
+ * Initialisiert einen Statusfarben-Style (Punkt und Text in derselben Farbe).
+ */
+static void uiInitStatusStyle(lv_style_t* style, uint32_t color) {
+  lv_style_init(style);
+  lv_style_set_bg_color(style, lv_color_hex(color));
+  lv_style_set_text_color(style, lv_color_hex(color));
+}
+
+/**
+ * Baut alle Styles auf. Mehrfache Aufrufe sind wirkungslos.
+ * Muss vor dem Aufbau des ersten Bildschirms aufgerufen werden.
+ */
+void uiStylesInit() {
+  if (uiStylesReady) {
+    return;
+  }
+
+  // Bildschirmhintergründe
+  lv_style_init(&uiStyles.screen);
+  lv_style_set_bg_color(&uiStyles.screen, lv_color_hex(0x003366));
+  lv_style_init(&uiStyles.screenSuccess);
+  lv_style_set_bg_color(&uiStyles.screenSuccess, lv_color_hex(0x006600));
+  lv_style_init(&uiStyles.screenError);
+  lv_style_set_bg_color(&uiStyles.screenError, lv_color_hex(0x990000));
+
+  // Texte
+  uiInitTextStyle(&uiStyles.text, 0xFFFFFF, NULL);
+  uiInitTextStyle(&uiStyles.textMuted, 0xCCCCCC, NULL);
+  uiInitTextStyle(&uiStyles.textAccent, 0x00FFFF, NULL);
+  uiInitTextStyle(&uiStyles.textLarge, 0xFFFFFF, UI_FONT_20);
+  uiInitTextStyle(&uiStyles.textClock, 0xFFFFFF, UI_FONT_18);
+  uiInitTextStyle(&uiStyles.heading, 0xFFFFFF, UI_FONT_22);
+  uiInitTextStyle(&uiStyles.title, 0xFFFFFF, UI_FONT_28);
+  uiInitTextStyle(&uiStyles.subtitle, 0xCCCCCC, UI_FONT_16);
+
+  // Symbole
+  uiInitTextStyle(&uiStyles.iconOk, 0x00FF00, NULL);
+  uiInitTextStyle(&uiStyles.iconSuccess, 0xFFFFFF, UI_FONT_48);
+  uiInitTextStyle(&uiStyles.iconWarning, 0xFFFF00, UI_FONT_48);
+
+  // Button mit Verlauf und Schatten
+  lv_style_init(&uiStyles.btn);
+  lv_style_set_radius(&uiStyles.btn, 10);
+  lv_style_set_bg_color(&uiStyles.btn, lv_color_hex(0x005577));
+  lv_style_set_bg_grad_color(&uiStyles.btn, lv_color_hex(0x007799));
+  lv_style_set_bg_grad_dir(&uiStyles.btn, LV_GRAD_DIR_VER);
+  lv_style_set_shadow_width(&uiStyles.btn, 5);
+  lv_style_set_shadow_color(&uiStyles.btn, lv_color_hex(0x000000));
+  lv_style_set_shadow_opa(&uiStyles.btn, LV_OPA_30);
+
+  // Gedrückter Zustand
+  lv_style_init(&uiStyles.btnPressed);
+  lv_style_set_bg_color(&uiStyles.btnPressed, lv_color_hex(0x004466));
+  lv_style_set_bg_grad_color(&uiStyles.btnPressed, lv_color_hex(0x006688));
+  lv_style_set_shadow_width(&uiStyles.btnPressed, 2);
+
+  // Warn-Button (z.B. Programm stoppen)
+  lv_style_init(&uiStyles.btnDanger);
+  lv_style_set_bg_color(&uiStyles.btnDanger, lv_color_hex(0xFF0000));
+
+  // Fortschrittsbalken: Hintergrund
+  lv_style_init(&uiStyles.barBg);
+  lv_style_set_border_width(&uiStyles.barBg, 2);
+  lv_style_set_border_color(&uiStyles.barBg, lv_color_hex(0x555555));
+  lv_style_set_pad_all(&uiStyles.barBg, 3);
+  lv_style_set_radius(&uiStyles.barBg, 6);
+  lv_style_set_bg_color(&uiStyles.barBg, lv_color_hex(0x333333));
+  lv_style_set_bg_opa(&uiStyles.barBg, LV_OPA_COVER);
+
+  // Fortschrittsbalken: Indikator
+  lv_style_init(&uiStyles.barIndicator);
+  lv_style_set_bg_color(&uiStyles.barIndicator, lv_color_hex(0x00DDDD)); // Türkis
+  lv_style_set_bg_opa(&uiStyles.barIndicator, LV_OPA_COVER);
+  lv_style_set_bg_grad_color(&uiStyles.barIndicator, lv_color_hex(0x00AAAA));
+  lv_style_set_bg_grad_dir(&uiStyles.barIndicator, LV_GRAD_DIR_HOR);
+  lv_style_set_radius(&uiStyles.barIndicator, 3);
+
+  // Fortschrittsbogen und -ring
+  lv_style_init(&uiStyles.arcBg);
+  lv_style_set_arc_width(&uiStyles.arcBg, 12);
+  lv_style_set_arc_color(&uiStyles.arcBg, lv_color_hex(0x333333));
+  lv_style_set_arc_rounded(&uiStyles.arcBg, true);
+
+  lv_style_init(&uiStyles.arcIndicator);
+  lv_style_set_arc_width(&uiStyles.arcIndicator, 12);
+  lv_style_set_arc_color(&uiStyles.arcIndicator, lv_color_hex(0x00DDDD));
+  lv_style_set_arc_rounded(&uiStyles.arcIndicator, true);
+
+  // Trennlinien
+  lv_style_init(&uiStyles.divider);
+  lv_style_set_line_width(&uiStyles.divider, 2);
+  lv_style_set_line_color(&uiStyles.divider, lv_color_hex(0x00DDDD));
+
+  lv_style_init(&uiStyles.menuDivider);
+  lv_style_set_line_width(&uiStyles.menuDivider, 2);
+  lv_style_set_line_color(&uiStyles.menuDivider, lv_color_hex(0x00DDDD));
+  lv_style_set_margin_top(&uiStyles.menuDivider, 5);
+  lv_style_set_margin_bottom(&uiStyles.menuDivider, 8);
+
+  // Statusindikator
+  lv_style_init(&uiStyles.statusDot);
+  lv_style_set_radius(&uiStyles.statusDot, LV_RADIUS_CIRCLE);
+  uiInitStatusStyle(&uiStyles.statusError, 0xFF4444);
+  uiInitStatusStyle(&uiStyles.statusOk, 0x44FF44);
+  uiInitStatusStyle(&uiStyles.statusWarning, 0xFFFF44);
+
+  // Menüeinträge
+  lv_style_init(&uiStyles.menuItem);
+  lv_style_set_width(&uiStyles.menuItem, lv_pct(100));
+  lv_style_set_height(&uiStyles.menuItem, LV_SIZE_CONTENT);
+  lv_style_set_bg_color(&uiStyles.menuItem, lv_color_hex(0x005577));
+  lv_style_set_bg_opa(&uiStyles.menuItem, LV_OPA_70);
+  lv_style_set_border_width(&uiStyles.menuItem, 0);
+  lv_style_set_radius(&uiStyles.menuItem, 10);
+  lv_style_set_pad_all(&uiStyles.menuItem, 10);
+  lv_style_set_text_color(&uiStyles.menuItem, lv_color_hex(0xFFFFFF));
+
+  // Ausgewählte Menüeinträge
+  lv_style_init(&uiStyles.menuItemSelected);
+  lv_style_set_bg_color(&uiStyles.menuItemSelected, lv_color_hex(0x00BBDD));
+  lv_style_set_text_color(&uiStyles.menuItemSelected, lv_color_hex(0xFFFFFF));
+
+  // Menü-Container
+  lv_style_init(&uiStyles.menuContainer);
+  lv_style_set_bg_color(&uiStyles.menuContainer, lv_color_hex(0x003344));
+  lv_style_set_bg_opa(&uiStyles.menuContainer, LV_OPA_80);
+  lv_style_set_border_width(&uiStyles.menuContainer, 2);
+  lv_style_set_border_color(&uiStyles.menuContainer, lv_color_hex(0x006688));
+  lv_style_set_radius(&uiStyles.menuContainer, 15);
+  lv_style_set_shadow_width(&uiStyles.menuContainer, 10);
+  lv_style_set_shadow_opa(&uiStyles.menuContainer, LV_OPA_50);
+  lv_style_set_pad_row(&uiStyles.menuContainer, 8);
+  lv_style_set_pad_all(&uiStyles.menuContainer, 10);
+
+  // Menütitel
+  lv_style_init(&uiStyles.menuTitle);
+  lv_style_set_text_font(&uiStyles.menuTitle, UI_FONT_22);
+  lv_style_set_text_color(&uiStyles.menuTitle, lv_color_hex(0x00DDDD));
+
+  // Overlay mit Display-Messwerten
+  lv_style_init(&uiStyles.overlay);
+  lv_style_set_bg_color(&uiStyles.overlay, lv_color_hex(0x000000));
+  lv_style_set_bg_opa(&uiStyles.overlay, LV_OPA_70);
+  lv_style_set_text_color(&uiStyles.overlay, lv_color_hex(0x00FF00));
+  lv_style_set_pad_all(&uiStyles.overlay, 4);
+
+  // Vorgerenderte Dekoration: Rahmenbreite bleibt erhalten, sonst verschiebt sich der Inhalt
+  lv_style_init(&uiStyles.decorFlat);
+  lv_style_set_bg_opa(&uiStyles.decorFlat, LV_OPA_TRANSP);
+  lv_style_set_border_opa(&uiStyles.decorFlat, LV_OPA_TRANSP);
+  lv_style_set_shadow_width(&uiStyles.decorFlat, 0);
+
+  uiStylesReady = true;
+}
+
+/**
+ * Speicherbedarf der Styles eines Objektbaums.
+ * localBytes: tatsächlich von lokalen Styles belegter LVGL-Heap
+ * sharedAsLocalBytes: Heap, den die Referenzen auf die Registry als lokale Styles belegen würden
+ */
+struct UiStyleReport {
+  uint32_t objects;
+  uint32_t localStyles;
+  uint32_t localBytes;
+  uint32_t sharedRefs;
+  uint32_t sharedAsLocalBytes;
+};
+
+/**
+ * Heap-Bedarf eines Styles, wenn er lokal an einem Objekt hängt.
+ */
+static uint32_t uiStyleHeapBytes(const lv_style_t* style) {
+  uint32_t bytes = sizeof(lv_style_t);
+  if (!style->is_const && style->prop_cnt > 1) {
+    bytes += style->prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+  }
+  return bytes;
+}
+
+/**
+ * Ermittelt rekursiv den Style-Speicherbedarf eines Objektbaums.
+ *
+ * @param obj Wurzelobjekt (z.B. ein Bildschirm)
+ * @param report Ergebnis, wird aufaddiert
+ */
+void uiStyleReport(lv_obj_t* obj, UiStyleReport &report) {
+  if (obj == NULL) {
+    return;
+  }
+
+  report.objects++;
+  for (uint32_t i = 0; i < obj->style_cnt; i++) {
+    const lv_style_t* style = obj->styles[i].style;
+    if (obj->styles[i].is_local) {
+      report.localStyles++;
+      report.localBytes += uiStyleHeapBytes(style);
+    } else if ((const uint8_t*)style >= (const uint8_t*)&uiStyles &&
+               (const uint8_t*)style < (const uint8_t*)(&uiStyles + 1)) {
+      report.sharedRefs++;
+      report.sharedAsLocalBytes += uiStyleHeapBytes(style);
+    }
+  }
+
+  uint32_t childCount = lv_obj_get_child_cnt(obj);
+  for (uint32_t i = 0; i < childCount; i++) {
+    uiStyleReport(lv_obj_get_child(obj, i), report);
+  }
+}
+
+#endif // UI_STYLES_H
@@ -5,14 +5,41 @@
 #include <DNSServer.h>
 #include <ESPmDNS.h>
 #include <Preferences.h>
+#include <atomic>
 #include <vector>
 
+#include "timer_wheel.h"
+
 // WiFi-Konfiguration
 #define WIFI_AP_SSID "SwissAirDry-Setup"
 #define WIFI_AP_PASSWORD "swissairdry"
 #define WIFI_HOSTNAME "desinfektion"
 #define WIFI_CONFIG_PORTAL_TIMEOUT 180  // Timeout in Sekunden
 #define DNS_PORT 53
+#define WIFI_CHECK_INTERVAL 10000       // Prüfintervall der Verbindung in ms
+#define WIFI_AP_FALLBACK_MS 10000       // Ohne Verbindung nach dieser Zeit zusätzlich den Access Point starten
+
+// Zustand des Verbindungsaufbaus im Client-Modus
+enum WiFiConnectState {
+    WIFI_STATE_IDLE,         // Keine Zugangsdaten oder zurückgesetzt
+    WIFI_STATE_ASSOCIATING,  // WiFi.begin() läuft, warten auf den Access Point
+    WIFI_STATE_DHCP,         // Verbunden, warten auf die IP-Adresse
+    WIFI_STATE_CONNECTED     // IP-Adresse erhalten, mDNS gestartet
+};
+
+/**
+ * Dauer der Phasen des letzten erfolgreichen Verbindungsaufbaus in ms.
+ * attempts zählt WiFi.begin()/reconnect(), failures abgebrochene Versuche.
+ */
+struct WiFiConnectTimings {
+    uint32_t associationMs;  // WiFi.begin() bis STA_CONNECTED
+    uint32_t dhcpMs;         // STA_CONNECTED bis GOT_IP
+    uint32_t mdnsMs;         // Dauer von MDNS.begin() (nur bei der ersten Verbindung)
+    uint32_t totalMs;
+    uint32_t attempts;
+    uint32_t failures;
+    uint8_t lastReason;      // Letzter Trennungsgrund (wifi_err_reason_t)
+};
 
 // Struktur zum Speichern von WLAN-Netzwerken
 struct WiFiNetwork {
@@ -30,7 +57,6 @@ private:
     String ssid;
     String password;
     
-    unsigned long lastWiFiCheck = 0;
     bool connected = false;
     bool configMode = false;
     
@@ -56,9 +82,9 @@ private:
         return (ssid.length() > 0);
     }
     
-    // Startet den Access Point Modus
+    // Startet den Access Point Modus (parallel zum Verbindungsaufbau, falls einer läuft)
     void startAccessPoint() {
-        WiFi.mode(WIFI_AP);
+        WiFi.mode(state == WIFI_STATE_IDLE ? WIFI_AP : WIFI_AP_STA);
         Serial.println("Starte Access Point: " + String(WIFI_AP_SSID));
         
         WiFi.softAP(WIFI_AP_SSID, WIFI_AP_PASSWORD);
@@ -76,8 +102,48 @@ private:
         }
     }
     
-    // Verbindet mit gespeichertem WLAN
-    bool connectToStoredWiFi() {
+    // Von den WiFi-Ereignissen gesetzt, vom Netzwerk-Task in loop() verarbeitet
+    enum {
+        EVENT_STA_CONNECTED = 1,
+        EVENT_GOT_IP = 2,
+        EVENT_DISCONNECTED = 4
+    };
+    std::atomic<uint32_t> pendingEvents{0};
+    volatile uint32_t connectedAtUs = 0;
+    volatile uint32_t gotIpAtUs = 0;
+    volatile uint32_t disconnectedAtUs = 0;
+    volatile uint8_t disconnectReason = 0;
+    bool eventsRegistered = false;
+    bool mdnsStarted = false;   // mDNS folgt Wiederverbindungen selbst
+    
+    WiFiConnectState state = WIFI_STATE_IDLE;
+    uint32_t beginUs = 0;       // Start des laufenden Versuchs
+    uint32_t beginMs = 0;       // Start des Verbindungsaufbaus (für den AP-Fallback)
+    WiFiConnectTimings timings = {};
+    
+    // Läuft im Ereignis-Task des WiFi-Stacks: nur Zeitpunkte merken, keine weiteren Aufrufe
+    void onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
+        switch (event) {
+            case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+                connectedAtUs = micros();
+                pendingEvents.fetch_or(EVENT_STA_CONNECTED, std::memory_order_release);
+                break;
+            case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+                gotIpAtUs = micros();
+                pendingEvents.fetch_or(EVENT_GOT_IP, std::memory_order_release);
+                break;
+            case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+                disconnectedAtUs = micros();
+                disconnectReason = info.wifi_sta_disconnected.reason;
+                pendingEvents.fetch_or(EVENT_DISCONNECTED, std::memory_order_release);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    // Startet den Verbindungsaufbau mit dem gespeicherten WLAN, ohne zu warten
+    bool startConnect() {
         if (!loadWiFiCredentials() || ssid.length() == 0) {
             Serial.println("Keine gespeicherten WLAN-Credentials gefunden");
             return false;
@@ -85,114 +151,161 @@ private:
         
         Serial.println("Verbinde mit gespeichertem WLAN: " + ssid);
         
-        WiFi.mode(WIFI_STA);
+        // Ein laufender Access Point bleibt bis zur Verbindung erreichbar
+        WiFi.mode(configMode ? WIFI_AP_STA : WIFI_STA);
+        pendingEvents.store(0, std::memory_order_relaxed);
         WiFi.begin(ssid.c_str(), password.c_str());
         
-        // Bis zu 10 Sekunden auf Verbindung warten
-        int attempts = 0;
-        while (WiFi.status() != WL_CONNECTED && attempts < 20) {
-            delay(500);
-            Serial.print(".");
-            attempts++;
-        }
-        
-        if (WiFi.status() == WL_CONNECTED) {
-            Serial.println("\nVerbunden mit WLAN!");
-            Serial.print("IP Adresse: ");
-            Serial.println(WiFi.localIP());
-            
-            // mDNS starten
+        state = WIFI_STATE_ASSOCIATING;
+        beginUs = micros();
+        beginMs = millis();
+        timings.attempts++;
+        return true;
+    }
+    
+    // IP-Adresse erhalten: mDNS beim ersten Mal starten und die Verbindung melden
+    void onConnected() {
+        // Der mDNS-Dienst bleibt über Trennungen hinweg aktiv und meldet sich auf der
+        // neuen Adresse selbst an; ein zweites MDNS.begin() ohne MDNS.end() legt ihn doppelt an
+        if (!mdnsStarted) {
+            uint32_t mdnsStart = micros();
             if (MDNS.begin(WIFI_HOSTNAME)) {
+                mdnsStarted = true;
                 Serial.println("mDNS gestartet. Hostname: " + String(WIFI_HOSTNAME) + ".local");
             }
-            
-            connected = true;
-            
-            if (connectionCallback) {
-                connectionCallback(true);
-            }
-            
-            return true;
-        } else {
-            Serial.println("\nVerbindung mit WLAN fehlgeschlagen");
-            
-            if (connectionCallback) {
-                connectionCallback(false);
-            }
-            
-            return false;
+            timings.mdnsMs = (micros() - mdnsStart) / 1000;
+        }
+        timings.totalMs = (micros() - beginUs) / 1000;
+        
+        Serial.printf("Verbunden mit WLAN, IP %s (Verbindung %u ms, DHCP %u ms, mDNS %u ms)\n",
+                      WiFi.localIP().toString().c_str(), (unsigned)timings.associationMs,
+                      (unsigned)timings.dhcpMs, (unsigned)timings.mdnsMs);
+        
+        state = WIFI_STATE_CONNECTED;
+        connected = true;
+        
+        // Der Fallback-Access-Point wird nicht mehr gebraucht
+        if (configMode) {
+            stopAccessPoint();
+            WiFi.mode(WIFI_STA);
+        }
+        
+        if (connectionCallback) {
+            connectionCallback(true);
         }
     }
-
+    
+    // Beendet den Access Point
+    void stopAccessPoint() {
+        WiFi.softAPdisconnect(true);
+        dnsServer.stop();
+        configMode = false;
+    }
+    
 public:
     WiFiManager() : connected(false), configMode(false) {
         // Konstruktor
     }
     
-    // Initialisiert den WiFi Manager
+    // Initialisiert den WiFi Manager und startet den Verbindungsaufbau, ohne zu warten
     void begin() {
         // ESP Hostname setzen
         WiFi.setHostname(WIFI_HOSTNAME);
         
-        // Verbindung mit gespeichertem WLAN versuchen
-        if (!connectToStoredWiFi()) {
-            // Wenn keine Verbindung möglich, Access Point starten
+        if (!eventsRegistered) {
+            WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+                onWiFiEvent(event, info);
+            });
+            eventsRegistered = true;
+        }
+        
+        // Verbindung mit gespeichertem WLAN versuchen, ohne Zugangsdaten sofort den Access Point
+        if (!startConnect()) {
             startAccessPoint();
         }
     }
     
-    // Hauptschleife
+    // Registriert die Verbindungsprüfung (alle WIFI_CHECK_INTERVAL ms) im Timer-Rad des Netzwerk-Tasks
+    void attachTimers(TimerWheel &timers) {
+        timers.every("wifi_check", WIFI_CHECK_INTERVAL, [](void* arg) {
+            ((WiFiManager*)arg)->checkConnection();
+        }, this);
+    }
+    
+    // Hauptschleife: WiFi-Ereignisse verarbeiten und den DNS-Server des Captive Portals bedienen
     void loop() {
+        uint32_t events = pendingEvents.exchange(0, std::memory_order_acquire);
+        
+        // Die Maske kennt keine Reihenfolge: zuerst die Trennung, Verbindung und IP nur,
+        // wenn sie danach kamen (sonst gehörten sie zum abgebrochenen Versuch)
+        bool dropped = events & EVENT_DISCONNECTED;
+        bool associated = (events & EVENT_STA_CONNECTED) && (!dropped || (int32_t)(connectedAtUs - disconnectedAtUs) > 0);
+        bool gotIp = (events & EVENT_GOT_IP) && (!dropped || (int32_t)(gotIpAtUs - disconnectedAtUs) > 0);
+        
+        if (dropped && state != WIFI_STATE_IDLE) {
+            timings.lastReason = disconnectReason;
+            if (state == WIFI_STATE_CONNECTED) {
+                Serial.printf("WLAN-Verbindung verloren (Grund %u)\n", disconnectReason);
+                connected = false;
+                beginUs = disconnectedAtUs;
+                beginMs = millis();
+                if (connectionCallback) {
+                    connectionCallback(false);
+                }
+            } else {
+                timings.failures++;
+            }
+            // Der WiFi-Stack verbindet sich selbst neu, checkConnection() stößt nach
+            state = WIFI_STATE_ASSOCIATING;
+        }
+        if (associated && state == WIFI_STATE_ASSOCIATING) {
+            timings.associationMs = (connectedAtUs - beginUs) / 1000;
+            state = WIFI_STATE_DHCP;
+        }
+        if (gotIp && state != WIFI_STATE_IDLE && state != WIFI_STATE_CONNECTED) {
+            // Nach einer Wiederverbindung ohne STA_CONNECTED in diesem Durchlauf zählt DHCP ab dem Versuch
+            timings.dhcpMs = (gotIpAtUs - (state == WIFI_STATE_DHCP ? connectedAtUs : beginUs)) / 1000;
+            onConnected();
+        }
+        
+        // Abgleich mit dem WiFi-Stack, falls ein Ereignis trotzdem verloren ging
+        if (state != WIFI_STATE_CONNECTED && state != WIFI_STATE_IDLE && WiFi.status() == WL_CONNECTED) {
+            onConnected();
+        }
+        
+        // Zu lange ohne Verbindung: Access Point parallel starten, der Client-Modus versucht es weiter
+        if (!configMode && (state == WIFI_STATE_ASSOCIATING || state == WIFI_STATE_DHCP) &&
+            millis() - beginMs >= WIFI_AP_FALLBACK_MS) {
+            Serial.println("Keine WLAN-Verbindung, starte Access Point parallel");
+            startAccessPoint();
+        }
+        
         // Wenn im Access Point Modus, DNS-Server bedienen
         if (configMode) {
             dnsServer.processNextRequest();
-        } 
-        // Wenn im Client-Modus, WLAN-Verbindung überwachen
-        else {
-            unsigned long currentMillis = millis();
-            
-            // Alle 10 Sekunden WLAN-Status prüfen
-            if (currentMillis - lastWiFiCheck >= 10000) {
-                lastWiFiCheck = currentMillis;
-                
-                if (WiFi.status() != WL_CONNECTED) {
-                    if (connected) {
-                        Serial.println("WLAN-Verbindung verloren. Versuche Wiederverbindung...");
-                        connected = false;
-                        
-                        if (connectionCallback) {
-                            connectionCallback(false);
-                        }
-                    }
-                    
-                    // Versuche Wiederverbindung
-                    WiFi.reconnect();
-                } 
-                else if (!connected) {
-                    Serial.println("WLAN-Verbindung wiederhergestellt!");
-                    connected = true;
-                    
-                    if (connectionCallback) {
-                        connectionCallback(true);
-                    }
-                }
-            }
         }
     }
     
-    // Verbindet mit einem neuen WLAN-Netzwerk
+    // Verbindungsaufbau nachstoßen, falls der WiFi-Stack aufgegeben hat (Ereignisse verarbeitet loop())
+    void checkConnection() {
+        if (state == WIFI_STATE_IDLE || state == WIFI_STATE_CONNECTED) {
+            return;
+        }
+        
+        // Einem laufenden Versuch die volle Prüfzeit lassen
+        if (WiFi.status() != WL_CONNECTED && micros() - beginUs >= WIFI_CHECK_INTERVAL * 1000UL) {
+            WiFi.reconnect();
+            beginUs = micros();
+            timings.attempts++;
+        }
+    }
+    
+    // Verbindet mit einem neuen WLAN-Netzwerk (ohne zu warten, der Access Point bleibt bis zur Verbindung)
     bool connect(const String &ssid, const String &password) {
         // WLAN-Credentials speichern
         saveWiFiCredentials(ssid, password);
         
-        // Access Point beenden, falls aktiv
-        if (configMode) {
-            WiFi.softAPdisconnect(true);
-            dnsServer.stop();
-            configMode = false;
-        }
-        
-        return connectToStoredWiFi();
+        return startConnect();
     }
     
     // Setzt die WLAN-Konfiguration zurück
@@ -203,7 +316,15 @@ public:
         
         Serial.println("WLAN-Konfiguration zurückgesetzt");
         
-        // Access Point starten
+        // Client-Modus beenden und Access Point starten
+        WiFi.disconnect();
+        if (connected) {
+            connected = false;
+            if (connectionCallback) {
+                connectionCallback(false);
+            }
+        }
+        state = WIFI_STATE_IDLE;
         startAccessPoint();
     }
     
@@ -270,6 +391,26 @@ public:
         return connected;
     }
     
+    // Liefert den Zustand des Verbindungsaufbaus
+    WiFiConnectState getState() {
+        return state;
+    }
+    
+    // Liefert die Phasendauern des letzten Verbindungsaufbaus
+    const WiFiConnectTimings &getTimings() {
+        return timings;
+    }
+    
+    static const char* stateName(WiFiConnectState state) {
+        switch (state) {
+            case WIFI_STATE_IDLE:        return "idle";
+            case WIFI_STATE_ASSOCIATING: return "associating";
+            case WIFI_STATE_DHCP:        return "dhcp";
+            case WIFI_STATE_CONNECTED:   return "connected";
+        }
+        return "unknown";
+    }
+    
     // Prüft, ob der Konfigurationsmodus aktiv ist
     bool isInConfigMode() {
         return configMode;
@@ -0,0 +1,251 @@
+"""
+Erzeugt Teilschriften für die Bedienoberfläche (PlatformIO extra_script, pre).
+
+Sammelt die Zeichen der UI-Texte sowie die verwendeten LV_SYMBOL_*-Symbole
+und erzeugt mit lv_font_conv für jede genutzte Schriftgröße eine
+Montserrat-Schrift, die genau diese Glyphen enthält (inkl. Umlaute).
+
+Als UI-Text zählen nur String-Literale in Aufrufen, die Text auf das Display
+bringen (lv_label_set_text, uiBindLabelFmt, setStatusText, UI_EVENT_STATUS_TEXT,
+...), auch über mehrere Zeilen. Texte, die vorher zusammengesetzt oder in
+Tabellen abgelegt werden, markiert ein Kommentar "// UI-Text" in derselben
+Zeile. Log-Ausgaben, JSON-Schlüssel und MQTT-Themen bleiben außen vor. Die Schriften werden nach .pio/ui_fonts
+geschrieben, mitgebaut und über UI_FONT_SUBSET=1 in lv_conf.h und
+src/ui_fonts.h aktiviert. Anschließend wird der Flash-Bedarf je Schrift im
+Vergleich zur Standardschrift von LVGL ausgegeben.
+
+Optionen in platformio.ini (alle optional):
+    custom_font_subset   = yes | no              (Standard: yes)
+    custom_font_compress = yes | no              (Standard: no)
+    custom_font_sources  = src/*.h src/*.cpp     (zu durchsuchende Dateien, Muster erlaubt)
+    custom_font_extra    = Zeichen, die zur Laufzeit entstehen (Ziffern, Geräte-ID, ...)
+    custom_font_conv     = Aufruf von lv_font_conv (Standard: npx --yes lv_font_conv@1.5.2)
+
+Damit jeder Build dieselbe Firmware erzeugt, gibt es keinen stillen Rückfall:
+Fehlt LVGL noch (erster Build), installiert das Skript die Bibliotheken der
+Umgebung vorab; schlägt das oder lv_font_conv fehl, bricht der Build ab.
+Die Standardschriften von LVGL gibt es nur mit custom_font_subset = no.
+"""
+
+import glob
+import hashlib
+import os
+import re
+import shlex
+import subprocess
+
+Import("env")  # noqa: F821
+
+# Muss zu src/ui_fonts.h passen
+FONT_SIZES = [14, 16, 18, 20, 22, 28, 48]
+FONT_BPP = 4
+
+# Alle Quellen der Firmware: UI-Texte entstehen auch in main.cpp (Statustexte) und
+# in Diagnose-Modulen; eine Handliste veraltet mit jedem neuen Modul
+DEFAULT_SOURCES = "src/*.h src/*.cpp"
+# Zur Laufzeit formatierte Texte: Zahlen, Zeiten, Prozent, Geräte-ID (Hex)
+DEFAULT_EXTRA = " 0123456789abcdefABCDEF%:.,-+/()_"
+DEFAULT_CONV = "npx --yes lv_font_conv@1.5.2"
+
+STRING_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+# Aufrufe, deren String-Argumente auf dem Display erscheinen
+UI_TEXT_CALL_RE = re.compile(
+    r"\b(?:lv_label_set_text(?:_fmt|_static)?|lv_\w+_set_(?:text|options|placeholder_text)"
+    r"|lv_\w+_add_(?:tab|option)|lv_msgbox_create|uiBindLabelText|uiBindLabelFmt"
+    r"|setStatusText)\s*\(|\bUI_EVENT_STATUS_TEXT\b")
+UI_TEXT_MARK = "// UI-Text"
+SYMBOL_RE = re.compile(r"\bLV_SYMBOL_(\w+)")
+SYMBOL_DEF_RE = re.compile(r"#define\s+LV_SYMBOL_(\w+)\s+\"[^\"]*\"\s*/\*\s*\d+,\s*(0x[0-9A-Fa-f]+)\s*\*/")
+ESCAPE_RE = re.compile(r"\\(x[0-9A-Fa-f]{1,2}|[0-7]{1,3}|.)")
+
+SIMPLE_ESCAPES = {"n": b"\n", "t": b"\t", "r": b"\r", "\\": b"\\", '"': b'"', "'": b"'", "0": b"\0"}
+
+
+def option(name, default):
+    return env.GetProjectOption(name, default)  # noqa: F821
+
+
+def log(message):
+    print("Schriften: " + message)
+
+
+def decode_literal(literal):
+    """Wandelt ein C-String-Literal (UTF-8 mit Escape-Sequenzen) in Text um."""
+    out = bytearray()
+    pos = 0
+    for match in ESCAPE_RE.finditer(literal):
+        out += literal[pos:match.start()].encode("utf-8")
+        esc = match.group(1)
+        if esc[0] == "x":
+            out.append(int(esc[1:], 16))
+        elif esc[0] in "01234567" and esc not in SIMPLE_ESCAPES:
+            out.append(int(esc, 8) & 0xFF)
+        else:
+            out += SIMPLE_ESCAPES.get(esc, esc.encode("utf-8"))
+        pos = match.end()
+    out += literal[pos:].encode("utf-8")
+    return out.decode("utf-8", errors="ignore")
+
+
+def paren_depth(code):
+    """Klammertiefe einer Zeile ohne die Inhalte von String-Literalen."""
+    code = STRING_RE.sub('""', code)
+    return code.count("(") - code.count(")")
+
+
+def collect_glyphs(project_dir, sources):
+    """Liefert die Zeichen der UI-Texte und die Namen der verwendeten Symbole."""
+    chars = set()
+    symbols = set()
+    paths = []
+    for source in sources:
+        matches = sorted(glob.glob(os.path.join(project_dir, source)))
+        if not matches:
+            log("Quelle %s nicht gefunden, wird übersprungen" % source)
+        paths += [path for path in matches if os.path.isfile(path)]
+    for path in paths:
+        with open(path, encoding="utf-8") as f:
+            depth = 0  # > 0: Fortsetzung eines mehrzeiligen UI-Text-Aufrufs
+            for line in f:
+                stripped = line.strip()
+                if stripped.startswith("#include") or stripped.startswith("//"):
+                    continue
+                symbols.update(SYMBOL_RE.findall(line))
+                if depth <= 0:
+                    match = UI_TEXT_CALL_RE.search(line)
+                    if match:
+                        # Nur ab dem Aufruf, nicht davor stehende Literale
+                        depth = paren_depth(line[match.start():])
+                        for literal in STRING_RE.findall(line[match.start():]):
+                            chars.update(decode_literal(literal))
+                    elif UI_TEXT_MARK in line:
+                        for literal in STRING_RE.findall(line.split(UI_TEXT_MARK)[0]):
+                            chars.update(decode_literal(literal))
+                else:
+                    depth += paren_depth(line)
+                    for literal in STRING_RE.findall(line):
+                        chars.update(decode_literal(literal))
+    # Symbole liegen im Private-Use-Bereich und kommen aus FontAwesome
+    text = "".join(sorted(c for c in chars if c.isprintable() and not 0xE000 <= ord(c) <= 0xF8FF))
+    return text, symbols
+
+
+def symbol_codepoints(lvgl_dir, names):
+    path = os.path.join(lvgl_dir, "src", "font", "lv_symbol_def.h")
+    with open(path, encoding="utf-8") as f:
+        defs = dict(SYMBOL_DEF_RE.findall(f.read()))
+    codepoints = []
+    for name in sorted(names):
+        if name in defs:
+            codepoints.append(defs[name])
+        else:
+            log("LV_SYMBOL_%s ist in LVGL nicht definiert" % name)
+    return codepoints
+
+
+def font_bytes(path):
+    """Schätzt den Flash-Bedarf einer LVGL-Schrift (Bitmaps + Glyphenbeschreibungen)."""
+    with open(path, encoding="utf-8") as f:
+        content = f.read()
+    bitmap = re.search(r"glyph_bitmap\[\]\s*=\s*\{(.*?)\};", content, re.S)
+    glyphs = re.search(r"glyph_dsc\[\]\s*=\s*\{(.*?)\};", content, re.S)
+    size = len(re.findall(r"0x[0-9a-fA-F]+", bitmap.group(1))) if bitmap else 0
+    count = glyphs.group(1).count(".bitmap_index") if glyphs else 0
+    return size + count * 8, count  # lv_font_fmt_txt_glyph_dsc_t: 8 Bytes
+
+
+def fail(message):
+    log(message)
+    log("ohne Teilschriften bauen: custom_font_subset = no")
+    env.Exit(1)  # noqa: F821
+
+
+def find_lvgl(env):
+    libdeps = os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"))
+    if os.path.isdir(libdeps):
+        for entry in os.listdir(libdeps):
+            path = os.path.join(libdeps, entry)
+            if entry.lower().startswith("lvgl") and os.path.isfile(os.path.join(path, "lvgl.h")):
+                return path
+    return None
+
+
+def generate(env):
+    if option("custom_font_subset", "yes").lower() not in ("yes", "true", "1"):
+        return
+
+    project_dir = env.subst("$PROJECT_DIR")
+    compress = option("custom_font_compress", "no").lower() in ("yes", "true", "1")
+    sources = option("custom_font_sources", DEFAULT_SOURCES).split()
+    extra = option("custom_font_extra", DEFAULT_EXTRA)
+    conv = shlex.split(option("custom_font_conv", DEFAULT_CONV))
+
+    lvgl_dir = find_lvgl(env)
+    if lvgl_dir is None:
+        # Erster Build: PlatformIO installiert die Bibliotheken erst nach den pre-Skripten
+        log("LVGL noch nicht installiert, installiere die Bibliotheken von %s" % env.subst("$PIOENV"))
+        try:
+            subprocess.run([env.subst("$PYTHONEXE"), "-m", "platformio", "pkg", "install",
+                            "-d", project_dir, "-e", env.subst("$PIOENV")],
+                           check=True, stdout=subprocess.DEVNULL)
+        except (OSError, subprocess.CalledProcessError) as e:
+            fail("Installation fehlgeschlagen (%s)" % e)
+        lvgl_dir = find_lvgl(env)
+        if lvgl_dir is None:
+            fail("LVGL nicht gefunden")
+    font_dir = os.path.join(lvgl_dir, "scripts", "built_in_font")
+    text_font = os.path.join(font_dir, "Montserrat-Medium.ttf")
+    symbol_font = os.path.join(font_dir, "FontAwesome5-Solid+Brands+Regular.woff")
+
+    text, symbols = collect_glyphs(project_dir, sources)
+    text = "".join(sorted(set(text + extra)))
+    codepoints = symbol_codepoints(lvgl_dir, symbols)
+
+    out_dir = os.path.join(env.subst("$PROJECT_WORKSPACE_DIR"), "ui_fonts")
+    os.makedirs(out_dir, exist_ok=True)
+    outputs = [os.path.join(out_dir, "ui_font_%d.c" % size) for size in FONT_SIZES]
+
+    # Nur neu erzeugen, wenn sich Zeichen oder Einstellungen geändert haben
+    stamp = hashlib.sha1(repr((text, codepoints, compress, FONT_BPP, FONT_SIZES, conv)).encode("utf-8")).hexdigest()
+    stamp_path = os.path.join(out_dir, "stamp")
+    current = open(stamp_path).read() if os.path.isfile(stamp_path) else ""
+
+    if current != stamp or not all(os.path.isfile(p) for p in outputs):
+        log("erzeuge %d Teilschriften (%d Zeichen, %d Symbole)" % (len(FONT_SIZES), len(text), len(codepoints)))
+        for size, out in zip(FONT_SIZES, outputs):
+            cmd = conv + [
+                "--bpp", str(FONT_BPP), "--size", str(size), "--format", "lvgl",
+                "--lv-include", "lvgl.h", "--lv-font-name", "ui_font_%d" % size,
+                "--font", text_font, "--symbols", text,
+            ]
+            if codepoints:
+                cmd += ["--font", symbol_font, "--range", ",".join(codepoints)]
+            if not compress:
+                cmd.append("--no-compress")
+            cmd += ["-o", out]
+            try:
+                subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+            except (OSError, subprocess.CalledProcessError) as e:
+                for p in outputs:
+                    if os.path.isfile(p):
+                        os.remove(p)
+                fail("lv_font_conv fehlgeschlagen (%s)" % e)
+        with open(stamp_path, "w") as f:
+            f.write(stamp)
+
+    # Flash-Bedarf im Vergleich zu den Montserrat-Schriften von LVGL
+    total_saved = 0
+    for size, out in zip(FONT_SIZES, outputs):
+        subset_size, subset_glyphs = font_bytes(out)
+        stock = os.path.join(lvgl_dir, "src", "font", "lv_font_montserrat_%d.c" % size)
+        stock_size, stock_glyphs = font_bytes(stock) if os.path.isfile(stock) else (0, 0)
+        total_saved += stock_size - subset_size
+        log("%2d px: %3d Glyphen, %6d Bytes (Standard: %3d Glyphen, %6d Bytes, %+d Bytes)"
+            % (size, subset_glyphs, subset_size, stock_glyphs, stock_size, subset_size - stock_size))
+    log("insgesamt %d Bytes Flash eingespart%s" % (total_saved, " (komprimiert)" if compress else ""))
+
+    env.Append(CPPDEFINES=[("UI_FONT_SUBSET", 1), ("UI_FONT_COMPRESSED", 1 if compress else 0)])
+    env.BuildSources(os.path.join("$BUILD_DIR", "ui_fonts"), out_dir)
+
+
+generate(env)  # noqa: F821
@@ -0,0 +1,265 @@
+"""
+Wandelt Bilder in LVGL-Bildformate im Flash um (PlatformIO extra_script, pre).
+
+Jedes in custom_image_assets eingetragene Bild (PNG, JPEG, AVIF, ...) wird
+auf die angegebene Größe skaliert und in eines der folgenden Formate
+gebracht:
+
+    rle       RGB565 (+ Alpha), lauflängenkodiert (LV_IMG_CF_USER_ENCODED_0/1)
+    indexed4  16 Farben Palette (LV_IMG_CF_INDEXED_4BIT), ggf. verlustbehaftet
+    indexed8  256 Farben Palette (LV_IMG_CF_INDEXED_8BIT), ggf. verlustbehaftet
+    auto      das kleinste verlustfreie der drei Formate (Palette nur, wenn sie
+              jedes Pixel exakt wiedergibt)
+
+Beide Formate packt zur Laufzeit der Decoder aus src/ui_images.h einmal in
+RGB565 aus; der LVGL-Bildcache (LV_IMG_CACHE_DEF_SIZE) hält das Ergebnis.
+Die Bilder werden nach .pio/ui_images geschrieben, mitgebaut und über
+UI_IMAGE_ASSETS=1 aktiviert. Anschließend wird der Flash-Bedarf je Bild im
+Vergleich zu unkomprimiertem RGB565 ausgegeben.
+
+Optionen in platformio.ini (alle optional):
+    custom_image_assets = Zeilen "name = pfad, BxH, format" (Pfad relativ zum Projekt)
+
+Benötigt Pillow (9.1+), für AVIF zusätzlich libavif in Pillow oder das
+Paket pillow-avif-plugin. Fehlt beides, wird mit einer Warnung ohne Bilder
+gebaut.
+"""
+
+import hashlib
+import os
+import re
+
+Import("env")  # noqa: F821
+
+DEFAULT_ASSETS = "logo = ../generated-icon.png, 64x64, auto"
+
+# Muss zu src/ui_images.h passen
+CF_INDEXED_4BIT = "LV_IMG_CF_INDEXED_4BIT"
+CF_INDEXED_8BIT = "LV_IMG_CF_INDEXED_8BIT"
+CF_RLE = "LV_IMG_CF_USER_ENCODED_0"
+CF_RLE_ALPHA = "LV_IMG_CF_USER_ENCODED_1"
+RLE_MAX_RUN = 127
+
+ASSET_RE = re.compile(r"^\s*(\w+)\s*=\s*([^,]+?)\s*,\s*(\d+)x(\d+)\s*(?:,\s*(\w+))?\s*$")
+FORMATS = ("auto", "rle", "indexed4", "indexed8")
+
+# Erhöhen, wenn sich die Ausgabe ändert (erzwingt Neuerzeugung)
+GENERATOR_VERSION = 1
+
+
+def option(name, default):
+    return env.GetProjectOption(name, default)  # noqa: F821
+
+
+def log(message):
+    print("Bilder: " + message)
+
+
+def parse_assets(text):
+    assets = []
+    for line in text.splitlines():
+        if not line.strip():
+            continue
+        match = ASSET_RE.match(line)
+        if not match:
+            log("Eintrag '%s' nicht lesbar (erwartet: name = pfad, BxH, format)" % line.strip())
+            continue
+        name, path, w, h, fmt = match.groups()
+        fmt = (fmt or "auto").lower()
+        if fmt not in FORMATS:
+            log("%s: unbekanntes Format '%s', verwende auto" % (name, fmt))
+            fmt = "auto"
+        assets.append((name, path, int(w), int(h), fmt))
+    return assets
+
+
+def rgb565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def encode_rle(pixels, alpha):
+    """
+    Lauflängenkodierung über ganze Pixel (2 Bytes RGB565 little endian, mit
+    Alpha 3 Bytes). Steuerbyte < 0x80: Pixel n-mal wiederholen, sonst folgen
+    (Steuerbyte & 0x7F) einzelne Pixel.
+    """
+    units = []
+    for r, g, b, a in pixels:
+        v = rgb565(r, g, b)
+        units.append(bytes((v & 0xFF, v >> 8, a)) if alpha else bytes((v & 0xFF, v >> 8)))
+
+    out = bytearray()
+    i = 0
+    n = len(units)
+    while i < n:
+        run = 1
+        while i + run < n and run < RLE_MAX_RUN and units[i + run] == units[i]:
+            run += 1
+        if run >= 2:
+            out.append(run)
+            out += units[i]
+            i += run
+            continue
+        # Einzelpixel bis zur nächsten Wiederholung sammeln
+        start = i
+        while i < n and i - start < RLE_MAX_RUN and (i + 1 >= n or units[i + 1] != units[i]):
+            i += 1
+        out.append(0x80 | (i - start))
+        for unit in units[start:i]:
+            out += unit
+    return bytes(out)
+
+
+def encode_indexed(image, bpp):
+    """LVGL-Layout: Palette (lv_color32_t, B G R A), danach Zeilen mit Indizes (MSB zuerst).
+
+    Liefert (Daten, verlustfrei). Verlustfrei nur, wenn die über die Palette
+    zurückgelesenen Pixel exakt dem Quellbild entsprechen; FASTOCTREE kann auch
+    bei wenigen Farben ähnliche Farben zusammenlegen.
+    """
+    from PIL import Image
+
+    colors = 1 << bpp
+    quantized = image.quantize(colors=colors, method=Image.FASTOCTREE)
+    palette = quantized.getpalette("RGBA") or []
+    palette += [0] * (colors * 4 - len(palette))
+
+    out = bytearray()
+    for i in range(colors):
+        r, g, b, a = palette[i * 4:i * 4 + 4]
+        out += bytes((b, g, r, a))
+
+    w, h = quantized.size
+    indices = list(quantized.getdata())
+    decoded = [tuple(palette[i * 4:i * 4 + 4]) for i in indices]
+    lossless = decoded == [tuple(p) for p in image.getdata()]
+    per_byte = 8 // bpp
+    for y in range(h):
+        row = indices[y * w:(y + 1) * w]
+        for x in range(0, w, per_byte):
+            byte = 0
+            for k in range(per_byte):
+                byte <<= bpp
+                if x + k < w:
+                    byte |= row[x + k] & (colors - 1)
+            out.append(byte)
+    return bytes(out), lossless
+
+
+def convert(project_dir, name, path, w, h, fmt):
+    """Liefert (Farbformat, Daten, verlustfrei) oder None."""
+    from PIL import Image
+
+    try:
+        source = Image.open(os.path.join(project_dir, path))
+        source.load()
+    except (OSError, ValueError) as e:
+        log("%s: %s nicht lesbar (%s)" % (name, path, e))
+        return None
+
+    resample = getattr(Image, "Resampling", Image).LANCZOS
+    image = source.convert("RGBA").resize((w, h), resample)
+    pixels = list(image.getdata())
+    alpha = any(p[3] < 255 for p in pixels)
+    distinct = len(set(pixels))
+
+    candidates = []
+    if fmt in ("auto", "rle"):
+        candidates.append((CF_RLE_ALPHA if alpha else CF_RLE, encode_rle(pixels, alpha), True))
+    # auto nimmt eine Palette nur, wenn sie jedes Pixel exakt wiedergibt
+    for bpp, cf, forced in ((4, CF_INDEXED_4BIT, "indexed4"), (8, CF_INDEXED_8BIT, "indexed8")):
+        if fmt == forced or (fmt == "auto" and distinct <= 1 << bpp):
+            data, lossless = encode_indexed(image, bpp)
+            if fmt == forced or lossless:
+                candidates.append((cf, data, lossless))
+    return min(candidates, key=lambda c: len(c[1]))
+
+
+def write_sources(out_dir, results):
+    with open(os.path.join(out_dir, "ui_images.c"), "w") as f:
+        f.write("/* Erzeugt von tools/image_assets.py, nicht bearbeiten */\n\n#include <lvgl.h>\n")
+        for name, w, h, cf, data in results:
+            f.write("\nstatic const LV_ATTRIBUTE_LARGE_CONST uint8_t ui_img_%s_map[] = {\n" % name)
+            for i in range(0, len(data), 16):
+                f.write("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",\n")
+            f.write("};\n\n")
+            f.write("const lv_img_dsc_t ui_img_%s = {\n" % name)
+            f.write("  .header.cf = %s,\n  .header.always_zero = 0,\n  .header.reserved = 0,\n" % cf)
+            f.write("  .header.w = %d,\n  .header.h = %d,\n" % (w, h))
+            f.write("  .data_size = %d,\n  .data = ui_img_%s_map,\n};\n" % (len(data), name))
+
+    with open(os.path.join(out_dir, "ui_image_assets.h"), "w") as f:
+        f.write("/* Erzeugt von tools/image_assets.py, nicht bearbeiten */\n\n")
+        f.write("#ifndef UI_IMAGE_ASSETS_H\n#define UI_IMAGE_ASSETS_H\n\n#include <lvgl.h>\n\n")
+        for name, _, _, _, _ in results:
+            f.write("LV_IMG_DECLARE(ui_img_%s)\n#define UI_IMG_%s (&ui_img_%s)\n" % (name, name.upper(), name))
+        f.write("\n#define UI_IMAGE_ASSET_LIST \\\n")
+        f.write("".join("  {\"%s\", &ui_img_%s}, \\\n" % (name, name) for name, _, _, _, _ in results))
+        f.write("\n#endif // UI_IMAGE_ASSETS_H\n")
+
+
+def generate(env):
+    assets = parse_assets(option("custom_image_assets", DEFAULT_ASSETS))
+    if not assets:
+        return
+
+    try:
+        import PIL  # noqa: F401
+    except ImportError:
+        log("Pillow nicht installiert (pip install pillow), baue ohne Bilder")
+        return
+    try:
+        import pillow_avif  # noqa: F401
+    except ImportError:
+        pass
+
+    project_dir = env.subst("$PROJECT_DIR")
+    out_dir = os.path.join(env.subst("$PROJECT_WORKSPACE_DIR"), "ui_images")
+    os.makedirs(out_dir, exist_ok=True)
+    outputs = [os.path.join(out_dir, "ui_images.c"), os.path.join(out_dir, "ui_image_assets.h")]
+
+    # Nur neu erzeugen, wenn sich Quellen oder Einstellungen geändert haben
+    inputs = []
+    for name, path, w, h, fmt in assets:
+        full = os.path.join(project_dir, path)
+        st = os.stat(full) if os.path.isfile(full) else None
+        inputs.append((name, path, w, h, fmt, st.st_size if st else 0, int(st.st_mtime) if st else 0))
+    stamp = hashlib.sha1(repr((inputs, GENERATOR_VERSION)).encode("utf-8")).hexdigest()
+    stamp_path = os.path.join(out_dir, "stamp")
+    current = open(stamp_path).read() if os.path.isfile(stamp_path) else ""
+    report_path = os.path.join(out_dir, "report")
+
+    if current != stamp or not all(os.path.isfile(p) for p in outputs):
+        log("wandle %d Bilder um" % len(assets))
+        results = []
+        report = []
+        for name, path, w, h, fmt in assets:
+            converted = convert(project_dir, name, path, w, h, fmt)
+            if converted is None:
+                continue
+            cf, data, lossless = converted
+            results.append((name, w, h, cf, data))
+            raw = w * h * (3 if cf == CF_RLE_ALPHA else 2)
+            report.append("%s: %dx%d, %s%s, %d Bytes (RGB565: %d Bytes, %+d%%)" % (
+                name, w, h, cf.replace("LV_IMG_CF_", ""), "" if lossless else " verlustbehaftet",
+                len(data), raw, (len(data) - raw) * 100 // raw))
+        if not results:
+            for p in outputs:
+                if os.path.isfile(p):
+                    os.remove(p)
+            return
+        write_sources(out_dir, results)
+        with open(report_path, "w") as f:
+            f.write("\n".join(report))
+        with open(stamp_path, "w") as f:
+            f.write(stamp)
+
+    if os.path.isfile(report_path):
+        for line in open(report_path).read().splitlines():
+            log(line)
+
+    env.Append(CPPDEFINES=[("UI_IMAGE_ASSETS", 1)], CPPPATH=[out_dir])
+    env.BuildSources(os.path.join("$BUILD_DIR", "ui_images"), out_dir)
+
+
+generate(env)  # noqa: F821
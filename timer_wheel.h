@@ -0,0 +1,399 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <Arduino.h>
+
+// Maximale Anzahl gleichzeitig registrierter Aufträge je Rad
+#ifndef TIMER_WHEEL_JOBS
+#define TIMER_WHEEL_JOBS 16
+#endif
+
+// Rückgabe von poll(), wenn kein Auftrag ansteht
+#define TIMER_WHEEL_NO_DEADLINE 0xFFFFFFFFUL
+
+typedef void (*TimerJobFn)(void* arg);
+
+/**
+ * Messwerte eines Auftrags.
+ * jitter: Verspätung der Ausführung gegenüber dem geplanten Zeitpunkt in ms
+ * overruns: periodische Ausführungen, die ausfallen mussten, weil der Auftrag
+ * (oder sein Task) länger als eine Periode hinterherhing
+ */
+struct TimerJobStats {
+  const char* name;
+  uint32_t periodMs;      // 0 bei einmaligen Aufträgen
+  uint32_t runs;
+  uint32_t lastJitterMs;
+  uint32_t maxJitterMs;
+  uint32_t jitterSumMs;   // Für den Mittelwert (jitterSumMs / runs)
+  uint32_t overruns;
+  uint32_t maxRunUs;
+};
+
+/**
+ * Hierarchisches Timer-Rad für periodische und einmalige Aufträge.
+ * Auflösung 1 ms (millis()). Ebene 0 hat 256 Fächer zu je 1 ms, jede weitere
+ * Ebene 64 Fächer, die eine ganze Runde der Ebene darunter umfassen
+ * (256 ms, 16 s, 17 min, darüber hinaus wird in der obersten Ebene neu
+ * einsortiert). Ein Auftrag liegt immer nur in einem Fach und wird beim
+ * Überlauf einer Ebene eine Ebene tiefer einsortiert. poll() prüft je
+ * vergangener Millisekunde nur ein Fach statt aller Aufträge und liefert die
+ * Zeit bis zur nächsten Fälligkeit, so dass der Task bis dahin schlafen kann.
+ *
+ * Nicht threadsicher: jedes Rad gehört einem Task, Aufträge werden nur aus
+ * diesem Task (auch aus laufenden Aufträgen heraus) angelegt und abgebrochen.
+ */
+class TimerWheel {
+private:
+  static const uint8_t LEVELS = 4;
+  static const uint8_t ROOT_BITS = 8;
+  static const uint8_t LEVEL_BITS = 6;
+  static const uint16_t ROOT_SLOTS = 1 << ROOT_BITS;
+  static const uint16_t LEVEL_SLOTS = 1 << LEVEL_BITS;
+  static const uint32_t MAX_DELTA = (1UL << (ROOT_BITS + (LEVELS - 1) * LEVEL_BITS)) - 1;
+
+  struct Job {
+    TimerJobFn fn;
+    void* arg;
+    uint32_t expires;    // Geplanter Zeitpunkt (millis)
+    int8_t next;
+    int8_t prev;
+    int16_t* list;       // Fach, in dem der Auftrag liegt (NULL: nicht einsortiert)
+    uint8_t generation;  // Unterscheidet Handles wiederverwendeter Plätze
+    bool used;
+    TimerJobStats stats;
+  };
+
+  const char* name;
+  Job jobs[TIMER_WHEEL_JOBS];
+  int16_t root[ROOT_SLOTS];
+  int16_t levels[LEVELS - 1][LEVEL_SLOTS];
+  uint32_t now;            // Nächste noch nicht bearbeitete Millisekunde
+  uint32_t nextExpiry;     // Früheste Fälligkeit (gültig, wenn !nextDirty)
+  bool nextDirty;
+  bool started;
+
+  void link(int16_t* list, int idx) {
+    Job &job = jobs[idx];
+    job.list = list;
+    job.prev = -1;
+    job.next = *list;
+    if (*list >= 0) {
+      jobs[*list].prev = idx;
+    }
+    *list = idx;
+  }
+
+  void unlink(int idx) {
+    Job &job = jobs[idx];
+    if (job.list == NULL) {
+      return;
+    }
+    if (job.prev >= 0) {
+      jobs[job.prev].next = job.next;
+    } else {
+      *job.list = job.next;
+    }
+    if (job.next >= 0) {
+      jobs[job.next].prev = job.prev;
+    }
+    job.list = NULL;
+  }
+
+  /**
+   * Sortiert einen Auftrag nach seinem Abstand zu now in Ebene und Fach ein.
+   */
+  void insert(int idx) {
+    uint32_t expires = jobs[idx].expires;
+    int32_t delta = (int32_t)(expires - now);
+    if (delta < 0) {
+      expires = now;  // Überfällig: im nächsten Schritt ausführen
+      delta = 0;
+    } else if ((uint32_t)delta > MAX_DELTA) {
+      expires = now + MAX_DELTA;  // Beim Herabstufen erneut einsortieren
+      delta = MAX_DELTA;
+    }
+
+    if ((uint32_t)delta < ROOT_SLOTS) {
+      link(&root[expires & (ROOT_SLOTS - 1)], idx);
+      return;
+    }
+    for (uint8_t level = 0; level < LEVELS - 1; level++) {
+      uint8_t shift = ROOT_BITS + (level + 1) * LEVEL_BITS;
+      if (level == LEVELS - 2 || (uint32_t)delta < (1UL << shift)) {
+        uint8_t slot = (expires >> (ROOT_BITS + level * LEVEL_BITS)) & (LEVEL_SLOTS - 1);
+        link(&levels[level][slot], idx);
+        return;
+      }
+    }
+  }
+
+  /**
+   * Verteilt das aktuelle Fach einer Ebene auf die Ebenen darunter.
+   *
+   * @return Fachnummer (0: die Ebene darüber ist ebenfalls übergelaufen)
+   */
+  uint8_t cascade(uint8_t level) {
+    uint8_t slot = (now >> (ROOT_BITS + level * LEVEL_BITS)) & (LEVEL_SLOTS - 1);
+    int16_t idx = levels[level][slot];
+    levels[level][slot] = -1;
+    while (idx >= 0) {
+      int16_t next = jobs[idx].next;
+      jobs[idx].list = NULL;
+      insert(idx);
+      idx = next;
+    }
+    return slot;
+  }
+
+  void run(int idx, uint32_t time) {
+    Job &job = jobs[idx];
+    TimerJobStats &s = job.stats;
+    uint32_t jitter = time - job.expires;
+    uint8_t generation = job.generation;
+
+    s.runs++;
+    s.lastJitterMs = jitter;
+    s.jitterSumMs += jitter;
+    if (jitter > s.maxJitterMs) {
+      s.maxJitterMs = jitter;
+    }
+
+    // Einmalige Aufträge vorher freigeben, damit der Auftrag sich neu anlegen kann
+    if (s.periodMs == 0) {
+      job.used = false;
+    }
+
+    uint32_t t0 = micros();
+    job.fn(job.arg);
+    uint32_t runUs = micros() - t0;
+    if (runUs > s.maxRunUs) {
+      s.maxRunUs = runUs;
+    }
+
+    // Periodisch: ohne Drift auf den nächsten Zeitpunkt, außer der Auftrag wurde
+    // inzwischen abgebrochen oder mit restart() neu geplant
+    if (job.used && job.generation == generation && s.periodMs > 0 && job.list == NULL) {
+      uint32_t current = millis();
+      job.expires += s.periodMs;
+      if ((int32_t)(job.expires - current) <= 0) {
+        s.overruns += (current - job.expires) / s.periodMs + 1;
+        job.expires = current + s.periodMs;
+      }
+      insert(idx);
+    }
+  }
+
+  /**
+   * Bearbeitet eine Millisekunde: ggf. höhere Ebenen herabstufen, dann das Fach ausführen.
+   */
+  void step() {
+    uint16_t index = now & (ROOT_SLOTS - 1);
+    if (index == 0) {
+      for (uint8_t level = 0; level < LEVELS - 1 && cascade(level) == 0; level++) {
+      }
+    }
+    uint32_t time = now++;
+
+    // Fach vorher abhängen: neu einsortierte Aufträge landen nicht in dieser Runde.
+    // Laufende Aufträge dürfen andere abbrechen oder neu planen, daher zuerst merken.
+    int16_t idx = root[index];
+    if (idx < 0) {
+      return;
+    }
+    root[index] = -1;
+    int8_t due[TIMER_WHEEL_JOBS];
+    uint8_t generations[TIMER_WHEEL_JOBS];
+    uint8_t count = 0;
+    for (; idx >= 0; idx = jobs[idx].next) {
+      jobs[idx].list = NULL;
+      due[count] = idx;
+      generations[count++] = jobs[idx].generation;
+    }
+    nextDirty = true;
+
+    for (uint8_t i = 0; i < count; i++) {
+      Job &job = jobs[due[i]];
+      if (job.used && job.generation == generations[i] && job.list == NULL) {
+        uint32_t current = millis();
+        run(due[i], (int32_t)(current - time) > 0 ? current : time);
+      }
+    }
+  }
+
+  int handleOf(int idx) {
+    return (jobs[idx].generation << 8) | idx;
+  }
+
+  int indexOf(int handle) {
+    if (handle < 0) {
+      return -1;
+    }
+    int idx = handle & 0xFF;
+    if (idx >= TIMER_WHEEL_JOBS || !jobs[idx].used || jobs[idx].generation != (uint8_t)(handle >> 8)) {
+      return -1;
+    }
+    return idx;
+  }
+
+  int add(const char* jobName, uint32_t delayMs, uint32_t periodMs, TimerJobFn fn, void* arg) {
+    for (int idx = 0; idx < TIMER_WHEEL_JOBS; idx++) {
+      Job &job = jobs[idx];
+      if (job.used) {
+        continue;
+      }
+      if (!started) {
+        begin();
+      }
+      job.used = true;
+      job.generation++;
+      job.fn = fn;
+      job.arg = arg;
+      job.expires = millis() + delayMs;
+      memset(&job.stats, 0, sizeof(job.stats));
+      job.stats.name = jobName;
+      job.stats.periodMs = periodMs;
+      insert(idx);
+      if (!nextDirty && (int32_t)(job.expires - nextExpiry) < 0) {
+        nextExpiry = job.expires;
+      }
+      return handleOf(idx);
+    }
+    return -1;
+  }
+
+public:
+  TimerWheel(const char* wheelName) : name(wheelName), now(0), nextExpiry(0), nextDirty(true), started(false) {
+    memset(jobs, 0, sizeof(jobs));
+    for (int i = 0; i < TIMER_WHEEL_JOBS; i++) {
+      jobs[i].next = -1;
+      jobs[i].prev = -1;
+    }
+    memset(root, 0xFF, sizeof(root));
+    memset(levels, 0xFF, sizeof(levels));
+  }
+
+  /**
+   * Setzt den Startzeitpunkt des Rads (geschieht sonst beim ersten Auftrag).
+   */
+  void begin() {
+    now = millis();
+    started = true;
+  }
+
+  /**
+   * Legt einen periodischen Auftrag an.
+   *
+   * @param jobName Name für die Statistik (Literal)
+   * @param periodMs Periode in ms (mindestens 1)
+   * @param fn Auszuführende Funktion
+   * @param arg Argument für fn
+   * @param firstDelayMs Verzögerung bis zur ersten Ausführung (Standard: eine Periode)
+   * @return Handle für cancel()/restart(), -1 wenn kein Platz frei ist
+   */
+  int every(const char* jobName, uint32_t periodMs, TimerJobFn fn, void* arg = NULL,
+            uint32_t firstDelayMs = TIMER_WHEEL_NO_DEADLINE) {
+    if (periodMs == 0) {
+      periodMs = 1;
+    }
+    return add(jobName, firstDelayMs == TIMER_WHEEL_NO_DEADLINE ? periodMs : firstDelayMs, periodMs, fn, arg);
+  }
+
+  /**
+   * Legt einen einmaligen Auftrag an. Sein Handle wird nach der Ausführung ungültig.
+   *
+   * @return Handle für cancel()/restart(), -1 wenn kein Platz frei ist
+   */
+  int after(const char* jobName, uint32_t delayMs, TimerJobFn fn, void* arg = NULL) {
+    return add(jobName, delayMs, 0, fn, arg);
+  }
+
+  /**
+   * Plant einen Auftrag neu (z.B. sofortige Ausführung mit delayMs = 0).
+   *
+   * @param periodMs Neue Periode, 0 behält die bisherige (bei einmaligen Aufträgen ohne Wirkung)
+   * @return false, wenn das Handle nicht mehr gültig ist
+   */
+  bool restart(int handle, uint32_t delayMs, uint32_t periodMs = 0) {
+    int idx = indexOf(handle);
+    if (idx < 0) {
+      return false;
+    }
+    Job &job = jobs[idx];
+    if (periodMs > 0 && job.stats.periodMs > 0) {
+      job.stats.periodMs = periodMs;
+    }
+    unlink(idx);
+    job.expires = millis() + delayMs;
+    insert(idx);
+    nextDirty = true;
+    return true;
+  }
+
+  /**
+   * Bricht einen Auftrag ab. Ungültige Handles (-1, bereits ausgeführt) werden ignoriert.
+   */
+  void cancel(int handle) {
+    int idx = indexOf(handle);
+    if (idx < 0) {
+      return;
+    }
+    unlink(idx);
+    jobs[idx].used = false;
+    nextDirty = true;
+  }
+
+  /**
+   * Führt alle fälligen Aufträge aus.
+   *
+   * @return ms bis zur nächsten Fälligkeit (0: sofort wieder aufrufen),
+   *         TIMER_WHEEL_NO_DEADLINE ohne Aufträge
+   */
+  uint32_t poll() {
+    if (!started) {
+      return TIMER_WHEEL_NO_DEADLINE;
+    }
+    uint32_t target = millis();
+    while ((int32_t)(target - now) >= 0) {
+      step();
+    }
+    return nextDeadline();
+  }
+
+  /**
+   * Zeit bis zur nächsten Fälligkeit in ms, ohne Aufträge auszuführen.
+   */
+  uint32_t nextDeadline() {
+    if (nextDirty) {
+      bool found = false;
+      for (int idx = 0; idx < TIMER_WHEEL_JOBS; idx++) {
+        if (jobs[idx].used && jobs[idx].list != NULL &&
+            (!found || (int32_t)(jobs[idx].expires - nextExpiry) < 0)) {
+          nextExpiry = jobs[idx].expires;
+          found = true;
+        }
+      }
+      if (!found) {
+        return TIMER_WHEEL_NO_DEADLINE;
+      }
+      nextDirty = false;
+    }
+    int32_t remaining = (int32_t)(nextExpiry - millis());
+    return remaining > 0 ? remaining : 0;
+  }
+
+  const char* getName() {
+    return name;
+  }
+
+  /**
+   * Gibt die Messwerte eines Platzes zurück (NULL, wenn er frei ist).
+   *
+   * @param index 0 bis TIMER_WHEEL_JOBS - 1
+   */
+  const TimerJobStats* getStats(int index) {
+    return jobs[index].used ? &jobs[index].stats : NULL;
+  }
+};
+
+#endif // TIMER_WHEEL_H